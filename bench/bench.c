@@ -5,26 +5,86 @@
 #include <math.h>
 #include <time.h>
 
+#include <unistd.h>
+#include <getopt.h>
+
 #include "blm.h"
-#include "lfg.h"
+#include "perf.h"
 #include "pm.h"
+#include "run.h"
+#include "sweep.h"
 #include "tsfunc.h"
 
+#include "../pgui/gp/column.h"
+#include "../pgui/gp/lz4.h"
+
 #define TLM_FILE	"/tmp/pm-TLM"
 #define PWM_FILE	"/tmp/pm-PWM"
 #define AGP_FILE	"/tmp/pm-auto.gp"
 
 #define TLM_SIZE	100
+#define TLM_CHUNK	4096
+#define TLM_RING_MAX	20000
+#define TLM_PATH_MAX	200
+
+#define SOLVER_CYCLES	20000
 
 blm_t			m;
 pmc_t			pm;
 
+enum {
+	TLM_MODE_GRAB		= 0,
+	TLM_MODE_WATCH,
+	TLM_MODE_LIVE,
+	TLM_MODE_TRIGGER
+};
+
+enum {
+	TLM_TRIGGER_ERRNO	= 0,
+	TLM_TRIGGER_FSM,
+	TLM_TRIGGER_LU_MODE,
+	TLM_TRIGGER_SPEED
+};
+
 typedef struct {
 
 	int		hatch;
+	int		disabled;
+	int		lz4;
+
+	int		mode;
+	int		rate;
+	int		skip;
+
+	int		trigger;
+	double		trigger_speed;
+	int		trigger_last;
+	int		trigger_N;
+
+	int		pre_N;
+	int		post_N;
+	int		post;
 
 	float		y[TLM_SIZE];
 
+	int		column_N;
+	int		row_N;
+	int		head;
+
+	char		label[TLM_SIZE][COLUMN_LABEL_MAX];
+	float		chunk[TLM_SIZE][TLM_CHUNK];
+
+	char		pack[TLM_SIZE * (LZ4_COMPRESSBOUND(TLM_CHUNK * 4) + 12)];
+
+	int		ring_N;
+	int		ring_wp;
+
+	float		ring[TLM_RING_MAX][TLM_SIZE];
+
+	char		file_tlm[TLM_PATH_MAX];
+	char		file_pwm[TLM_PATH_MAX];
+	char		file_gp[TLM_PATH_MAX];
+
 	FILE		*fd_tlm;
 	FILE		*fd_pwm;
 	FILE		*fd_gp;
@@ -33,6 +93,120 @@ tlm_t;
 
 static tlm_t		tlm;
 
+static const char	*tlm_label_fixed[] = {
+
+	"time@s",
+	"m.iD@A",
+	"m.iQ@A",
+	"m.wS_rpm@rpm",
+	"m.theta@°",
+	"m.Tc@C",
+	"m.Udc@V",
+	"m.pwm_A@%",
+	"m.pwm_B@%",
+	"m.pwm_C@%",
+	"pm.vsi_X@V",
+	"pm.vsi_Y@V",
+	"pm.lu_iD@A",
+	"pm.lu_iQ@A",
+	"m.theta - pm.lu_Fg@°",
+	"pm.lu_Fg@°",
+	"pm.lu_wS_rpm@rpm",
+	"m.drain_wP@W",
+	"pm.watt_drain_wP@W",
+	"pm.const_fb_U@V",
+	"m.iA@A",
+	"m.iB@A",
+	"m.iC@A",
+	NULL
+};
+
+static void
+tlm_column_head()
+{
+	column_head_t		head;
+	int			N;
+
+	memset(&head, 0, sizeof(head));
+	memcpy(head.magic, COLUMN_MAGIC, sizeof(head.magic));
+
+	head.version = COLUMN_VERSION;
+	head.column_N = tlm.column_N;
+	head.chunk_N = TLM_CHUNK;
+	head.flags = 0;
+
+	fwrite(&head, sizeof(head), 1, tlm.fd_tlm);
+
+	for (N = 0; N < tlm.column_N; ++N) {
+
+		fwrite(tlm.label[N], COLUMN_LABEL_MAX, 1, tlm.fd_tlm);
+	}
+
+	tlm.head = 1;
+}
+
+static void
+tlm_column_flush()
+{
+	column_chunk_t		chunk;
+	column_block_t		*block;
+
+	char			*pack = tlm.pack;
+	int			N, length, bSIZE;
+
+	if (tlm.row_N == 0)
+		return ;
+
+	if (tlm.head == 0) {
+
+		tlm_column_head();
+	}
+
+	bSIZE = tlm.row_N * sizeof(float);
+
+	for (N = 0; N < tlm.column_N; ++N) {
+
+		block = (column_block_t *) pack;
+		pack += sizeof(column_block_t);
+
+		length = 0;
+
+		if (tlm.lz4 != 0) {
+
+			length = LZ4_compress_fast((const char *) tlm.chunk[N], pack,
+					bSIZE, LZ4_COMPRESSBOUND(TLM_CHUNK * 4), 1);
+		}
+
+		/* Store block as is if compression does not give any gain.
+		 * */
+		if (length > 0 && length < bSIZE) {
+
+			block->type = COLUMN_BLOCK_LZ4;
+		}
+		else {
+			block->type = COLUMN_BLOCK_RAW;
+			length = bSIZE;
+
+			memcpy(pack, tlm.chunk[N], bSIZE);
+		}
+
+		block->length = length;
+
+		memset(pack + length, 0, COLUMN_ALIGN(length) - length);
+		pack += COLUMN_ALIGN(length);
+	}
+
+	chunk.magic = COLUMN_CHUNK_MAGIC;
+	chunk.row_N = tlm.row_N;
+	chunk.length = (uint32_t) (pack - tlm.pack);
+	chunk.reserved = 0;
+
+	fwrite(&chunk, sizeof(chunk), 1, tlm.fd_tlm);
+	fwrite(tlm.pack, chunk.length, 1, tlm.fd_tlm);
+
+	tlm.row_N = 0;
+}
+
 static void
 tlm_page_GP(int nGP, const char *figure, const char *label)
 {
@@ -41,6 +215,18 @@ tlm_page_GP(int nGP, const char *figure, const char *label)
 	fprintf(tlm.fd_gp, "figure 0 %i \"%s\"\n\n", nGP, figure);
 }
 
+static void
+tlm_label_GP(int nGP, const char *name, const char *unit)
+{
+	if (unit != NULL) {
+
+		snprintf(tlm.label[nGP], COLUMN_LABEL_MAX, "%s@%s", name, unit);
+	}
+	else {
+		snprintf(tlm.label[nGP], COLUMN_LABEL_MAX, "%s", name);
+	}
+}
+
 static void
 tlm_plot_grab()
 {
@@ -51,7 +237,8 @@ tlm_plot_grab()
 	int		nGP;
 
 #define sym_GP(x, s, l)		{ tlm.y[nGP] = (float) (x); if (tlm.fd_gp != NULL) \
-				{ tlm_page_GP(nGP, s, (const char *) l); } nGP++; }
+				{ tlm_page_GP(nGP, s, (const char *) l); \
+				  tlm_label_GP(nGP, s, (const char *) l); } nGP++; }
 #define fmt_GP(x, l)		sym_GP(x, #x, l)
 #define fmk_GP(x, k, l)		sym_GP((x) * (k), #x, l)
 
@@ -87,13 +274,6 @@ tlm_plot_grab()
 	B = D * pm.lu_F[1] - Q * pm.lu_F[0];
 	rel = atan2(B, A);
 
-	if (m.unsync_flag != 0 && fabs(rel) > 1.2) {
-
-		/* Throw an ERROR if position estimate deviation is too large.
-		 * */
-		pm.fsm_errno = PM_ERROR_NO_SYNC_FAULT;
-	}
-
 	tlm.y[14] = rel * kDEG;
 
 	/* Estimated Position.
@@ -212,9 +392,199 @@ tlm_plot_grab()
 	fmk_GP(pm.s_track, kRPM, "rpm");
 	fmt_GP(pm.s_integral, "A");
 
-	if (tlm.fd_gp != NULL) { fclose(tlm.fd_gp); tlm.fd_gp = NULL; }
+	if (tlm.fd_gp != NULL) {
+
+		tlm.column_N = nGP;
+
+		fclose(tlm.fd_gp);
+		tlm.fd_gp = NULL;
+	}
+}
+
+static void
+tlm_column_put(const float *y)
+{
+	int		N;
+
+	for (N = 0; N < tlm.column_N; ++N) {
 
-	fwrite(tlm.y, sizeof(float), TLM_SIZE, tlm.fd_tlm);
+		tlm.chunk[N][tlm.row_N] = y[N];
+	}
+
+	tlm.row_N++;
+
+	if (tlm.row_N >= TLM_CHUNK) {
+
+		tlm_column_flush();
+	}
+}
+
+static void
+tlm_ring_put(const float *y)
+{
+	memcpy(tlm.ring[tlm.ring_wp], y, tlm.column_N * sizeof(float));
+
+	tlm.ring_wp = (tlm.ring_wp < tlm.pre_N - 1) ? tlm.ring_wp + 1 : 0;
+	tlm.ring_N = (tlm.ring_N < tlm.pre_N) ? tlm.ring_N + 1 : tlm.pre_N;
+}
+
+static void
+tlm_ring_flush()
+{
+	int		N, rp;
+
+	/* Write out the ring content from the oldest line.
+	 * */
+	rp = tlm.ring_wp - tlm.ring_N;
+	rp = (rp < 0) ? rp + tlm.pre_N : rp;
+
+	for (N = 0; N < tlm.ring_N; ++N) {
+
+		tlm_column_put(tlm.ring[rp]);
+
+		rp = (rp < tlm.pre_N - 1) ? rp + 1 : 0;
+	}
+
+	tlm.ring_N = 0;
+	tlm.ring_wp = 0;
+}
+
+static const int	tlm_live_column[] = { 0, 1, 2, 3, 6, 12, 13, 16, -1 };
+
+static void
+tlm_live_print(int head)
+{
+	int		N;
+
+	for (N = 0; tlm_live_column[N] >= 0; ++N) {
+
+		if (head != 0) {
+
+			printf("%s;", tlm.label[tlm_live_column[N]]);
+		}
+		else {
+			printf("%.4E;", tlm.y[tlm_live_column[N]]);
+		}
+	}
+
+	puts("");
+}
+
+static int
+tlm_trigger_fired()
+{
+	const double	kRPM = 30. / M_PI / m.Zp;
+
+	int		last, fired = 0;
+
+	switch (tlm.trigger) {
+
+		case TLM_TRIGGER_ERRNO:
+			last = (pm.fsm_errno != PM_OK) ? 1 : 0;
+			fired = (last != 0 && tlm.trigger_last == 0) ? 1 : 0;
+			break;
+
+		case TLM_TRIGGER_FSM:
+			last = pm.fsm_state;
+			fired = (last != tlm.trigger_last) ? 1 : 0;
+			break;
+
+		case TLM_TRIGGER_LU_MODE:
+			last = pm.lu_MODE;
+			fired = (last != tlm.trigger_last) ? 1 : 0;
+			break;
+
+		case TLM_TRIGGER_SPEED:
+			last = (fabs(pm.lu_wS * kRPM) > tlm.trigger_speed) ? 1 : 0;
+			fired = (last != tlm.trigger_last) ? 1 : 0;
+			break;
+
+		default:
+			last = 0;
+			break;
+	}
+
+	tlm.trigger_last = last;
+
+	return fired;
+}
+
+static void
+tlm_sync_check()
+{
+	double		A, B, D, Q;
+
+	D = cos(m.state[3]);
+	Q = sin(m.state[3]);
+	A = D * pm.lu_F[0] + Q * pm.lu_F[1];
+	B = D * pm.lu_F[1] - Q * pm.lu_F[0];
+
+	if (m.unsync_flag != 0 && fabs(atan2(B, A)) > 1.2) {
+
+		/* Throw an ERROR if position estimate deviation is too large.
+		 * */
+		pm.fsm_errno = PM_ERROR_NO_SYNC_FAULT;
+	}
+}
+
+static void
+tlm_capture()
+{
+	int		fired, sample;
+
+	/* We check the trigger condition on each PWM cycle but take a line
+	 * only on sample cycles.
+	 * */
+	fired = (tlm.mode == TLM_MODE_TRIGGER) ? tlm_trigger_fired() : 0;
+	sample = (tlm.skip == 0 || fired != 0) ? 1 : 0;
+
+	tlm.skip = (tlm.skip < tlm.rate - 1) ? tlm.skip + 1 : 0;
+
+	if (sample == 0)
+		return ;
+
+	tlm_plot_grab();
+
+	switch (tlm.mode) {
+
+		case TLM_MODE_LIVE:
+			tlm_live_print(0);
+			break;
+
+		case TLM_MODE_GRAB:
+			tlm_column_put(tlm.y);
+			break;
+
+		case TLM_MODE_WATCH:
+			tlm_ring_put(tlm.y);
+			break;
+
+		case TLM_MODE_TRIGGER:
+
+			if (tlm.post > 0) {
+
+				tlm_column_put(tlm.y);
+				tlm.post--;
+			}
+			else {
+				tlm_ring_put(tlm.y);
+
+				if (fired != 0) {
+
+					printf("tlm_trigger %i at %.4f (s)\n",
+							tlm.trigger_N, m.time);
+
+					tlm_ring_flush();
+
+					tlm.trigger_N += 1;
+					tlm.post = tlm.post_N;
+				}
+			}
+			break;
+
+		default:
+			break;
+	}
 }
 
 static void
@@ -269,7 +639,10 @@ tlm_PWM_grab()
 {
 	double		usual_dT;
 
-	tlm.fd_pwm = fopen(PWM_FILE, "wb");
+	if (tlm.disabled != 0)
+		return ;
+
+	tlm.fd_pwm = fopen(tlm.file_pwm, "wb");
 
 	if (tlm.fd_pwm == NULL) {
 
@@ -293,11 +666,31 @@ tlm_PWM_grab()
 	m.proc_step = NULL;
 }
 
+void tlm_setup(const char *tag)
+{
+	if (tag != NULL) {
+
+		snprintf(tlm.file_tlm, TLM_PATH_MAX, "%s.%s", TLM_FILE, tag);
+		snprintf(tlm.file_pwm, TLM_PATH_MAX, "%s.%s", PWM_FILE, tag);
+		snprintf(tlm.file_gp,  TLM_PATH_MAX, "%s.%s", AGP_FILE, tag);
+	}
+	else {
+		strcpy(tlm.file_tlm, TLM_FILE);
+		strcpy(tlm.file_pwm, PWM_FILE);
+		strcpy(tlm.file_gp,  AGP_FILE);
+	}
+}
+
 void tlm_restart()
 {
+	int		N;
+
+	if (tlm.disabled != 0)
+		return ;
+
 	if (tlm.fd_tlm == NULL) {
 
-		tlm.fd_tlm = fopen(TLM_FILE, "wb");
+		tlm.fd_tlm = fopen(tlm.file_tlm, "wb");
 
 		if (tlm.fd_tlm == NULL) {
 
@@ -305,17 +698,66 @@ void tlm_restart()
 			exit(-1);
 		}
 
-		tlm.fd_gp = fopen(AGP_FILE, "w");
+		tlm.fd_gp = fopen(tlm.file_gp, "w");
 
 		if (tlm.fd_gp == NULL) {
 
 			fprintf(stderr, "fopen: %s", strerror(errno));
 			exit(-1);
 		}
+
+		for (N = 0; tlm_label_fixed[N] != NULL; ++N) {
+
+			strcpy(tlm.label[N], tlm_label_fixed[N]);
+		}
+
+		for (; N < TLM_SIZE; ++N) {
+
+			strcpy(tlm.label[N], "unused");
+		}
 	}
 	else {
 		tlm.fd_tlm = freopen(NULL, "wb", tlm.fd_tlm);
 	}
+
+	tlm.row_N = 0;
+	tlm.head = 0;
+
+	tlm.skip = 0;
+	tlm.post = 0;
+
+	tlm.ring_N = 0;
+	tlm.ring_wp = 0;
+
+	tlm.trigger_last = (tlm.trigger == TLM_TRIGGER_FSM) ? pm.fsm_state
+		: (tlm.trigger == TLM_TRIGGER_LU_MODE) ? pm.lu_MODE : 0;
+	tlm.trigger_N = 0;
+
+	if (tlm.mode == TLM_MODE_LIVE) {
+
+		tlm_live_print(1);
+	}
+}
+
+void tlm_disable()
+{
+	tlm.disabled = 1;
+}
+
+void tlm_close()
+{
+	if (tlm.fd_tlm != NULL) {
+
+		if (tlm.mode == TLM_MODE_WATCH) {
+
+			tlm_ring_flush();
+		}
+
+		tlm_column_flush();
+
+		fclose(tlm.fd_tlm);
+		tlm.fd_tlm = NULL;
+	}
 }
 
 void sim_runtime(double dT)
@@ -345,25 +787,36 @@ void sim_runtime(double dT)
 		fb.pulse_HS = m.pulse_HS;
 		fb.pulse_EP = m.pulse_EP;
 
+		/* Record feedback stream to replay.
+		 * */
+		perf_record(&fb);
+
 		/* PM update.
 		 * */
 		pm_feedback(&pm, &fb);
 
+		perf_record_end();
+
+		/* Check position estimate against the model.
+		 * */
+		tlm_sync_check();
+
 		if (tlm.fd_tlm != NULL) {
 
 			/* Collect telemetry.
 			 * */
-			tlm_plot_grab();
+			tlm_capture();
 		}
 
+		/* Collect sweep metrics.
+		 * */
+		sweep_capture();
+
 		if (pm.fsm_errno != PM_OK) {
 
 			fprintf(stderr, "fsm_errno: %s\n", pm_strerror(pm.fsm_errno));
 
-			if (tlm.fd_tlm != NULL) {
-
-				fclose(tlm.fd_tlm);
-			}
+			tlm_close();
 
 			exit(-1);
 		}
@@ -433,29 +886,434 @@ void bench_script()
 	tlm_PWM_grab();
 }
 
+#ifdef _PM_PROF
+static double		prof_clock;
+static uint64_t		prof_tsc;
+
+void prof_restart()
+{
+	pm_prof_reset(&pm.prof);
+
+	prof_clock = run_clock();
+	prof_tsc = __builtin_ia32_rdtsc();
+}
+
+void prof_report()
+{
+	const pm_prof_stat_t	*st;
+	double			tsc_hz, mean;
+	int			ID, n, n_min, n_max;
+
+	/* We estimate TSC rate over the whole run to convert cycles to ns.
+	 * */
+	tsc_hz = (double) (__builtin_ia32_rdtsc() - prof_tsc)
+		/ (run_clock() - prof_clock);
+
+	printf("prof: TSC %.1f MHz\n", tsc_hz * 1.E-6);
+	printf("prof: %-22s %10s %8s %8s %8s %8s\n", "stage", "N",
+			"min", "mean", "max", "ns");
+
+	for (ID = 0; ID < PM_PROF_MAX; ++ID) {
+
+		st = &pm.prof.st[ID];
+
+		if (st->N == 0)
+			continue;
+
+		mean = (double) st->sum / (double) st->N;
+
+		printf("prof: %-22s %10u %8u %8.1f %8u %8.1f\n",
+				pm_prof_name(ID), st->N, st->min, mean,
+				st->max, mean * 1.E+9 / tsc_hz);
+
+		n_min = PM_PROF_HIST;
+		n_max = 0;
+
+		for (n = 0; n < PM_PROF_HIST; ++n) {
+
+			if (st->hist[n] != 0) {
+
+				n_min = (n < n_min) ? n : n_min;
+				n_max = n;
+			}
+		}
+
+		printf("prof: %-22s", "");
+
+		for (n = n_min; n <= n_max; ++n) {
+
+			printf(" <%u:%.1f%%", 1U << n,
+					100. * st->hist[n] / st->N);
+		}
+
+		puts("");
+	}
+}
+#endif /* _PM_PROF */
+
+static void
+solver_update(blm_t *b)
+{
+	double		th;
+	int		A, B, C, half, range;
+
+	/* Open loop drive at constant frequency so that all the solvers
+	 * get exactly the same sequence of PWM.
+	 * */
+	th = b->time * 1400. + 1.6;
+
+	half = b->pwm_resolution / 2;
+	range = b->pwm_resolution / 10;
+
+	A = half + (int) (range * cos(th));
+	B = half + (int) (range * cos(th - 2. * M_PI / 3.));
+	C = half + (int) (range * cos(th + 2. * M_PI / 3.));
+
+	b->pwm_A = A;
+	b->pwm_B = B;
+	b->pwm_C = C;
+
+	blm_update(b);
+}
+
+static void
+solver_run(blm_t *b, int mode, double sol_dT, float *trace, double *tCPU)
+{
+	double		tBEGIN;
+	int		N;
+
+	b->rseed = 1;
+	b->sol_MODE = mode;
+
+	blm_enable(b);
+
+	b->sol_dT = sol_dT;
+
+	b->Rs = 14.E-3;
+	b->Ld = 10.E-6;
+	b->Lq = 15.E-6;
+	b->Udc = 22.;
+	b->Zp = 14;
+	b->lambda = blm_Kv_lambda(b, 270.);
+	b->Jm = 3.E-4;
+
+	blm_restart(b);
+
+	b->state[2] = 1400.;
+
+	tBEGIN = run_clock();
+
+	for (N = 0; N < SOLVER_CYCLES; ++N) {
+
+		solver_update(b);
+
+		trace[N * 3 + 0] = b->state[0];
+		trace[N * 3 + 1] = b->state[1];
+		trace[N * 3 + 2] = b->state[2];
+	}
+
+	*tCPU = run_clock() - tBEGIN;
+}
+
+static void
+solver_script()
+{
+	static blm_t	b;
+	static float	ref[SOLVER_CYCLES * 3];
+	static float	trace[SOLVER_CYCLES * 3];
+
+	const struct {
+
+		const char	*name;
+		int		mode;
+		double		sol_dT;
+	}
+	list[] = {
+
+		{ "heun  5us", BLM_SOL_HEUN, 5.E-6 },
+		{ "heun  1us", BLM_SOL_HEUN, 1.E-6 },
+		{ "rk23", BLM_SOL_RK23, 5.E-6 },
+
+		{ NULL }
+	};
+
+	double		tCPU, eD, eQ, eS, x;
+	int		i, N;
+
+	/* Cross-check of ODE solvers against fine Heun solution on the same
+	 * open loop drive of the machine.
+	 * */
+	solver_run(&b, BLM_SOL_HEUN, 20.E-9, ref, &tCPU);
+
+	printf("%-10s %10s %8s %8s %10s %10s %10s\n", "solver", "steps",
+			"rejects", "CPU (s)", "iD (A)", "iQ (A)", "wS (rad/s)");
+
+	printf("%-10s %10li %8li %8.3f %10s %10s %10s\n", "heun 20ns",
+			b.sol_N_step, b.sol_N_reject, tCPU, "-", "-", "-");
+
+	for (i = 0; list[i].name != NULL; ++i) {
+
+		solver_run(&b, list[i].mode, list[i].sol_dT, trace, &tCPU);
+
+		eD = 0.;
+		eQ = 0.;
+		eS = 0.;
+
+		for (N = 0; N < SOLVER_CYCLES; ++N) {
+
+			x = trace[N * 3 + 0] - ref[N * 3 + 0];
+			eD += x * x;
+
+			x = trace[N * 3 + 1] - ref[N * 3 + 1];
+			eQ += x * x;
+
+			x = fabs(trace[N * 3 + 2] - ref[N * 3 + 2]);
+			eS = (x > eS) ? x : eS;
+		}
+
+		eD = sqrt(eD / SOLVER_CYCLES);
+		eQ = sqrt(eQ / SOLVER_CYCLES);
+
+		printf("%-10s %10li %8li %8.3f %10.2E %10.2E %10.2E\n",
+				list[i].name, b.sol_N_step, b.sol_N_reject,
+				tCPU, eD, eQ, eS);
+	}
+}
+
+static int
+bench_options(int argc, char *argv[])
+{
+	int		opt;
+
+	run.rseed = (int) time(NULL);
+	run.sol_MODE = BLM_SOL_HEUN;
+
+	run.N_workers = (int) sysconf(_SC_NPROCESSORS_ONLN);
+	run.N_workers = (run.N_workers < 1) ? 1 : run.N_workers;
+
+	run.grab = 0;
+	run.script = NULL;
+	run.N_sample = 40;
+
+	tlm.mode = TLM_MODE_GRAB;
+	tlm.rate = 1;
+	tlm.trigger = TLM_TRIGGER_ERRNO;
+	tlm.pre_N = TLM_RING_MAX / 2;
+	tlm.post_N = TLM_RING_MAX / 2;
+
+	run_machine_builtin();
+
+	optind = 2;
+
+	while ((opt = getopt(argc, argv, "s:i:j:f:x:n:d:gzc:r:t:w:b:e:o:")) != -1) {
+
+		switch (opt) {
+
+			case 's':
+				run.rseed = strtol(optarg, NULL, 10);
+				break;
+
+			case 'i':
+				if (strcmp(optarg, "heun") == 0) {
+
+					run.sol_MODE = BLM_SOL_HEUN;
+				}
+				else if (strcmp(optarg, "rk23") == 0) {
+
+					run.sol_MODE = BLM_SOL_RK23;
+				}
+				else {
+					fprintf(stderr, "unknown solver \"%s\"\n", optarg);
+					return -1;
+				}
+				break;
+
+			case 'j':
+				run.N_workers = strtol(optarg, NULL, 10);
+				run.N_workers = (run.N_workers < 1) ? 1 : run.N_workers;
+				break;
+
+			case 'f':
+				if (run_machine_load(optarg) <= 0) {
+
+					fprintf(stderr, "no machines in %s\n", optarg);
+					return -1;
+				}
+				break;
+
+			case 'x':
+				run.script = optarg;
+				break;
+
+			case 'n':
+				run.N_sample = strtol(optarg, NULL, 10);
+				run.N_sample = (run.N_sample < 1) ? 1 : run.N_sample;
+				break;
+
+			case 'd':
+				ts_slow_DIV = strtol(optarg, NULL, 10);
+				ts_slow_DIV = (ts_slow_DIV < 1) ? 1
+					: (ts_slow_DIV > PM_SLOW_DIV_MAX) ? PM_SLOW_DIV_MAX : ts_slow_DIV;
+				break;
+
+			case 'g':
+				run.grab = 1;
+				break;
+
+			case 'z':
+				tlm.lz4 = 1;
+				break;
+
+			case 'c':
+				if (strcmp(optarg, "grab") == 0) {
+
+					tlm.mode = TLM_MODE_GRAB;
+				}
+				else if (strcmp(optarg, "watch") == 0) {
+
+					tlm.mode = TLM_MODE_WATCH;
+				}
+				else if (strcmp(optarg, "live") == 0) {
+
+					tlm.mode = TLM_MODE_LIVE;
+				}
+				else if (strcmp(optarg, "trigger") == 0) {
+
+					tlm.mode = TLM_MODE_TRIGGER;
+				}
+				else {
+					fprintf(stderr, "unknown capture mode \"%s\"\n", optarg);
+					return -1;
+				}
+				break;
+
+			case 'r':
+				tlm.rate = strtol(optarg, NULL, 10);
+				tlm.rate = (tlm.rate < 1) ? 1 : tlm.rate;
+				break;
+
+			case 't':
+				if (strcmp(optarg, "errno") == 0) {
+
+					tlm.trigger = TLM_TRIGGER_ERRNO;
+				}
+				else if (strcmp(optarg, "fsm") == 0) {
+
+					tlm.trigger = TLM_TRIGGER_FSM;
+				}
+				else if (strcmp(optarg, "mode") == 0) {
+
+					tlm.trigger = TLM_TRIGGER_LU_MODE;
+				}
+				else if (strncmp(optarg, "speed=", 6) == 0) {
+
+					tlm.trigger = TLM_TRIGGER_SPEED;
+					tlm.trigger_speed = strtod(optarg + 6, NULL);
+				}
+				else {
+					fprintf(stderr, "unknown trigger \"%s\"\n", optarg);
+					return -1;
+				}
+
+				tlm.mode = TLM_MODE_TRIGGER;
+				break;
+
+			case 'w':
+				if (sscanf(optarg, "%i,%i", &tlm.pre_N, &tlm.post_N) != 2) {
+
+					fprintf(stderr, "invalid window \"%s\"\n", optarg);
+					return -1;
+				}
+
+				tlm.pre_N = (tlm.pre_N < 1) ? 1
+					: (tlm.pre_N > TLM_RING_MAX) ? TLM_RING_MAX : tlm.pre_N;
+				tlm.post_N = (tlm.post_N < 0) ? 0 : tlm.post_N;
+				break;
+
+			case 'b':
+				perf_file_base = optarg;
+				break;
+
+			case 'e':
+				perf_tolerance = strtod(optarg, NULL);
+				break;
+
+			case 'o':
+				perf_dir_trace = optarg;
+				break;
+
+			default:
+				fprintf(stderr, "Usage: %s test|bench|run|sweep|solver|perf [-s rseed]"
+						" [-i heun|rk23] [-j workers] [-f machines]"
+						" [-x script,...] [-n samples] [-d slowdiv] [-g] [-z]"
+						" [-c grab|watch|live|trigger] [-r rate]"
+						" [-t errno|fsm|mode|speed=rpm] [-w pre,post]"
+						" [-b baseline] [-e tolerance] [-o tracedir]\n", argv[0]);
+				return -1;
+		}
+	}
+
+	return 0;
+}
+
 int main(int argc, char *argv[])
 {
+	int		rc = 0;
+
 	if (argc < 2) {
 
 		exit(-1);
 	}
 
-	lfg_start((int) time(NULL));
+	if (bench_options(argc, argv) != 0) {
+
+		exit(-1);
+	}
+
+	m.rseed = run.rseed;
+	m.sol_MODE = run.sol_MODE;
+
+	tlm_setup(NULL);
+
+#ifdef _PM_PROF
+	prof_restart();
+#endif /* _PM_PROF */
 
 	if (strcmp(argv[1], "test") == 0) {
 
+		fprintf(stderr, "rseed = %i\n", m.rseed);
+
 		ts_script_test();
 	}
 	else if (strcmp(argv[1], "bench") == 0) {
 
+		fprintf(stderr, "rseed = %i\n", m.rseed);
+
 		bench_script();
 	}
+	else if (strcmp(argv[1], "run") == 0) {
 
-	if (tlm.fd_tlm != NULL) {
+		rc = run_script();
+	}
+	else if (strcmp(argv[1], "solver") == 0) {
 
-		fclose(tlm.fd_tlm);
+		solver_script();
 	}
+	else if (strcmp(argv[1], "perf") == 0) {
 
-	return 0;
+		rc = perf_script();
+	}
+	else if (strcmp(argv[1], "sweep") == 0) {
+
+		rc = sweep_script();
+	}
+
+#ifdef _PM_PROF
+	prof_report();
+#endif /* _PM_PROF */
+
+	tlm_close();
+
+	return rc;
 }
 
@@ -2,7 +2,6 @@
 #include <math.h>
 
 #include "blm.h"
-#include "lfg.h"
 
 void blm_AB_DQ(double theta, double A, double B, double *D, double *Q)
 {
@@ -50,6 +49,13 @@ void blm_enable(blm_t *m)
 	m->time = 0.;		/* Simulation TIME (Second) */
 	m->sol_dT = 5.E-6;	/* ODE solver step (Second) */
 
+	/* Adaptive ODE solver (BLM_SOL_RK23) tolerance.
+	 * */
+	m->sol_tol = 1.E-4;
+
+	m->sol_N_step = 0;
+	m->sol_N_reject = 0;
+
 	m->pwm_dT = 35.E-6;		/* PWM cycle (Second)    */
 	m->pwm_deadtime = 90.E-9;	/* PWM deadtime (Second) */
 	m->pwm_minimal = 50.E-9;	/* PWM minimal (Second)  */
@@ -125,6 +131,10 @@ void blm_enable(blm_t *m)
 	m->range_A = 165.;	/* (Ampere) */
 	m->range_B = 60.;	/* (Volt)   */
 
+	/* ADC noise standard deviation (LSB).
+	 * */
+	m->adc_noise = 2.;
+
 	/* Hall Sensor installation angles (Degree).
 	 * */
 	m->hall[0] = 30.7;
@@ -140,6 +150,14 @@ void blm_enable(blm_t *m)
 	/* Resolver SIN/COS.
 	 * */
 	m->analog_Zq = 1.0;	/* Reduction ratio        */
+
+	/* Noise generator is seeded with the value of rseed that is
+	 * given from the outside so any run can be replayed exactly.
+	 * */
+	lfg_start(&m->lfg, m->rseed);
+	lfg_gauss_batch(&m->lfg, m->noise, BLM_NOISE_MAX);
+
+	m->noise_rp = 0;
 }
 
 void blm_restart(blm_t *m)
@@ -184,6 +202,29 @@ void blm_restart(blm_t *m)
 	m->event[7].ev = 8;
 
 	m->revol = 0;
+
+	m->sol_h = m->sol_dT;
+}
+
+static void
+blm_noise_fill(blm_t *m)
+{
+	/* Renew all of the noise consumed since the previous call.
+	 * */
+	lfg_gauss_batch(&m->lfg, m->noise, m->noise_rp);
+
+	m->noise_rp = 0;
+}
+
+static double
+blm_noise(blm_t *m)
+{
+	if (m->noise_rp >= BLM_NOISE_MAX) {
+
+		blm_noise_fill(m);
+	}
+
+	return m->noise[m->noise_rp++];
 }
 
 static void
@@ -254,6 +295,8 @@ blm_ode_step(blm_t *m, double dT)
 
 	blm_equation(m, m->state, y0);
 
+	m->sol_N_step += 1;
+
 	if (m->pwm_Z != BLM_Z_DETACHED) {
 
 		x0[0] = m->state[0] + y0[0] * dT;
@@ -328,6 +371,188 @@ blm_ode_step(blm_t *m, double dT)
 	}
 }
 
+static void
+blm_sensor_input(const blm_t *m, const double state[7], double u[7])
+{
+	double		uMIN;
+
+	blm_DQ_ABC(state[3], state[0], state[1], &u[0], &u[1], &u[2]);
+
+	u[3] = state[6];
+
+	if (m->pwm_Z != BLM_Z_DETACHED) {
+
+		u[4] = m->xfet[0] * state[6];
+		u[5] = m->xfet[1] * state[6];
+		u[6] = m->xfet[2] * state[6];
+	}
+	else {
+		blm_DQ_ABC(state[3], 0., m->lambda * state[2], &u[4], &u[5], &u[6]);
+
+		uMIN = (u[4] < u[5]) ? u[4] : u[5];
+		uMIN = (uMIN < u[6]) ? uMIN : u[6];
+
+		u[4] += - uMIN;
+		u[5] += - uMIN;
+		u[6] += - uMIN;
+	}
+}
+
+static void
+blm_sensor_step(blm_t *m, const double u0[7], const double u1[7], double dT)
+{
+	double		EA, KA, EB, KB, uS;
+
+	/* Sensor transient (LARGE STEP). We use exact response of the
+	 * first-order lag to a linear ramp input over the step.
+	 * */
+	EA = exp(- dT / m->tau_A);
+	KA = (1. - EA) * m->tau_A / dT;
+
+	EB = exp(- dT / m->tau_B);
+	KB = (1. - EB) * m->tau_B / dT;
+
+	m->state[7] = u1[0] + (m->state[7] - u0[0]) * EA - (u1[0] - u0[0]) * KA;
+	m->state[8] = u1[1] + (m->state[8] - u0[1]) * EA - (u1[1] - u0[1]) * KA;
+	m->state[9] = u1[2] + (m->state[9] - u0[2]) * EA - (u1[2] - u0[2]) * KA;
+
+	uS = m->state[10];
+
+	m->state[10] = u1[3] + (m->state[10] - u0[3]) * EA - (u1[3] - u0[3]) * KA;
+	m->state[11] = m->state[10] + (m->state[11] - uS) * EB - (m->state[10] - uS) * KB;
+	m->state[12] = u1[4] + (m->state[12] - u0[4]) * EB - (u1[4] - u0[4]) * KB;
+	m->state[13] = u1[5] + (m->state[13] - u0[5]) * EB - (u1[5] - u0[5]) * KB;
+	m->state[14] = u1[6] + (m->state[14] - u0[6]) * EB - (u1[6] - u0[6]) * KB;
+}
+
+static void
+blm_ode_adaptive(blm_t *m, double dT)
+{
+	/* Typical magnitude of each state variable to get the absolute
+	 * tolerance from (A, A, rad/s, rad, C, J, V).
+	 * */
+	const double	unit[7] = { 1., 1., 10., 1.E-2, 1., 1.E-3, 1. };
+
+	double		k1[7], k2[7], k3[7], k4[7], x1[7], u0[7], u1[7];
+	double		h, e, ex, scale, rel;
+	int		i, detached;
+
+	/* Embedded RK23 (Bogacki-Shampine) solver with error control. Each
+	 * call integrates over the interval between the switching events
+	 * so that the events themselves are located exactly.
+	 * */
+
+	detached = (m->pwm_Z != BLM_Z_DETACHED) ? 0 : 1;
+
+	blm_equation(m, m->state, k1);
+	blm_sensor_input(m, m->state, u0);
+
+	if (detached != 0) {
+
+		k1[0] = 0.;
+		k1[1] = 0.;
+	}
+
+	while (dT > 0.) {
+
+		h = m->sol_h;
+
+		if (h >= dT) {
+
+			h = dT;
+		}
+		else if (h > dT * 0.5) {
+
+			/* Avoid the tiny remainder step.
+			 * */
+			h = dT * 0.5;
+		}
+
+		for (i = 0; i < 7; ++i) {
+
+			x1[i] = m->state[i] + k1[i] * h * (1. / 2.);
+		}
+
+		blm_equation(m, x1, k2);
+
+		for (i = 0; i < 7; ++i) {
+
+			x1[i] = m->state[i] + k2[i] * h * (3. / 4.);
+		}
+
+		blm_equation(m, x1, k3);
+
+		for (i = 0; i < 7; ++i) {
+
+			x1[i] = m->state[i] + h * (k1[i] * (2. / 9.)
+					+ k2[i] * (1. / 3.) + k3[i] * (4. / 9.));
+		}
+
+		if (detached != 0) {
+
+			x1[0] = 0.;
+			x1[1] = 0.;
+		}
+
+		blm_equation(m, x1, k4);
+
+		if (detached != 0) {
+
+			k4[0] = 0.;
+			k4[1] = 0.;
+		}
+
+		ex = 0.;
+
+		for (i = 0; i < 7; ++i) {
+
+			e = h * (k1[i] * (- 5. / 72.) + k2[i] * (1. / 12.)
+					+ k3[i] * (1. / 9.) + k4[i] * (- 1. / 8.));
+
+			scale = m->sol_tol * (unit[i] + fabs(x1[i]));
+			rel = fabs(e) / scale;
+
+			ex = (rel > ex) ? rel : ex;
+		}
+
+		/* Next step size from the error estimate.
+		 * */
+		scale = (ex > 1.E-9) ? 0.9 * pow(ex, - 1. / 3.) : 5.;
+		scale = (scale < 0.2) ? 0.2 : (scale > 5.) ? 5. : scale;
+
+		if (ex > 1. && h > 1.E-9) {
+
+			m->sol_h = h * scale;
+			m->sol_N_reject += 1;
+
+			continue;
+		}
+
+		if (h < dT || h * scale > m->sol_h) {
+
+			/* Do not let the short interval shrink the step.
+			 * */
+			m->sol_h = h * scale;
+		}
+
+		m->sol_h = (m->sol_h > m->pwm_dT) ? m->pwm_dT : m->sol_h;
+
+		blm_sensor_input(m, x1, u1);
+		blm_sensor_step(m, u0, u1, h);
+
+		for (i = 0; i < 7; ++i) {
+
+			m->state[i] = x1[i];
+			k1[i] = k4[i];
+			u0[i] = u1[i];
+		}
+
+		m->sol_N_step += 1;
+
+		dT -= h;
+	}
+}
+
 static void
 blm_solve(blm_t *m, double dT)
 {
@@ -360,35 +585,42 @@ blm_solve(blm_t *m, double dT)
 
 		/* ADC surge on A.
 		 * */
-		m->state[7]  += lfg_gauss() * 5.;
-		m->state[10] += lfg_gauss() * 2.;
+		m->state[7]  += blm_noise(m) * 5.;
+		m->state[10] += blm_noise(m) * 2.;
 	}
 
 	if (m->xfet[1] != m->xfet[4]) {
 
 		/* ADC surge on B.
 		 * */
-		m->state[8]  += lfg_gauss() * 5.;
-		m->state[10] += lfg_gauss() * 2.;
+		m->state[8]  += blm_noise(m) * 5.;
+		m->state[10] += blm_noise(m) * 2.;
 	}
 
 	if (m->xfet[2] != m->xfet[5]) {
 
 		/* ADC surge on C.
 		 * */
-		m->state[9]  += lfg_gauss() * 5.;
-		m->state[10] += lfg_gauss() * 2.;
+		m->state[9]  += blm_noise(m) * 5.;
+		m->state[10] += blm_noise(m) * 2.;
 	}
 
-	/* Divide the long interval.
-	 * */
-	while (dT > m->sol_dT) {
+	if (		m->sol_MODE == BLM_SOL_RK23
+			&& m->proc_step == NULL) {
 
-		blm_ode_step(m, m->sol_dT);
-		dT -= m->sol_dT;
+		blm_ode_adaptive(m, dT);
 	}
+	else {
+		/* Divide the long interval.
+		 * */
+		while (dT > m->sol_dT) {
 
-	blm_ode_step(m, dT);
+			blm_ode_step(m, m->sol_dT);
+			dT -= m->sol_dT;
+		}
+
+		blm_ode_step(m, dT);
+	}
 
 	if (m->state[3] < - M_PI) {
 
@@ -409,14 +641,14 @@ blm_solve(blm_t *m, double dT)
 }
 
 static double
-blm_ADC(double vconv, double vmin, double vmax)
+blm_ADC(blm_t *m, double vconv, double vmin, double vmax)
 {
 	double		rel;
 	int		ADC;
 
 	rel = (vconv - vmin) / (vmax - vmin);
 
-	ADC = (int) (rel * 4096. + lfg_gauss() * 2.);
+	ADC = (int) (rel * 4096. + blm_noise(m) * m->adc_noise);
 	ADC = ADC < 0 ? 0 : ADC > 4095 ? 4095 : ADC;
 
 	return (double) ADC / 4096. * (vmax - vmin) + vmin;
@@ -474,8 +706,8 @@ blm_sample_analog(blm_t *m)
 	location = m->state[3] + (2. * M_PI) * (double) m->revol;
 	angle = location * m->analog_Zq / m->Zp;
 
-	m->analog_SIN = (float) blm_ADC(sin(angle), - 3., 3.);
-	m->analog_COS = (float) blm_ADC(cos(angle), - 3., 3.);
+	m->analog_SIN = (float) blm_ADC(m, sin(angle), - 3., 3.);
+	m->analog_COS = (float) blm_ADC(m, cos(angle), - 3., 3.);
 }
 
 static void
@@ -511,19 +743,19 @@ blm_pwm_up_event(blm_t *m, int ev)
 	switch (ev) {
 
 		case 0:
-			m->analog_iA = (float) blm_ADC(m->state[7], - m->range_A, m->range_A);
-			m->analog_iB = (float) blm_ADC(m->state[8], - m->range_A, m->range_A);
-			m->analog_iC = (float) blm_ADC(m->state[9], - m->range_A, m->range_A);
+			m->analog_iA = (float) blm_ADC(m, m->state[7], - m->range_A, m->range_A);
+			m->analog_iB = (float) blm_ADC(m, m->state[8], - m->range_A, m->range_A);
+			m->analog_iC = (float) blm_ADC(m, m->state[9], - m->range_A, m->range_A);
 			break;
 
 		case 1:
-			m->analog_uS = (float) blm_ADC(m->state[11], 0., m->range_B);
-			m->analog_uA = (float) blm_ADC(m->state[12], 0., m->range_B);
-			m->analog_uB = (float) blm_ADC(m->state[13], 0., m->range_B);
+			m->analog_uS = (float) blm_ADC(m, m->state[11], 0., m->range_B);
+			m->analog_uA = (float) blm_ADC(m, m->state[12], 0., m->range_B);
+			m->analog_uB = (float) blm_ADC(m, m->state[13], 0., m->range_B);
 			break;
 
 		case 2:
-			m->analog_uC = (float) blm_ADC(m->state[14], 0., m->range_B);
+			m->analog_uC = (float) blm_ADC(m, m->state[14], 0., m->range_B);
 
 			blm_sample_analog(m);
 			blm_sample_hall(m);
@@ -617,6 +849,10 @@ blm_pwm_solve(blm_t *m)
 		rev[level] = i;
 	}
 
+	/* Get the noise for this PWM cycle in one pass.
+	 * */
+	blm_noise_fill(m);
+
 	dTu = m->pwm_dT / (double) (m->pwm_resolution * 2);
 
 	xMIN = (int) (m->pwm_minimal * (double) m->pwm_resolution / m->pwm_dT);
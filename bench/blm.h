@@ -1,16 +1,38 @@
 #ifndef _H_BLM_
 #define _H_BLM_
 
+#include "lfg.h"
+
+#define BLM_NOISE_MAX		64
+
 enum {
 	BLM_Z_NONE		= 0,
 	BLM_Z_DETACHED
 };
 
+/* Heun at fixed 5 us step is the default and is good enough for long runs
+ * and sweeps. Adaptive RK23 takes about 1.6 times the CPU of it but gives
+ * the currents a few orders more accurate (see bench solver). Use it when
+ * the result depends on the fine current waveform such as estimator error
+ * on machines of low inductance.
+ * */
+enum {
+	BLM_SOL_HEUN		= 0,
+	BLM_SOL_RK23
+};
+
 typedef struct {
 
 	double		time;
 	double		sol_dT;
 
+	int		sol_MODE;
+	double		sol_tol;
+	double		sol_h;
+
+	long		sol_N_step;
+	long		sol_N_reject;
+
 	int		unsync_flag;
 
 	double		pwm_dT;
@@ -62,6 +84,8 @@ typedef struct {
 	double		range_A;
 	double		range_B;
 
+	double		adc_noise;
+
 	double		hall[3];
 
 	int		eabi_ERES;
@@ -84,6 +108,12 @@ typedef struct {
 	float		analog_SIN;
 	float		analog_COS;
 
+	int		rseed;
+	lfg_t		lfg;
+
+	double		noise[BLM_NOISE_MAX];
+	int		noise_rp;
+
 	void 		(* proc_step) (double);
 }
 blm_t;
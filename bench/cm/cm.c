@@ -0,0 +1,321 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../trace.h"
+
+#include _HW_INCLUDE
+
+/* Fraction of PWM period that we allow pm_feedback to take. The rest is
+ * left for HAL, ADC and application tasks.
+ * */
+#define CM_IRQ_LOAD		0.7f
+
+#define CM_FRAME_CHUNK		1000
+#define CM_MODE_MAX		(PM_LU_SENSOR_SINCOS + 1)
+
+#define CM_REG(addr)		(* (volatile uint32_t *) (addr))
+
+#define CM_CPACR		CM_REG(0xE000ED88U)
+#define CM_DEMCR		CM_REG(0xE000EDFCU)
+#define CM_DWT_CTRL		CM_REG(0xE0001000U)
+#define CM_DWT_CYCCNT		CM_REG(0xE0001004U)
+#define CM_DWT_LAR		CM_REG(0xE0001FB0U)
+#define CM_SYST_CSR		CM_REG(0xE000E010U)
+#define CM_SYST_RVR		CM_REG(0xE000E014U)
+#define CM_SYST_CVR		CM_REG(0xE000E018U)
+
+typedef struct {
+
+	uint32_t	N;
+	uint32_t	max;
+	uint64_t	sum;
+}
+cm_stat_t;
+
+static pmc_t		pm;
+
+static trace_frame_t	frame[CM_FRAME_CHUNK];
+static cm_stat_t	stat[CM_MODE_MAX];
+
+static int		cm_systick;
+
+extern void _start();
+extern uint32_t __stack;
+
+void cm_reset()
+{
+	/* Enable FPU before any floating-point code.
+	 * */
+	CM_CPACR |= (0xFU << 20);
+
+	__asm volatile ("dsb \n isb \n");
+
+	_start();
+}
+
+static void
+cm_fault()
+{
+	exit(-1);
+}
+
+__attribute__ ((section(".vectors"), used))
+void *vectors[] = {
+
+	(void *) &__stack,
+	(void *) &cm_reset,
+	(void *) &cm_fault,
+	(void *) &cm_fault,
+	(void *) &cm_fault,
+	(void *) &cm_fault,
+	(void *) &cm_fault,
+};
+
+static void
+cm_proc_DC(int A, int B, int C) { }
+
+static void
+cm_proc_Z(int Z) { }
+
+static void
+cm_clock_enable()
+{
+	CM_DEMCR |= (1U << 24);
+	CM_DWT_LAR = 0xC5ACCE55U;
+	CM_DWT_CYCCNT = 0U;
+	CM_DWT_CTRL |= 1U;
+
+	__asm volatile ("nop \n nop \n nop \n nop \n");
+
+	if (CM_DWT_CYCCNT == 0U) {
+
+		/* Simulator does not implement DWT so we count by SysTick
+		 * clocked from the core. In QEMU this gives the number of
+		 * instructions when run with -icount.
+		 * */
+		CM_SYST_RVR = 0xFFFFFFU;
+		CM_SYST_CVR = 0U;
+		CM_SYST_CSR = 5U;
+
+		cm_systick = 1;
+	}
+}
+
+static inline uint32_t
+cm_clock()
+{
+	return (cm_systick != 0) ? 0xFFFFFFU - CM_SYST_CVR : CM_DWT_CYCCNT;
+}
+
+static inline uint32_t
+cm_clock_diff(uint32_t tBEGIN, uint32_t tEND)
+{
+	return (cm_systick != 0) ? (tEND - tBEGIN) & 0xFFFFFFU : tEND - tBEGIN;
+}
+
+static void
+cm_lse_load(lse_t *ls, const trace_lse_t *tl)
+{
+	int		N;
+
+	/* Pointers into the LSE memory are built again on target.
+	 * */
+	lse_construct(ls, tl->n_cascades, tl->n_len_of_x, tl->n_len_of_z);
+
+	ls->n_threshold = tl->n_threshold;
+	ls->n_total = tl->n_total;
+
+	for (N = 0; N < LSE_CASCADE_MAX; ++N) {
+
+		ls->rm[N].keep = tl->keep[N];
+		ls->rm[N].lazy = tl->lazy[N];
+	}
+
+	ls->esv.min = tl->esv_min;
+	ls->esv.max = tl->esv_max;
+
+	memcpy(ls->vm, tl->vm, sizeof(ls->vm));
+}
+
+static const char *
+cm_mode_name(int mode)
+{
+	const char	*list[] = {
+
+		PM_SFI(PM_LU_DISABLED),
+		PM_SFI(PM_LU_DETACHED),
+		PM_SFI(PM_LU_FORCED),
+		PM_SFI(PM_LU_ESTIMATE),
+		PM_SFI(PM_LU_ON_HFI),
+		PM_SFI(PM_LU_SENSOR_HALL),
+		PM_SFI(PM_LU_SENSOR_EABI),
+		PM_SFI(PM_LU_SENSOR_SINCOS),
+	};
+
+	return (mode >= 0 && mode < CM_MODE_MAX) ? list[mode] : "";
+}
+
+static int
+cm_replay(const char *file)
+{
+	FILE			*fd;
+	trace_head_t		head;
+	trace_lse_t		tl;
+	const trace_frame_t	*fr;
+	uint32_t		tBEGIN, tEND, lap, worst;
+	int			mode, N, len, frame_N;
+
+	float			mean, us, fmax;
+
+	fd = fopen(file, "rb");
+
+	if (fd == NULL) {
+
+		printf("unable to open %s\n", file);
+		return -1;
+	}
+
+	if (		fread(&head, sizeof(head), 1, fd) != 1
+			|| head.magic != TRACE_MAGIC
+			|| head.version != TRACE_VERSION
+			|| head.pm_size != TRACE_PM_SIZE
+			|| head.frame_size != sizeof(trace_frame_t)) {
+
+		printf("%s: trace layout does not match\n", file);
+
+		fclose(fd);
+		return -1;
+	}
+
+	memset(&pm, 0, sizeof(pm));
+
+	fread(&pm, TRACE_PM_SIZE, 1, fd);
+	fread(&pm.lfseed, sizeof(lfseed_t), 1, fd);
+
+	for (N = 0; N < 2; ++N) {
+
+		fread(&tl, sizeof(tl), 1, fd);
+
+		cm_lse_load(&pm.lse[N], &tl);
+	}
+
+	pm.proc_set_DC = &cm_proc_DC;
+	pm.proc_set_Z = &cm_proc_Z;
+
+	pm_feedback_select(&pm);
+
+	memset(stat, 0, sizeof(stat));
+
+	frame_N = head.frame_N;
+
+	while (frame_N > 0) {
+
+		len = (frame_N < CM_FRAME_CHUNK) ? frame_N : CM_FRAME_CHUNK;
+
+		if (fread(frame, sizeof(trace_frame_t), len, fd) != len)
+			break;
+
+		for (N = 0; N < len; ++N) {
+
+			fr = &frame[N];
+
+			pm.fsm_req = fr->fsm_req;
+			pm.s_setpoint_speed = fr->s_setpoint_speed;
+			pm.i_setpoint_current = fr->i_setpoint_current;
+
+			/* We attribute the call to the mode it was started in.
+			 * */
+			mode = pm.lu_MODE;
+
+			tBEGIN = cm_clock();
+
+			pm_feedback(&pm, (pmfb_t *) &fr->fb);
+
+			tEND = cm_clock();
+
+			lap = cm_clock_diff(tBEGIN, tEND);
+
+			if (mode >= 0 && mode < CM_MODE_MAX) {
+
+				stat[mode].N += 1;
+				stat[mode].sum += lap;
+				stat[mode].max = (lap > stat[mode].max) ? lap
+					: stat[mode].max;
+			}
+		}
+
+		frame_N -= len;
+	}
+
+	fclose(fd);
+
+	printf("\n%s (ESTIMATE %i SENSOR %i HFI %i)\n", file,
+			pm.config_LU_ESTIMATE, pm.config_LU_SENSOR,
+			pm.config_HFI_WAVETYPE);
+
+	worst = 0;
+
+	for (mode = 0; mode < CM_MODE_MAX; ++mode) {
+
+		if (stat[mode].N == 0)
+			continue;
+
+		mean = (float) stat[mode].sum / (float) stat[mode].N;
+		us = (float) stat[mode].max * 1000000.f / (float) CM_CLOCK_HZ;
+		fmax = CM_IRQ_LOAD * (float) CM_CLOCK_HZ / (float) stat[mode].max;
+
+		printf("%-20s %8u %8.1f %8u %8.2f %10.0f\n", cm_mode_name(mode),
+				(unsigned) stat[mode].N, (double) mean,
+				(unsigned) stat[mode].max, (double) us,
+				(double) fmax);
+
+		worst = (stat[mode].max > worst) ? stat[mode].max : worst;
+	}
+
+	if (worst != 0) {
+
+		fmax = CM_IRQ_LOAD * (float) CM_CLOCK_HZ / (float) worst;
+
+		printf("%-20s %8s %8s %8u %8s %10.0f %s%s\n", "PWM " _HW_REV, "",
+				"", (unsigned) worst, "", (double) HW_PWM_FREQUENCY_HZ,
+				(fmax < HW_PWM_FREQUENCY_HZ) ? "OVER" : "OK",
+				(cm_systick != 0) ? " (estimate)" : "");
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	int		N;
+
+	cm_clock_enable();
+
+	if (cm_systick != 0) {
+
+		/* QEMU does not model pipeline and memory wait states so we
+		 * only get the estimate that needs validation on the board.
+		 * */
+		printf("SysTick counts instructions, time is estimated at one"
+				" instruction per clock\n");
+	}
+	else {
+		printf("DWT counts clocks\n");
+	}
+
+	printf("clock %u Hz load %.2f\n", (unsigned) CM_CLOCK_HZ,
+			(double) CM_IRQ_LOAD);
+
+	printf("%-20s %8s %8s %8s %8s %10s\n", "lu_MODE", "N",
+			"mean", "max", "max (us)", "fPWM (Hz)");
+
+	for (N = 1; N < argc; ++N) {
+
+		cm_replay(argv[N]);
+	}
+
+	return 0;
+}
+
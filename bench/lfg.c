@@ -1,16 +1,10 @@
 #include <stdint.h>
+#include <string.h>
 #include <math.h>
 
 #include "lfg.h"
 
-typedef struct {
-
-	double		seed[55];
-	int		ra, rb;
-}
-lfg_t;
-
-static lfg_t		lfg;
+#define LFG_BATCH_MAX		165
 
 static uint32_t
 lfg_lcgu(uint32_t rseed)
@@ -21,7 +15,7 @@ lfg_lcgu(uint32_t rseed)
 	return rseed * 17317U + 1U;
 }
 
-void lfg_start(int seed)
+void lfg_start(lfg_t *lfg, int seed)
 {
 	uint32_t	lcgu;
 	int		i;
@@ -29,44 +23,106 @@ void lfg_start(int seed)
 	lcgu = lfg_lcgu(seed);
 	lcgu = lfg_lcgu(lcgu);
 
-	for (i = 0; i < 55; ++i) {
+	for (i = 0; i < LFG_SEED_MAX; ++i) {
 
-		lfg.seed[i] = (double) (lcgu = lfg_lcgu(lcgu)) / 4294967296.;
+		lfg->seed[i] = (double) (lcgu = lfg_lcgu(lcgu)) / 4294967296.;
 	}
 
-	lfg.ra = 0;
-	lfg.rb = 31;
+	lfg->ra = 0;
+	lfg->rb = 31;
 }
 
-double lfg_urand()
+static inline double
+lfg_lagged(double a, double b)
 {
-	double		x, a, b;
+	return (a < b) ? a - b + 1. : a - b - 1.;
+}
+
+double lfg_urand(lfg_t *lfg)
+{
+	double		x;
 
 	/* Lagged Fibonacci generator.
 	 * */
 
-	a = lfg.seed[lfg.ra];
-	b = lfg.seed[lfg.rb];
+	x = lfg_lagged(lfg->seed[lfg->ra], lfg->seed[lfg->rb]);
 
-	x = (a < b) ? a - b + 1. : a - b - 1.;
+	lfg->seed[lfg->ra] = x;
 
-	lfg.seed[lfg.ra] = x;
-
-	lfg.ra = (lfg.ra < 54) ? lfg.ra + 1 : 0;
-	lfg.rb = (lfg.rb < 54) ? lfg.rb + 1 : 0;
+	lfg->ra = (lfg->ra < LFG_SEED_MAX - 1) ? lfg->ra + 1 : 0;
+	lfg->rb = (lfg->rb < LFG_SEED_MAX - 1) ? lfg->rb + 1 : 0;
 
 	return x;
 }
 
-double lfg_gauss()
+double lfg_gauss(lfg_t *lfg)
 {
 	double		x;
 
 	/* Normal distribution fast approximation.
 	 * */
 
-	x = lfg_urand() + lfg_urand() + lfg_urand();
+	x = lfg_urand(lfg);
+	x += lfg_urand(lfg);
+	x += lfg_urand(lfg);
 
 	return x;
 }
 
+void lfg_urand_batch(lfg_t *lfg, double *x, int N)
+{
+	double		*seed = lfg->seed;
+	int		i;
+
+	/* Produce the same sequence as lfg_urand() but update the whole seed
+	 * array at once when it is aligned. Lags are (55, 24) so each of two
+	 * loops has no dependency shorter than 24 and can be vectorized.
+	 * */
+
+	while (N > 0) {
+
+		if (lfg->ra == 0 && N >= LFG_SEED_MAX) {
+
+			for (i = 0; i < 24; ++i) {
+
+				seed[i] = lfg_lagged(seed[i], seed[i + 31]);
+			}
+
+			for (i = 24; i < LFG_SEED_MAX; ++i) {
+
+				seed[i] = lfg_lagged(seed[i], seed[i - 24]);
+			}
+
+			memcpy(x, seed, sizeof(double) * LFG_SEED_MAX);
+
+			x += LFG_SEED_MAX;
+			N -= LFG_SEED_MAX;
+		}
+		else {
+			*x++ = lfg_urand(lfg);
+			N--;
+		}
+	}
+}
+
+void lfg_gauss_batch(lfg_t *lfg, double *x, int N)
+{
+	double		u[LFG_BATCH_MAX];
+	int		i, len;
+
+	while (N > 0) {
+
+		len = (N < LFG_BATCH_MAX / 3) ? N : LFG_BATCH_MAX / 3;
+
+		lfg_urand_batch(lfg, u, len * 3);
+
+		for (i = 0; i < len; ++i) {
+
+			x[i] = u[i * 3 + 0] + u[i * 3 + 1] + u[i * 3 + 2];
+		}
+
+		x += len;
+		N -= len;
+	}
+}
+
@@ -1,10 +1,22 @@
 #ifndef _H_LFG_
 #define _H_LFG_
 
-void lfg_start(int rseed);
+#define LFG_SEED_MAX		55
 
-double lfg_urand();
-double lfg_gauss();
+typedef struct {
+
+	double		seed[LFG_SEED_MAX];
+	int		ra, rb;
+}
+lfg_t;
+
+void lfg_start(lfg_t *lfg, int rseed);
+
+double lfg_urand(lfg_t *lfg);
+double lfg_gauss(lfg_t *lfg);
+
+void lfg_urand_batch(lfg_t *lfg, double *x, int N);
+void lfg_gauss_batch(lfg_t *lfg, double *x, int N);
 
 #endif /* _H_LFG_ */
 
@@ -0,0 +1 @@
+#include "../pgui/gp/lz4.c"
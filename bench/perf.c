@@ -0,0 +1,717 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+
+#include <linux/perf_event.h>
+
+#include "blm.h"
+#include "perf.h"
+#include "pm.h"
+#include "run.h"
+#include "trace.h"
+#include "tsfunc.h"
+
+#define PERF_FILE		"/tmp/pm-PERF"
+
+#define PERF_FRAME_MAX		200000
+#define PERF_RESULT_MAX		40
+#define PERF_REPEAT		5
+#define PERF_LIBM_N		4096
+
+typedef struct {
+
+	char		name[40];
+
+	double		ns;
+	double		instr;
+}
+perf_result_t;
+
+typedef struct {
+
+	int		record;
+	int		frame_N;
+
+	pmc_t		pm_begin;
+	pmc_t		pm_end;
+
+	trace_frame_t	frame[PERF_FRAME_MAX];
+
+	int		fd_instr;
+
+	int		result_N;
+	perf_result_t	result[PERF_RESULT_MAX];
+
+	int		replay_fault;
+	int		fv_fault;
+}
+perf_t;
+
+static perf_t		perf;
+
+const char		*perf_file_base;
+const char		*perf_dir_trace;
+
+double			perf_tolerance = 10.;
+
+void perf_record(const pmfb_t *fb)
+{
+	trace_frame_t		*fr;
+
+	if (perf.record != 1)
+		return ;
+
+	if (		pm.lu_MODE == PM_LU_DISABLED
+			&& perf.frame_N == 0)
+		return ;
+
+	if (perf.frame_N == 0) {
+
+		perf.pm_begin = pm;
+	}
+
+	fr = &perf.frame[perf.frame_N++];
+
+	fr->fb = *fb;
+	fr->fsm_req = pm.fsm_req;
+	fr->s_setpoint_speed = pm.s_setpoint_speed;
+	fr->i_setpoint_current = pm.i_setpoint_current;
+}
+
+void perf_record_end()
+{
+	if (		perf.record == 1
+			&& perf.frame_N != 0
+			&& (	   pm.lu_MODE == PM_LU_DISABLED
+				|| perf.frame_N >= PERF_FRAME_MAX)) {
+
+		perf.pm_end = pm;
+		perf.record = 2;
+	}
+}
+
+static void
+perf_proc_DC(int A, int B, int C) { }
+
+static void
+perf_proc_Z(int Z) { }
+
+static void
+perf_instr_open()
+{
+	struct perf_event_attr		pe;
+
+	memset(&pe, 0, sizeof(pe));
+
+	pe.type = PERF_TYPE_HARDWARE;
+	pe.size = sizeof(pe);
+	pe.config = PERF_COUNT_HW_INSTRUCTIONS;
+	pe.disabled = 1;
+	pe.exclude_kernel = 1;
+	pe.exclude_hv = 1;
+
+	/* Instruction counter may be unavailable in VM or container, then
+	 * we report time only.
+	 * */
+	perf.fd_instr = (int) syscall(__NR_perf_event_open, &pe, 0, -1, -1, 0);
+}
+
+static void
+perf_instr_start()
+{
+	if (perf.fd_instr >= 0) {
+
+		ioctl(perf.fd_instr, PERF_EVENT_IOC_RESET, 0);
+		ioctl(perf.fd_instr, PERF_EVENT_IOC_ENABLE, 0);
+	}
+}
+
+static double
+perf_instr_stop()
+{
+	long long	count;
+
+	if (perf.fd_instr >= 0) {
+
+		ioctl(perf.fd_instr, PERF_EVENT_IOC_DISABLE, 0);
+
+		if (read(perf.fd_instr, &count, sizeof(count)) == sizeof(count))
+			return (double) count;
+	}
+
+	return -1.;
+}
+
+static void
+perf_result(const char *name, double ns, double instr)
+{
+	perf_result_t		*rs;
+
+	if (perf.result_N < PERF_RESULT_MAX) {
+
+		rs = &perf.result[perf.result_N++];
+
+		snprintf(rs->name, sizeof(rs->name), "%s", name);
+
+		rs->ns = ns;
+		rs->instr = instr;
+	}
+}
+
+static void
+perf_replay(const char *name, void (* proc) (pmc_t *, pmfb_t *))
+{
+	const trace_frame_t	*fr;
+	double			tBEGIN, ns, ns_min, instr;
+	int			N, R, exact;
+
+	ns_min = 0.;
+	instr = -1.;
+
+	for (R = 0; R < PERF_REPEAT; ++R) {
+
+		pm = perf.pm_begin;
+
+		pm.proc_set_DC = &perf_proc_DC;
+		pm.proc_set_Z = &perf_proc_Z;
+
+		perf_instr_start();
+
+		tBEGIN = run_clock();
+
+		for (N = 0; N < perf.frame_N; ++N) {
+
+			fr = &perf.frame[N];
+
+			pm.fsm_req = fr->fsm_req;
+			pm.s_setpoint_speed = fr->s_setpoint_speed;
+			pm.i_setpoint_current = fr->i_setpoint_current;
+
+			proc(&pm, (pmfb_t *) &fr->fb);
+		}
+
+		ns = (run_clock() - tBEGIN) * 1.E+9 / perf.frame_N;
+		instr = perf_instr_stop();
+		instr = (instr >= 0.) ? instr / perf.frame_N : -1.;
+
+		ns_min = (R == 0 || ns < ns_min) ? ns : ns_min;
+	}
+
+	/* Controller does not read back its own outputs so the replay must
+	 * reproduce the recorded state exactly.
+	 * */
+	exact = (	   pm.lu_iX == perf.pm_end.lu_iX
+			&& pm.lu_iY == perf.pm_end.lu_iY
+			&& pm.lu_wS == perf.pm_end.lu_wS
+			&& pm.lu_MODE == perf.pm_end.lu_MODE) ? 1 : 0;
+
+	if (exact == 0) {
+
+		fprintf(stderr, "perf: %s replay diverged from record\n", name);
+
+		perf.replay_fault = 1;
+	}
+
+	printf("perf: %s %i calls\n", name, perf.frame_N);
+
+	perf_result(name, ns_min, instr);
+}
+
+#ifdef _PM_FV
+/* Configurations that we force on recorded stream to cross-check each of
+ * feedback variants and the fallback to generic one. Negative value
+ * keeps the recorded configuration.
+ * */
+static const int	perf_fv_config[][4] = {
+
+	{ -1, -1, -1, -1 },
+	{ PM_NOP_THREE_PHASE, PM_FLUX_ORTEGA, PM_SENSOR_NONE, PM_HFI_NONE },
+	{ PM_NOP_TWO_PHASE, PM_FLUX_ORTEGA, PM_SENSOR_NONE, PM_HFI_NONE },
+	{ PM_NOP_THREE_PHASE, PM_FLUX_KALMAN, PM_SENSOR_NONE, PM_HFI_NONE },
+	{ PM_NOP_TWO_PHASE, PM_FLUX_KALMAN, PM_SENSOR_NONE, PM_HFI_NONE },
+	{ PM_NOP_THREE_PHASE, PM_FLUX_KALMAN, PM_SENSOR_NONE, PM_HFI_SINE },
+	{ PM_NOP_TWO_PHASE, PM_FLUX_KALMAN, PM_SENSOR_NONE, PM_HFI_SINE },
+	{ PM_NOP_THREE_PHASE, PM_FLUX_NONE, PM_SENSOR_HALL, PM_HFI_NONE },
+	{ PM_NOP_TWO_PHASE, PM_FLUX_ORTEGA, PM_SENSOR_HALL, PM_HFI_NONE },
+	{ PM_NOP_THREE_PHASE, PM_FLUX_NONE, PM_SENSOR_EABI, PM_HFI_NONE },
+	{ PM_NOP_TWO_PHASE, PM_FLUX_KALMAN, PM_SENSOR_EABI, PM_HFI_NONE },
+	{ PM_NOP_THREE_PHASE, PM_FLUX_KALMAN, PM_SENSOR_NONE, PM_HFI_RANDOM },
+	{ PM_NOP_THREE_PHASE, PM_FLUX_NONE, PM_SENSOR_SINCOS, PM_HFI_NONE }
+};
+
+static int
+perf_variant(const int config[4], int *fv_ID)
+{
+	static pmc_t		pm_fv;
+
+	const trace_frame_t	*fr;
+	int			N, diff_N;
+
+	pm = perf.pm_begin;
+
+	pm.proc_set_DC = &perf_proc_DC;
+	pm.proc_set_Z = &perf_proc_Z;
+
+	pm.config_NOP = (config[0] >= 0) ? config[0] : pm.config_NOP;
+	pm.config_LU_ESTIMATE = (config[1] >= 0) ? config[1] : pm.config_LU_ESTIMATE;
+	pm.config_LU_SENSOR = (config[2] >= 0) ? config[2] : pm.config_LU_SENSOR;
+	pm.config_HFI_WAVETYPE = (config[3] >= 0) ? config[3] : pm.config_HFI_WAVETYPE;
+
+	pm_fv = pm;
+
+	pm_feedback_select(&pm_fv);
+
+	*fv_ID = pm_fv.fv_ID;
+
+	diff_N = 0;
+
+	/* Specialized variant must give exactly the same controller state
+	 * as generic path after each call.
+	 * */
+	for (N = 0; N < perf.frame_N; ++N) {
+
+		fr = &perf.frame[N];
+
+		pm.fsm_req = fr->fsm_req;
+		pm.s_setpoint_speed = fr->s_setpoint_speed;
+		pm.i_setpoint_current = fr->i_setpoint_current;
+
+		pm_fv.fsm_req = fr->fsm_req;
+		pm_fv.s_setpoint_speed = fr->s_setpoint_speed;
+		pm_fv.i_setpoint_current = fr->i_setpoint_current;
+
+		pm_feedback_generic(&pm, (pmfb_t *) &fr->fb);
+		pm_feedback(&pm_fv, (pmfb_t *) &fr->fb);
+
+		if (memcmp(&pm, &pm_fv, TRACE_PM_SIZE) != 0) {
+
+			/* Go on from the same state to count the mismatches.
+			 * */
+			memcpy(&pm_fv, &pm, TRACE_PM_SIZE);
+
+			diff_N++;
+		}
+	}
+
+	return diff_N;
+}
+
+static void
+perf_variant_check(const char *name)
+{
+	int		N, fv_ID, diff_N;
+
+	printf("perf: %s variants", name);
+
+	for (N = 0; N < sizeof(perf_fv_config) / sizeof(perf_fv_config[0]); ++N) {
+
+		diff_N = perf_variant(perf_fv_config[N], &fv_ID);
+
+		printf(" %i", fv_ID);
+
+		if (diff_N != 0) {
+
+			fprintf(stderr, "\nperf: %s variant %i differs from generic"
+					" in %i calls\n", name, fv_ID, diff_N);
+
+			perf.fv_fault = 1;
+		}
+	}
+
+	printf("\n");
+
+	/* Leave the controller as it was after the replay.
+	 * */
+	pm = perf.pm_end;
+}
+#endif /* _PM_FV */
+
+static void
+perf_trace_lse(trace_lse_t *tl, const lse_t *ls)
+{
+	int		N;
+
+	tl->n_cascades = ls->n_cascades;
+	tl->n_len_of_x = ls->n_len_of_x;
+	tl->n_len_of_z = ls->n_len_of_z;
+	tl->n_threshold = ls->n_threshold;
+	tl->n_total = ls->n_total;
+
+	for (N = 0; N < LSE_CASCADE_MAX; ++N) {
+
+		tl->keep[N] = ls->rm[N].keep;
+		tl->lazy[N] = ls->rm[N].lazy;
+	}
+
+	tl->esv_min = ls->esv.min;
+	tl->esv_max = ls->esv.max;
+
+	memcpy(tl->vm, ls->vm, sizeof(tl->vm));
+}
+
+static void
+perf_trace_write(const char *name)
+{
+	FILE		*fd;
+	trace_head_t	head;
+	trace_lse_t	tl;
+	char		file[RUN_PATH_MAX];
+	int		N;
+
+	snprintf(file, RUN_PATH_MAX, "%s/%s.trace", perf_dir_trace, name);
+
+	fd = fopen(file, "wb");
+
+	if (fd == NULL) {
+
+		fprintf(stderr, "fopen: %s\n", strerror(errno));
+		return ;
+	}
+
+	head.magic = TRACE_MAGIC;
+	head.version = TRACE_VERSION;
+	head.pm_size = TRACE_PM_SIZE;
+	head.frame_size = sizeof(trace_frame_t);
+	head.frame_N = perf.frame_N;
+	head.reserved = 0;
+
+	fwrite(&head, sizeof(head), 1, fd);
+	fwrite(&perf.pm_begin, TRACE_PM_SIZE, 1, fd);
+	fwrite(&perf.pm_begin.lfseed, sizeof(lfseed_t), 1, fd);
+
+	for (N = 0; N < 2; ++N) {
+
+		perf_trace_lse(&tl, &perf.pm_begin.lse[N]);
+
+		fwrite(&tl, sizeof(tl), 1, fd);
+	}
+
+	fwrite(perf.frame, sizeof(trace_frame_t), perf.frame_N, fd);
+
+	fclose(fd);
+}
+
+static void
+perf_feedback(const char *name, int mach_ID, const char *script,
+		int knob_ESTIMATE)
+{
+	const ts_script_t	*ts;
+
+#ifdef _PM_FV
+	char			name_generic[40];
+#endif /* _PM_FV */
+
+	blm_enable(&m);
+	blm_restart(&m);
+
+	ts_script_machine(&ts_machine_list[mach_ID], "");
+
+	if (knob_ESTIMATE >= 0) {
+
+		pm.config_LU_ESTIMATE = knob_ESTIMATE;
+	}
+
+	ts = ts_script_search(script, strlen(script));
+
+	perf.record = 1;
+	perf.frame_N = 0;
+
+	ts->proc();
+
+	if (perf.record == 1 && perf.frame_N != 0) {
+
+		perf.pm_end = pm;
+	}
+
+	perf.record = 0;
+
+	if (perf.frame_N != 0) {
+
+		if (perf_dir_trace != NULL) {
+
+			perf_trace_write(name);
+		}
+
+		perf_replay(name, &pm_feedback);
+
+#ifdef _PM_FV
+		snprintf(name_generic, sizeof(name_generic), "%s_generic", name);
+
+		perf_replay(name_generic, &pm_feedback_generic);
+		perf_variant_check(name);
+#endif /* _PM_FV */
+	}
+}
+
+static void
+perf_libm_unary(const char *name, float (* proc) (float), float x0, float x1)
+{
+	static float	x[PERF_LIBM_N];
+
+	volatile float	sink;
+	double		tBEGIN, ns, ns_min, instr;
+	float		sum;
+	int		N, R;
+
+	for (N = 0; N < PERF_LIBM_N; ++N) {
+
+		x[N] = x0 + (x1 - x0) * (float) N / (float) PERF_LIBM_N;
+	}
+
+	ns_min = 0.;
+	instr = -1.;
+
+	for (R = 0; R < PERF_REPEAT * 100; ++R) {
+
+		sum = 0.f;
+
+		perf_instr_start();
+
+		tBEGIN = run_clock();
+
+		for (N = 0; N < PERF_LIBM_N; ++N) {
+
+			sum += proc(x[N]);
+		}
+
+		ns = (run_clock() - tBEGIN) * 1.E+9 / PERF_LIBM_N;
+		instr = perf_instr_stop();
+		instr = (instr >= 0.) ? instr / PERF_LIBM_N : -1.;
+
+		ns_min = (R == 0 || ns < ns_min) ? ns : ns_min;
+
+		sink = sum;
+	}
+
+	(void) sink;
+
+	perf_result(name, ns_min, instr);
+}
+
+static float
+perf_m_atan2f(float x) { return m_atan2f(x, 1.f - x); }
+
+static float
+perf_m_cosf_sinf(float x) { return m_cosf(x) + m_sinf(x); }
+
+static float
+perf_m_cossinf(float x)
+{
+	float		F[2];
+
+	m_cossinf(F, x);
+
+	return F[0] + F[1];
+}
+
+static float
+perf_m_rotatef(float x)
+{
+	float		v[2] = { 1.f - x, x };
+
+	m_rotatef(v, x * 1.E-1f);
+
+	return v[0] + v[1];
+}
+
+static float
+perf_m_rotatef_twice(float x)
+{
+	float		v[2] = { 1.f - x, x };
+
+	m_rotatef(v, x * 1.E-1f);
+	m_rotatef(v, x * 1.E-1f);
+
+	return v[0] + v[1];
+}
+
+static float
+perf_m_turnf_twice(float x)
+{
+	float		v[2] = { 1.f - x, x }, F[2];
+
+	m_rotorf(F, x * 1.E-1f);
+	m_turnf(v, F);
+	m_turnf(v, F);
+
+	return v[0] + v[1];
+}
+
+static float
+perf_m_normalizef(float x)
+{
+	float		v[2] = { 1.f - x, x };
+
+	m_normalizef(v);
+
+	return v[0] + v[1];
+}
+
+static int
+perf_base_compare()
+{
+	FILE		*fd;
+	char		line[200], name[40];
+	double		ns, instr, dns, dinstr, dcmp;
+	int		N, found, over_N;
+
+	fd = fopen(perf_file_base, "r");
+
+	if (fd == NULL) {
+
+		/* No baseline yet so we store the current results.
+		 * */
+		fd = fopen(perf_file_base, "w");
+
+		if (fd == NULL) {
+
+			fprintf(stderr, "fopen: %s\n", strerror(errno));
+			return -1;
+		}
+
+		for (N = 0; N < perf.result_N; ++N) {
+
+			fprintf(fd, "%s %.3f %.1f\n", perf.result[N].name,
+					perf.result[N].ns, perf.result[N].instr);
+		}
+
+		fclose(fd);
+
+		printf("perf: baseline stored in %s\n", perf_file_base);
+
+		return 0;
+	}
+
+	printf("\n%-24s %10s %10s %10s %10s\n", "baseline", "ns/call",
+			"diff (%)", "instr/call", "diff (%)");
+
+	found = 0;
+	over_N = 0;
+
+	while (fgets(line, sizeof(line), fd) != NULL) {
+
+		if (sscanf(line, "%39s %lf %lf", name, &ns, &instr) != 3)
+			continue;
+
+		for (N = 0; N < perf.result_N; ++N) {
+
+			if (strcmp(perf.result[N].name, name) != 0)
+				continue;
+
+			dns = 100. * (perf.result[N].ns - ns) / ns;
+			dinstr = (instr > 0. && perf.result[N].instr > 0.)
+				? 100. * (perf.result[N].instr - instr) / instr : 0.;
+
+			printf("%-24s %10.1f %+10.1f %10.1f %+10.1f\n", name,
+					ns, dns, instr, dinstr);
+
+			/* Instruction count is stable from run to run so we
+			 * compare it if it is known on both sides.
+			 * */
+			dcmp = (instr > 0. && perf.result[N].instr > 0.)
+				? dinstr : dns;
+
+			if (dcmp > perf_tolerance) {
+
+				fprintf(stderr, "perf: %s is %.1f %% slower than"
+						" baseline\n", name, dcmp);
+
+				over_N++;
+			}
+
+			found++;
+		}
+	}
+
+	fclose(fd);
+
+	if (found < perf.result_N) {
+
+		printf("perf: %i results are not in baseline\n",
+				perf.result_N - found);
+	}
+
+	return (over_N != 0) ? -1 : 0;
+}
+
+int perf_script()
+{
+	FILE		*fd;
+	int		N;
+
+	perf_instr_open();
+
+	if (perf.fd_instr < 0) {
+
+		fprintf(stderr, "perf: no instruction counter (%s)\n", strerror(errno));
+	}
+
+	tlm_disable();
+
+	if (perf_dir_trace != NULL) {
+
+		mkdir(perf_dir_trace, 0755);
+	}
+
+	/* Feedback streams are recorded from closed loop run of the plant
+	 * model and then are replayed through the controller alone.
+	 * */
+	perf_feedback("fb_ortega", 1, "speed", PM_FLUX_ORTEGA);
+	perf_feedback("fb_kalman", 1, "speed", PM_FLUX_KALMAN);
+	perf_feedback("fb_kalman_steady", 1, "kalman_steady", -1);
+	perf_feedback("fb_kalman_hfi", 1, "hfi", -1);
+	perf_feedback("fb_kalman_weak", 2, "weakening", PM_FLUX_KALMAN);
+	perf_feedback("fb_hall", 2, "hall", -1);
+	perf_feedback("fb_eabi", 1, "eabi_inc", -1);
+
+	perf_libm_unary("m_sinf", &m_sinf, - 3.f, 3.f);
+	perf_libm_unary("m_cosf", &m_cosf, - 3.f, 3.f);
+	perf_libm_unary("m_cosf+m_sinf", &perf_m_cosf_sinf, - 3.f, 3.f);
+	perf_libm_unary("m_cossinf", &perf_m_cossinf, - 3.f, 3.f);
+	perf_libm_unary("m_atan2f", &perf_m_atan2f, - 1.f, 2.f);
+	perf_libm_unary("m_rotatef", &perf_m_rotatef, - 1.f, 1.f);
+	perf_libm_unary("m_rotatef_twice", &perf_m_rotatef_twice, - 1.f, 1.f);
+	perf_libm_unary("m_turnf_twice", &perf_m_turnf_twice, - 1.f, 1.f);
+	perf_libm_unary("m_normalizef", &perf_m_normalizef, 0.1f, 1.f);
+	perf_libm_unary("m_logf", &m_logf, 0.01f, 100.f);
+	perf_libm_unary("m_expf", &m_expf, - 10.f, 10.f);
+	perf_libm_unary("m_fast_recipf", &m_fast_recipf, 0.1f, 10.f);
+	perf_libm_unary("m_fast_rsqrtf", &m_fast_rsqrtf, 0.1f, 10.f);
+
+	printf("\n%-24s %10s %10s\n", "perf", "ns/call", "instr/call");
+
+	fd = fopen(PERF_FILE, "w");
+
+	for (N = 0; N < perf.result_N; ++N) {
+
+		printf("%-24s %10.1f %10.1f\n", perf.result[N].name,
+				perf.result[N].ns, perf.result[N].instr);
+
+		if (fd != NULL) {
+
+			fprintf(fd, "%s %.3f %.1f\n", perf.result[N].name,
+					perf.result[N].ns, perf.result[N].instr);
+		}
+	}
+
+	if (fd != NULL) {
+
+		fclose(fd);
+	}
+
+	if (perf.fd_instr >= 0) {
+
+		close(perf.fd_instr);
+	}
+
+	if (perf.replay_fault != 0 || perf.fv_fault != 0)
+		return -1;
+
+	return (perf_file_base != NULL) ? perf_base_compare() : 0;
+}
@@ -0,0 +1,16 @@
+#ifndef _H_PERF_
+#define _H_PERF_
+
+#include "pm.h"
+
+extern const char	*perf_file_base;
+extern const char	*perf_dir_trace;
+extern double		perf_tolerance;
+
+void perf_record(const pmfb_t *fb);
+void perf_record_end();
+
+int perf_script();
+
+#endif /* _H_PERF_ */
+
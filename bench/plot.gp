@@ -1,7 +1,7 @@
 #!/usr/bin/env gp
 # vi:ft=conf
 
-load 0 0 float 100 "/tmp/pm-TLM"
+load 0 0 column "/tmp/pm-TLM"
 
 group 0 0
 deflabel 0 "(s)"
@@ -0,0 +1,235 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "blm.h"
+#include "pm.h"
+#include "run.h"
+#include "sweep.h"
+#include "tsfunc.h"
+
+run_t			run;
+
+double run_clock()
+{
+	struct timespec		ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double) ts.tv_sec + (double) ts.tv_nsec * 1.E-9;
+}
+
+int run_machine_load(const char *file)
+{
+	FILE		*fd;
+	char		line[400], name[80], script[200];
+	ts_machine_t	*mach;
+	int		rc;
+
+	fd = fopen(file, "r");
+
+	if (fd == NULL) {
+
+		fprintf(stderr, "fopen: %s\n", strerror(errno));
+		return -1;
+	}
+
+	run.N_mach = 0;
+
+	/* Each line describes one machine as follows:
+	 *
+	 * name Rs Ld Lq Udc Rdc Zp Kv Jm [script,...]
+	 * */
+	while (fgets(line, sizeof(line), fd) != NULL) {
+
+		if (line[strspn(line, " \t")] == '#')
+			continue;
+
+		if (run.N_mach >= RUN_MACHINE_MAX) {
+
+			fprintf(stderr, "too many machines in %s\n", file);
+			break;
+		}
+
+		mach = &run.mach[run.N_mach];
+		script[0] = 0;
+
+		rc = sscanf(line, "%79s %lf %lf %lf %lf %lf %i %lf %lf %199s",
+				name, &mach->Rs, &mach->Ld, &mach->Lq, &mach->Udc,
+				&mach->Rdc, &mach->Zp, &mach->Kv, &mach->Jm, script);
+
+		if (rc < 9)
+			continue;
+
+		mach->name = strdup(name);
+		mach->script = strdup((script[0] != 0) ? script : "speed");
+
+		run.N_mach++;
+	}
+
+	fclose(fd);
+
+	return run.N_mach;
+}
+
+void run_machine_builtin()
+{
+	const ts_machine_t	*mach;
+
+	run.N_mach = 0;
+
+	for (mach = ts_machine_list; mach->name != NULL; ++mach) {
+
+		run.mach[run.N_mach++] = *mach;
+	}
+}
+
+static void
+run_worker(int N)
+{
+	char		tag[40], file_log[RUN_PATH_MAX];
+
+	snprintf(tag, sizeof(tag), "%02i", N);
+	snprintf(file_log, RUN_PATH_MAX, "%s/%s.log", RUN_DIR, tag);
+
+	/* Each worker has its own copy of the plant, controller, telemetry
+	 * and noise generator because it runs in a separate process.
+	 * */
+	if (freopen(file_log, "w", stdout) == NULL) {
+
+		exit(-1);
+	}
+
+	dup2(fileno(stdout), fileno(stderr));
+
+	m.rseed = run.rseed + N;
+	m.sol_MODE = run.sol_MODE;
+
+	printf("rseed = %i\n", m.rseed);
+
+	tlm_setup(tag);
+
+	if (run.grab == 0) {
+
+		tlm_disable();
+	}
+
+	blm_enable(&m);
+	blm_restart(&m);
+
+#ifdef _PM_PROF
+	prof_restart();
+#endif /* _PM_PROF */
+
+	if (run.sweep != 0) {
+
+		sweep_worker(N);
+	}
+	else {
+		ts_script_machine(&run.mach[N], run.script);
+	}
+
+#ifdef _PM_PROF
+	prof_report();
+#endif /* _PM_PROF */
+
+	tlm_close();
+
+	fflush(stdout);
+
+	exit(0);
+}
+
+int run_parallel()
+{
+	pid_t		pid;
+	int		N, N_next, N_done, N_failed, status;
+
+	mkdir(RUN_DIR, 0755);
+
+	fflush(stdout);
+	fflush(stderr);
+
+	N_next = 0;
+	N_done = 0;
+	N_failed = 0;
+
+	while (N_done < run.N_mach) {
+
+		while (		N_next < run.N_mach
+				&& N_next - N_done < run.N_workers) {
+
+			run.job[N_next].tBEGIN = run_clock();
+
+			pid = fork();
+
+			if (pid == 0) {
+
+				run_worker(N_next);
+			}
+			else if (pid < 0) {
+
+				fprintf(stderr, "fork: %s\n", strerror(errno));
+				exit(-1);
+			}
+
+			run.job[N_next].pid = pid;
+
+			N_next++;
+		}
+
+		pid = waitpid(-1, &status, 0);
+
+		if (pid < 0) {
+
+			fprintf(stderr, "waitpid: %s\n", strerror(errno));
+			exit(-1);
+		}
+
+		for (N = 0; N < N_next; ++N) {
+
+			if (run.job[N].pid == pid)
+				break;
+		}
+
+		if (N >= N_next)
+			continue;
+
+		run.job[N].tEND = run_clock();
+		run.job[N].status = (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : 1;
+
+		N_failed += run.job[N].status;
+		N_done++;
+
+		printf("[%2i/%2i] %s %6.1f (s) %s (%s/%02i.log)\n", N_done, run.N_mach,
+				(run.job[N].status == 0) ? "PASS" : "FAIL",
+				run.job[N].tEND - run.job[N].tBEGIN,
+				run.mach[N].name, RUN_DIR, N);
+
+		fflush(stdout);
+	}
+
+	printf("%i of %i machines failed\n", N_failed, run.N_mach);
+
+	return (N_failed == 0) ? 0 : -1;
+}
+
+int run_script()
+{
+	int		N;
+
+	for (N = 0; N < run.N_mach; ++N) {
+
+		if (ts_script_check((run.script != NULL) ? run.script
+					: run.mach[N].script) != 0)
+			return -1;
+	}
+
+	return run_parallel();
+}
@@ -0,0 +1,74 @@
+#ifndef _H_RUN_
+#define _H_RUN_
+
+#include <sys/types.h>
+
+#include "tsfunc.h"
+
+#define RUN_DIR			"/tmp/pm-run"
+#define RUN_PATH_MAX		200
+
+#define RUN_MACHINE_MAX		200
+
+typedef struct {
+
+	int		rseed;
+	int		sol_MODE;
+
+	int		N_workers;
+	int		grab;
+
+	const char	*script;
+
+	int		N_mach;
+	ts_machine_t	mach[RUN_MACHINE_MAX];
+
+	int		sweep;
+	int		N_sample;
+
+	/* Board parameters of sweep samples are given as a factors to the
+	 * defaults of blm_enable().
+	 * */
+	struct {
+
+		double		k_Mq;
+		double		k_Cdc;
+		double		k_tau_A;
+		double		k_tau_B;
+		double		k_adc_noise;
+		double		k_deadtime;
+	}
+	sample[RUN_MACHINE_MAX];
+
+	struct {
+
+		pid_t		pid;
+		int		status;
+		double		tBEGIN;
+		double		tEND;
+	}
+	job[RUN_MACHINE_MAX];
+}
+run_t;
+
+extern run_t			run;
+
+extern void tlm_setup(const char *tag);
+extern void tlm_disable();
+extern void tlm_close();
+
+#ifdef _PM_PROF
+extern void prof_restart();
+extern void prof_report();
+#endif /* _PM_PROF */
+
+double run_clock();
+
+int run_machine_load(const char *file);
+void run_machine_builtin();
+
+int run_parallel();
+int run_script();
+
+#endif /* _H_RUN_ */
+
@@ -0,0 +1,928 @@
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <termios.h>
+#include <sys/select.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#define CHECK_FLASH		"/tmp/pmc-sil-check.flash"
+#define CHECK_TTY		"/tmp/pmc-sil-check-tty"
+
+#define CHECK_PROMPT		"(pmc) "
+#define CHECK_REPLY_MAX		400000
+#define CHECK_TIMEOUT		10.
+
+#define CHECK_BULK_FRAME	200
+#define CHECK_TLM_ROWS		20000
+
+/* Flash block layout as in src/flash.c.
+ * */
+#define CHECK_BLOCK_SIZE	16384
+#define CHECK_BLOCK_MAGIC	0x34434D50UL
+#define CHECK_BLOCK_HEAD	8
+
+typedef struct {
+
+	const char	*target;
+
+	pid_t		pid;
+	int		fd;
+
+	char		reply[CHECK_REPLY_MAX];
+
+	int		fail_N;
+}
+check_t;
+
+static check_t		chk;
+
+static double
+check_clock()
+{
+	struct timespec		ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double) ts.tv_sec + (double) ts.tv_nsec * 1E-9;
+}
+
+static void
+check_stop()
+{
+	if (chk.fd >= 0) {
+
+		close(chk.fd);
+		chk.fd = -1;
+	}
+
+	if (chk.pid > 0) {
+
+		kill(chk.pid, SIGTERM);
+		waitpid(chk.pid, NULL, 0);
+
+		chk.pid = 0;
+	}
+}
+
+static int
+check_start()
+{
+	struct termios		tio;
+	double			tEND;
+
+	unlink(CHECK_TTY);
+
+	chk.pid = fork();
+
+	if (chk.pid == 0) {
+
+		/* Firmware runs as fast as it goes idle so we do not wait
+		 * for the wall clock.
+		 * */
+		execl(chk.target, chk.target, "-f", "-m", CHECK_FLASH,
+				"-l", CHECK_TTY, (char *) NULL);
+
+		fprintf(stderr, "check: unable to run \"%s\" (%s)\n",
+				chk.target, strerror(errno));
+
+		_exit(EXIT_FAILURE);
+	}
+	else if (chk.pid < 0) {
+
+		return -1;
+	}
+
+	tEND = check_clock() + CHECK_TIMEOUT;
+
+	do {
+		chk.fd = open(CHECK_TTY, O_RDWR | O_NOCTTY);
+
+		if (chk.fd >= 0)
+			break;
+
+		usleep(10000);
+	}
+	while (check_clock() < tEND);
+
+	if (chk.fd < 0) {
+
+		fprintf(stderr, "check: no USART link on \"%s\"\n", CHECK_TTY);
+
+		check_stop();
+		return -1;
+	}
+
+	tcgetattr(chk.fd, &tio);
+	cfmakeraw(&tio);
+	tcsetattr(chk.fd, TCSANOW, &tio);
+
+	return 0;
+}
+
+static int
+check_read_prompt()
+{
+	struct timeval		tv;
+	fd_set			set;
+	double			tEND;
+	int			len = 0, rc;
+
+	tEND = check_clock() + CHECK_TIMEOUT;
+
+	chk.reply[0] = 0;
+
+	do {
+		FD_ZERO(&set);
+		FD_SET(chk.fd, &set);
+
+		tv.tv_sec = 0;
+		tv.tv_usec = 100000;
+
+		if (select(chk.fd + 1, &set, NULL, NULL, &tv) > 0) {
+
+			rc = read(chk.fd, chk.reply + len,
+					sizeof(chk.reply) - len - 1);
+
+			if (rc > 0) {
+
+				len += rc;
+				chk.reply[len] = 0;
+			}
+		}
+
+		if (		len >= (int) strlen(CHECK_PROMPT)
+				&& strcmp(chk.reply + len - strlen(CHECK_PROMPT),
+					CHECK_PROMPT) == 0) {
+
+			chk.reply[len - strlen(CHECK_PROMPT)] = 0;
+			return 0;
+		}
+	}
+	while (check_clock() < tEND && len < (int) sizeof(chk.reply) - 1);
+
+	return -1;
+}
+
+static const char *
+check_exec(const char *cmd)
+{
+	char		*eol;
+	int		len;
+
+	len = strlen(cmd);
+
+	if (		write(chk.fd, cmd, len) != len
+			|| write(chk.fd, "\r", 1) != 1) {
+
+		return NULL;
+	}
+
+	if (check_read_prompt() != 0) {
+
+		fprintf(stderr, "check: no reply to \"%s\"\n", cmd);
+		return NULL;
+	}
+
+	/* Skip the command echo.
+	 * */
+	eol = strstr(chk.reply, "\r\n");
+
+	return (eol != NULL) ? eol + 2 : chk.reply;
+}
+
+static void
+check_result(const char *name, int rc)
+{
+	printf("check: %-24s %s\n", name, (rc == 0) ? "OK" : "FAIL");
+
+	if (rc != 0) {
+
+		chk.fail_N++;
+	}
+}
+
+static int
+check_shell()
+{
+	const char	*reply;
+
+	reply = check_exec("ap_version");
+
+	if (reply == NULL || strstr(reply, "(OK)") == NULL)
+		return -1;
+
+	return 0;
+}
+
+/* Bulk frames are encoded the same way as pgui does (see pgui/link.c) to
+ * make sure that both sides agree on CRC and base64 of any frame length.
+ * */
+static const char	check_base64_alpha[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+				"abcdefghijklmnopqrstuvwxyz0123456789-_";
+
+static unsigned long
+check_crc32(const unsigned char *raw, int len)
+{
+	unsigned long		crc32 = 0xFFFFFFFFUL;
+	int			N;
+
+	while (len > 0) {
+
+		crc32 ^= *raw++;
+
+		for (N = 0; N < 8; ++N) {
+
+			crc32 = (crc32 & 1UL) ? (crc32 >> 1) ^ 0xEDB88320UL
+				: (crc32 >> 1);
+		}
+
+		--len;
+	}
+
+	return crc32 ^ 0xFFFFFFFFUL;
+}
+
+static void
+check_base64_encode(char *s, const unsigned char *raw, int len)
+{
+	unsigned long		bits = 0UL;
+	int			n = 0;
+
+	while (len > 0) {
+
+		bits = (bits << 8) | *raw++;
+		n += 8;
+
+		while (n >= 6) {
+
+			n -= 6;
+			*s++ = check_base64_alpha[(bits >> n) & 0x3FUL];
+		}
+
+		--len;
+	}
+
+	if (n > 0) {
+
+		*s++ = check_base64_alpha[(bits << (6 - n)) & 0x3FUL];
+	}
+
+	*s = 0;
+}
+
+static int
+check_base64_decode(unsigned char *raw, const char *s, int max)
+{
+	const char		*p;
+	unsigned long		bits = 0UL;
+	int			len = 0, n = 0;
+
+	while (*s != 0 && *s != '\r' && *s != '\n') {
+
+		p = strchr(check_base64_alpha, *s);
+
+		if (p == NULL || len >= max)
+			return -1;
+
+		bits = (bits << 6) | (unsigned long) (p - check_base64_alpha);
+		n += 6;
+
+		if (n >= 8) {
+
+			n -= 8;
+			raw[len++] = (unsigned char) (bits >> n);
+		}
+
+		++s;
+	}
+
+	return len;
+}
+
+static unsigned long
+check_le32(const unsigned char *raw)
+{
+	return    (unsigned long) raw[0]
+		| (unsigned long) raw[1] << 8
+		| (unsigned long) raw[2] << 16
+		| (unsigned long) raw[3] << 24;
+}
+
+static void
+check_put_le32(unsigned char *raw, unsigned long x)
+{
+	raw[0] = (unsigned char) (x);
+	raw[1] = (unsigned char) (x >> 8);
+	raw[2] = (unsigned char) (x >> 16);
+	raw[3] = (unsigned char) (x >> 24);
+}
+
+static unsigned long
+check_float_bits(float x)
+{
+	union {
+		float		f;
+		unsigned int	i;
+	}
+	u = { x };
+
+	return (unsigned long) u.i;
+}
+
+static int
+check_reg_ID(const char *name)
+{
+	const char	*reply, *sp;
+	char		cmd[80];
+	int		reg_ID;
+
+	sprintf(cmd, "reg %s", name);
+
+	reply = check_exec(cmd);
+
+	if (reply == NULL)
+		return -1;
+
+	sp = strchr(reply, '[');
+
+	if (sp == NULL || sscanf(sp, "[%i]", &reg_ID) != 1)
+		return -1;
+
+	return reg_ID;
+}
+
+static int
+check_bulk_frame(unsigned char *raw, int len, unsigned char *reply_raw)
+{
+	const char	*reply, *sp;
+	char		text[CHECK_BULK_FRAME * 2], cmd[CHECK_BULK_FRAME * 3];
+	int		reply_len, total = 0;
+
+	check_put_le32(raw + len, check_crc32(raw, len));
+	check_base64_encode(text, raw, len + 4);
+
+	sprintf(cmd, "reg_bulk %s", text);
+
+	reply = check_exec(cmd);
+
+	if (reply == NULL)
+		return -1;
+
+	/* Collect all of the reply lines into one entry array.
+	 * */
+	while ((sp = strchr(reply, '$')) != NULL) {
+
+		reply_len = check_base64_decode(reply_raw + total, sp + 1,
+				CHECK_BULK_FRAME - total);
+
+		if (reply_len < 4)
+			return -1;
+
+		reply_len -= 4;
+
+		if (		check_le32(reply_raw + total + reply_len)
+				!= check_crc32(reply_raw + total, reply_len))
+			return -1;
+
+		total += reply_len;
+		reply = sp + 1;
+	}
+
+	return (strstr(chk.reply, "Unable") != NULL) ? -1 : total;
+}
+
+static int
+check_bulk()
+{
+	unsigned char	raw[CHECK_BULK_FRAME], reply_raw[CHECK_BULK_FRAME];
+	char		text[CHECK_BULK_FRAME * 2], cmd[CHECK_BULK_FRAME * 3];
+	const char	*reply;
+	int		damping_ID, maximal_ID, len;
+
+	damping_ID = check_reg_ID("pm.s_damping");
+	maximal_ID = check_reg_ID("pm.i_maximal");
+
+	if (damping_ID < 0 || maximal_ID < 0)
+		return -1;
+
+	/* Read two registers by list. This is an odd length frame.
+	 * */
+	raw[0] = 'L';
+	raw[1] = (unsigned char) (damping_ID);
+	raw[2] = (unsigned char) (damping_ID >> 8);
+	raw[3] = (unsigned char) (maximal_ID);
+	raw[4] = (unsigned char) (maximal_ID >> 8);
+
+	len = check_bulk_frame(raw, 5, reply_raw);
+
+	if (		len != 16
+			|| (reply_raw[0] | reply_raw[1] << 8) != damping_ID
+			|| (reply_raw[8] | reply_raw[9] << 8) != maximal_ID
+			|| check_le32(reply_raw + 4) != check_float_bits(100.f))
+		return -1;
+
+	/* Write one register. The value goes through register proc so we
+	 * check it back in text.
+	 * */
+	raw[0] = 'W';
+	raw[1] = (unsigned char) (damping_ID);
+	raw[2] = (unsigned char) (damping_ID >> 8);
+
+	check_put_le32(raw + 3, check_float_bits(120.f));
+
+	len = check_bulk_frame(raw, 7, reply_raw);
+
+	if (		len != 8
+			|| (reply_raw[0] | reply_raw[1] << 8) != damping_ID)
+		return -1;
+
+	reply = check_exec("reg pm.s_damping");
+
+	if (reply == NULL || strstr(reply, "= 120.0") == NULL)
+		return -1;
+
+	/* Frame with broken CRC must be rejected.
+	 * */
+	raw[0] = 'L';
+
+	check_put_le32(raw + 3, 0UL);
+	check_base64_encode(text, raw, 7);
+
+	sprintf(cmd, "reg_bulk %s", text);
+
+	reply = check_exec(cmd);
+
+	if (reply == NULL || strstr(reply, "Unable") == NULL)
+		return -1;
+
+	check_exec("reg pm.s_damping 100");
+
+	return 0;
+}
+
+static int
+check_restart()
+{
+	check_stop();
+
+	if (check_start() != 0)
+		return -1;
+
+	return (check_exec("") != NULL) ? 0 : -1;
+}
+
+static int
+check_reg_value(const char *name, const char *value)
+{
+	const char	*reply;
+	char		cmd[80], match[80];
+
+	sprintf(cmd, "reg %s", name);
+	sprintf(match, "%s = %s", name, value);
+
+	reply = check_exec(cmd);
+
+	return (reply != NULL && strstr(reply, match) != NULL) ? 0 : -1;
+}
+
+static int
+check_reg_set(const char *name, const char *value)
+{
+	char		cmd[80];
+
+	sprintf(cmd, "reg %s %s", name, value);
+
+	return (check_exec(cmd) != NULL) ? check_reg_value(name, value) : -1;
+}
+
+static unsigned long
+check_sym_hash(const char *sym)
+{
+	unsigned long	hash = 2166136261UL;
+
+	while (*sym != 0) {
+
+		hash = ((hash ^ (unsigned char) *sym++) * 16777619UL) & 0xFFFFFFFFUL;
+	}
+
+	return hash;
+}
+
+static int
+check_flash_block_hack()
+{
+	unsigned char	*block, *lhash, *damping, *maximal;
+	FILE		*fd;
+	long		offset, found = -1L;
+	unsigned long	number, found_number = 0UL, count, N;
+
+	block = malloc(CHECK_BLOCK_SIZE);
+
+	fd = fopen(CHECK_FLASH, "r+b");
+
+	if (block == NULL || fd == NULL) {
+
+		free(block);
+		return -1;
+	}
+
+	/* Find the last valid config block.
+	 * */
+	for (offset = 0L; fread(block, CHECK_BLOCK_SIZE, 1, fd) == 1;
+			offset += CHECK_BLOCK_SIZE) {
+
+		number = check_le32(block);
+
+		if (		check_le32(block + 4) == CHECK_BLOCK_MAGIC
+				&& check_le32(block + CHECK_BLOCK_SIZE - 4)
+				== check_crc32(block, CHECK_BLOCK_SIZE - 4)
+				&& (found < 0L || number > found_number)) {
+
+			found = offset;
+			found_number = number;
+		}
+	}
+
+	if (found >= 0L) {
+
+		fseek(fd, found, SEEK_SET);
+
+		if (fread(block, CHECK_BLOCK_SIZE, 1, fd) != 1)
+			found = -1L;
+	}
+
+	if (found >= 0L) {
+
+		/* Break the layout hash and swap the name hashes of two
+		 * registers so we see that values are loaded by names.
+		 * */
+		count = check_le32(block + 4 + 8);
+		lhash = block + 4 + (CHECK_BLOCK_HEAD + count) * 4;
+
+		damping = NULL;
+		maximal = NULL;
+
+		for (N = 0; N < count; ++N) {
+
+			if (check_le32(lhash + N * 4) == check_sym_hash("pm.s_damping"))
+				damping = lhash + N * 4;
+
+			if (check_le32(lhash + N * 4) == check_sym_hash("pm.i_maximal"))
+				maximal = lhash + N * 4;
+		}
+
+		if (damping == NULL || maximal == NULL) {
+
+			fclose(fd);
+			free(block);
+
+			return -1;
+		}
+
+		check_put_le32(block + 4 + 4, check_le32(block + 4 + 4) ^ 1UL);
+		check_put_le32(damping, check_sym_hash("pm.i_maximal"));
+		check_put_le32(maximal, check_sym_hash("pm.s_damping"));
+
+		check_put_le32(block + CHECK_BLOCK_SIZE - 4,
+				check_crc32(block, CHECK_BLOCK_SIZE - 4));
+
+		fseek(fd, found, SEEK_SET);
+
+		if (fwrite(block, CHECK_BLOCK_SIZE, 1, fd) != 1)
+			found = -1L;
+	}
+
+	fclose(fd);
+	free(block);
+
+	return (found >= 0L) ? 0 : -1;
+}
+
+static int
+check_flash()
+{
+	const char	*reply;
+
+	if (		check_reg_set("pm.s_damping", "150.0") != 0
+			|| check_reg_set("pm.i_maximal", "90.000") != 0)
+		return -1;
+
+	reply = check_exec("flash_prog");
+
+	if (reply == NULL || strstr(reply, "Done") == NULL)
+		return -1;
+
+	if (		check_reg_set("pm.s_damping", "80.0") != 0
+			|| check_reg_set("pm.i_maximal", "50.000") != 0)
+		return -1;
+
+	/* Configuration is loaded from packed values on startup.
+	 * */
+	if (		check_restart() != 0
+			|| check_reg_value("pm.s_damping", "150.0") != 0
+			|| check_reg_value("pm.i_maximal", "90.000") != 0)
+		return -1;
+
+	check_stop();
+
+	if (check_flash_block_hack() != 0)
+		return -1;
+
+	/* Register layout does not match so values are loaded by name hashes.
+	 * Raw values are swapped as we swapped the hashes, damping is kept as
+	 * a fraction.
+	 * */
+	if (		check_restart() != 0
+			|| check_reg_value("pm.s_damping", "9000.0") != 0
+			|| check_reg_value("pm.i_maximal", "1.500") != 0)
+		return -1;
+
+	return 0;
+}
+
+static int
+check_profile_store(int profile, const char *name)
+{
+	const char	*reply;
+	char		cmd[80];
+
+	sprintf(cmd, "flash_profile_store %i %s", profile, name);
+
+	reply = check_exec(cmd);
+
+	return (reply != NULL && strstr(reply, "Done") != NULL) ? 0 : -1;
+}
+
+static int
+check_profile()
+{
+	const char	*reply;
+	int		N;
+
+	if (		check_reg_set("hal.PWM_frequency", "40000.0") != 0
+			|| check_profile_store(1, "fast") != 0
+			|| check_reg_set("hal.USART_baudrate", "57600") != 0
+			|| check_profile_store(2, "slow") != 0
+			|| check_reg_set("hal.PWM_frequency", "30000.0") != 0
+			|| check_reg_value("pm.dc_resolution", "2800") != 0)
+		return -1;
+
+	/* Profile values are applied through register procs so the PWM
+	 * resolution follows the loaded frequency.
+	 * */
+	reply = check_exec("flash_profile_load 1");
+
+	if (		reply == NULL
+			|| strstr(reply, "registers changed") == NULL
+			|| check_reg_value("hal.PWM_frequency", "40000.0") != 0
+			|| check_reg_value("pm.dc_resolution", "2100") != 0)
+		return -1;
+
+	if (check_reg_set("hal.USART_baudrate", "115200") != 0)
+		return -1;
+
+	reply = check_exec("flash_profile_load 2");
+
+	if (		reply == NULL
+			|| strstr(reply, "hal.USART_baudrate takes effect"
+				" after reboot") == NULL
+			|| check_reg_value("hal.USART_baudrate", "57600") != 0)
+		return -1;
+
+	/* Write enough blocks to wrap all flash sectors a few times. Other
+	 * profiles must be kept in flash.
+	 * */
+	for (N = 0; N < 40; ++N) {
+
+		reply = check_exec("flash_prog");
+
+		if (reply == NULL || strstr(reply, "Done") == NULL)
+			return -1;
+	}
+
+	reply = check_exec("flash_profile_list");
+
+	if (		reply == NULL
+			|| strstr(reply, "fast") == NULL
+			|| strstr(reply, "slow") == NULL)
+		return -1;
+
+	reply = check_exec("flash_profile_load 1");
+
+	if (		reply == NULL
+			|| check_reg_value("hal.PWM_frequency", "40000.0") != 0
+			|| check_reg_value("pm.dc_resolution", "2100") != 0)
+		return -1;
+
+	return 0;
+}
+
+static int
+check_tlm_wait()
+{
+	const char	*reply;
+	double		tEND;
+
+	tEND = check_clock() + CHECK_TIMEOUT;
+
+	do {
+		reply = check_exec("reg tlm.mode");
+
+		if (reply == NULL)
+			return -1;
+
+		if (strstr(reply, "TLM_MODE_DISABLED") != NULL)
+			return 0;
+
+		usleep(10000);
+	}
+	while (check_clock() < tEND);
+
+	return -1;
+}
+
+static int
+check_tlm_flush(double *time, double *value, int max)
+{
+	const char	*reply, *line, *eol, *last;
+	int		row_N = 0;
+
+	reply = check_exec("tlm_flush_sync");
+
+	if (		reply == NULL
+			|| strncmp(reply, "time@s;", 7) != 0
+			|| strstr(reply, ";pm.s_damping@") == NULL)
+		return -1;
+
+	/* We take the time and the last column of each row.
+	 * */
+	line = strstr(reply, "\r\n");
+
+	while (line != NULL) {
+
+		line += 2;
+		eol = strstr(line, "\r\n");
+
+		if (eol == NULL || eol == line)
+			break;
+
+		if (eol[-1] != ';' || row_N >= max)
+			return -1;
+
+		for (last = eol - 1; last > line && last[-1] != ';'; --last) ;
+
+		time[row_N] = strtod(line, NULL);
+		value[row_N] = strtod(last, NULL);
+
+		row_N++;
+
+		line = eol;
+	}
+
+	return row_N;
+}
+
+static int
+check_tlm_setup()
+{
+	/* Tested register goes to the last column with the largest divider
+	 * and half packing. Another register is decimated less.
+	 * */
+	if (		check_exec("tlm_default") == NULL
+			|| check_reg_set("pm.s_damping", "100.0") != 0
+			|| check_exec("reg tlm.reg_ID19 pm.s_damping") == NULL
+			|| check_reg_set("tlm.reg_div19", "64") != 0
+			|| check_reg_set("tlm.reg_pack19", "1") != 0
+			|| check_reg_set("tlm.reg_div0", "8") != 0
+			|| check_reg_set("tlm.reg_pack0", "1") != 0)
+		return -1;
+
+	return 0;
+}
+
+static int
+check_tlm_grab()
+{
+	static double	time[CHECK_TLM_ROWS], value[CHECK_TLM_ROWS];
+	int		N, row_N;
+
+	if (		check_tlm_setup() != 0
+			|| check_exec("tlm_grab") == NULL
+			|| check_tlm_wait() != 0)
+		return -1;
+
+	row_N = check_tlm_flush(time, value, CHECK_TLM_ROWS);
+
+	/* Memory length is a multiple of the largest divider.
+	 * */
+	if (row_N < 64 || (row_N & 63) != 0)
+		return -1;
+
+	for (N = 0; N < row_N; ++N) {
+
+		if (		value[N] != 100.
+				|| (N > 0 && time[N] <= time[N - 1]))
+			return -1;
+	}
+
+	return 0;
+}
+
+static int
+check_tlm_trigger()
+{
+	static double	time[CHECK_TLM_ROWS], value[CHECK_TLM_ROWS];
+	const char	*reply;
+	int		N, row_N;
+
+	if (		check_tlm_setup() != 0
+			|| check_exec("reg tlm.trig_reg_ID pm.s_damping") == NULL
+			|| check_reg_set("tlm.trig_MODE", "0") != 0
+			|| check_reg_set("tlm.trig_level", "110") != 0
+			|| check_reg_set("tlm.trig_pre", "50.0") != 0
+			|| check_exec("tlm_trigger") == NULL)
+		return -1;
+
+	/* Let the memory wrap a few times before the trigger fires.
+	 * */
+	usleep(200000);
+
+	reply = check_exec("reg tlm.mode");
+
+	if (		reply == NULL
+			|| strstr(reply, "TLM_MODE_TRIGGER") == NULL
+			|| check_reg_set("pm.s_damping", "120.0") != 0
+			|| check_tlm_wait() != 0)
+		return -1;
+
+	row_N = check_tlm_flush(time, value, CHECK_TLM_ROWS);
+
+	if (row_N < 64 || time[0] >= 0. || time[row_N - 1] <= 0.)
+		return -1;
+
+	/* No row before the trigger may show the value that was set after.
+	 * */
+	for (N = 0; N < row_N; ++N) {
+
+		if (		(time[N] < 0. && value[N] != 100.)
+				|| (N > 0 && time[N] <= time[N - 1]))
+			return -1;
+	}
+
+	if (value[row_N - 1] != 120.)
+		return -1;
+
+	check_exec("tlm_default");
+	check_exec("reg pm.s_damping 100");
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2) {
+
+		fprintf(stderr, "Usage: %s <sil>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	chk.target = argv[1];
+	chk.fd = -1;
+
+	/* We start from erased flash each time.
+	 * */
+	unlink(CHECK_FLASH);
+
+	if (check_start() != 0)
+		return EXIT_FAILURE;
+
+	if (check_exec("") == NULL) {
+
+		fprintf(stderr, "check: no shell prompt\n");
+
+		check_stop();
+		return EXIT_FAILURE;
+	}
+
+	check_result("shell", check_shell());
+	check_result("reg_bulk", check_bulk());
+	check_result("flash", check_flash());
+	check_result("profile", check_profile());
+	check_result("tlm_grab", check_tlm_grab());
+	check_result("tlm_trigger", check_tlm_trigger());
+
+	check_stop();
+
+	unlink(CHECK_FLASH);
+
+	return (chk.fail_N == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
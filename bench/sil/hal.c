@@ -0,0 +1,713 @@
+#include <stddef.h>
+
+#include "hal/hal.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "phobia/pm.h"
+
+#include "../blm.h"
+#include "sil.h"
+
+#define HAL_FLAG_SIGNATURE	0x2A7CEA64U
+#define HAL_LOG_INC(np)		(((np) < sizeof(log.text) - 1U) ? (np) + 1 : 0)
+
+/* We keep the firmware image of 16K at the beginning of flash to make
+ * CRC32 check work as usual.
+ * */
+#define SIL_IMAGE_SIZE		0x4000U
+
+/* How long we wait for firmware tasks to get idle in fast mode (Second).
+ * */
+#define SIL_IDLE_TIMEOUT	0.01
+
+#define SIL_UID			0x51A0B5E3U
+
+uint32_t			clock_cpu_hz;
+
+HAL_t				hal;
+LOG_t				log		LD_NOINIT;
+
+const fw_info_t			fw = {
+
+	SIL_FLASH_BASE,
+	SIL_FLASH_BASE + SIL_IMAGE_SIZE,
+
+	_HW_REV, __DATE__
+};
+
+#if defined(HW_MCU_STM32F405)
+
+const FLASH_config_t	FLASH_config = {
+
+	.begin = 8,
+	.total = 4,
+
+	.flash = 0x08000000U,
+
+	.map = {
+
+		0x08080000U,
+		0x080A0000U,
+		0x080C0000U,
+		0x080E0000U,
+		0x08100000U,
+		0x08100000U
+	}
+};
+
+#elif defined(HW_MCU_STM32F722)
+
+const FLASH_config_t	FLASH_config = {
+
+	.begin = 6,
+	.total = 2,
+
+	.flash = 0x08000000U,
+
+	.map = {
+
+		0x08040000U,
+		0x08060000U,
+		0x08080000U,
+		0x08080000U,
+		0x08080000U,
+		0x08080000U
+	}
+};
+
+#endif /* HW_MCU_STM32Fx */
+
+typedef struct {
+
+	int		ADC_enabled;
+
+	uint32_t	GPIO_ODR[8];
+
+	QueueHandle_t	USART_rx_queue;
+	QueueHandle_t	USART_tx_queue;
+	float		USART_budget;
+
+	int		SPI_enabled[3];
+
+	uint32_t	RNG_state;
+
+	double		tick_time;
+}
+priv_SIL_t;
+
+static priv_SIL_t		priv_SIL;
+
+/* Plant model instead of a real machine.
+ * */
+static blm_t			m;
+
+static void
+sil_ADC_IRQ()
+{
+	double		wall;
+
+	hal.ADC_current_A = m.analog_iA;
+	hal.ADC_current_B = m.analog_iB;
+	hal.ADC_current_C = m.analog_iC;
+	hal.ADC_voltage_U = m.analog_uS;
+	hal.ADC_voltage_A = m.analog_uA;
+	hal.ADC_voltage_B = m.analog_uB;
+	hal.ADC_voltage_C = m.analog_uC;
+
+	/* Interrupt takes no simulated time so we report the host time spent
+	 * in ADC_IRQ as the only load.
+	 * */
+	hal.CNT_diag[0] = 0.f;
+	hal.CNT_diag[1] = 0.f;
+
+	wall = sil_clock();
+
+	ADC_IRQ();
+
+	hal.CNT_diag[2] = (float) (sil_clock() - wall);
+}
+
+static void
+sil_USART_IRQ()
+{
+	BaseType_t		xWoken = pdFALSE;
+	char			xbuf[64];
+	int			N, len, rxlen;
+
+	if (priv_SIL.USART_rx_queue == NULL)
+		return ;
+
+	/* We transfer the number of bytes that goes through the wire at
+	 * configured baudrate.
+	 * */
+	priv_SIL.USART_budget += (float) hal.USART_baudrate
+		/ (float) (10 * configTICK_RATE_HZ);
+
+	len = (int) priv_SIL.USART_budget;
+	len = (len < sizeof(xbuf)) ? len : sizeof(xbuf);
+
+	priv_SIL.USART_budget -= (float) len;
+	priv_SIL.USART_budget = (priv_SIL.USART_budget < 1.f)
+		? priv_SIL.USART_budget : 1.f;
+
+	rxlen = sil_tty_read(xbuf, len);
+
+	for (N = 0; N < rxlen; ++N) {
+
+		xQueueSendToBackFromISR(priv_SIL.USART_rx_queue, &xbuf[N], &xWoken);
+	}
+
+	for (N = 0; N < len; ++N) {
+
+		if (xQueueReceiveFromISR(priv_SIL.USART_tx_queue,
+					&xbuf[N], &xWoken) != pdTRUE)
+			break;
+	}
+
+	if (N != 0) {
+
+		sil_tty_write(xbuf, N);
+	}
+
+	portYIELD_FROM_ISR(xWoken);
+}
+
+void sil_plant_loop()
+{
+	double			wall_begin;
+	int			tick_FLAG;
+
+	wall_begin = sil_clock();
+
+	do {
+		sil_irq_enter();
+
+		/* Plant model update for one PWM cycle.
+		 * */
+		blm_update(&m);
+
+		if (priv_SIL.ADC_enabled != 0) {
+
+			sil_ADC_IRQ();
+		}
+
+		tick_FLAG = 0;
+
+		if (m.time >= priv_SIL.tick_time) {
+
+			priv_SIL.tick_time += 1. / (double) configTICK_RATE_HZ;
+
+			sil_irq_tick();
+			sil_USART_IRQ();
+
+			tick_FLAG = 1;
+		}
+
+		sil_irq_leave();
+
+		if (tick_FLAG != 0) {
+
+			if (		sil.time_limit > 0.
+					&& m.time >= sil.time_limit) {
+
+				sil_exit(0);
+			}
+
+			if (sil.fast != 0) {
+
+				sil_cpu_wait_idle(SIL_IDLE_TIMEOUT);
+			}
+			else {
+				sil_sleep_until(wall_begin + m.time);
+			}
+		}
+	}
+	while (1);
+}
+
+static void
+flash_verify()
+{
+	uint32_t		crc32;
+
+	if (* (const uint32_t *) fw.ld_crc32 == 0xFFFFFFFFU) {
+
+		crc32 = crc32u((const void *) fw.ld_begin, fw.ld_crc32 - fw.ld_begin);
+
+		/* Update flash CRC32.
+		 * */
+		FLASH_prog_u32((uint32_t *) fw.ld_crc32, crc32);
+	}
+
+	crc32 = crc32u((const void *) fw.ld_begin, fw.ld_crc32 - fw.ld_begin);
+
+	if (* (const uint32_t *) fw.ld_crc32 != crc32) {
+
+		log_TRACE("Flash CRC32 does not match" EOL);
+	}
+}
+
+void sil_hal_main()
+{
+	hal_bootload();
+	hal_startup();
+
+	app_MAIN();
+}
+
+void hal_bootload() { }
+
+void hal_startup()
+{
+#if defined(HW_MCU_STM32F405)
+	hal.MCU_ID = MCU_ID_STM32F405;
+#elif defined(HW_MCU_STM32F722)
+	hal.MCU_ID = MCU_ID_STM32F722;
+#endif /* HW_MCU_STM32Fx */
+
+	clock_cpu_hz = SIL_CLOCK_HZ;
+
+	blm_enable(&m);
+	blm_restart(&m);
+
+	m.pwm_Z = BLM_Z_DETACHED;
+
+	priv_SIL.tick_time = m.time;
+
+	flash_verify();
+}
+
+int hal_lock_irq()
+{
+	vPortEnterCritical();
+
+	return 0;
+}
+
+void hal_unlock_irq(int irq)
+{
+	vPortExitCritical();
+}
+
+void hal_system_reset()
+{
+	sil_reset();
+}
+
+void hal_bootload_reset()
+{
+	log_TRACE("No bootloader in SIL" EOL);
+
+	sil_reset();
+}
+
+void hal_cpu_sleep()
+{
+	sil_cpu_sleep();
+}
+
+void hal_memory_fence()
+{
+	__sync_synchronize();
+}
+
+int log_status()
+{
+	return (	log.boot_FLAG == HAL_FLAG_SIGNATURE
+			&& log.text_wp != log.text_rp) ? HAL_FAULT : HAL_OK;
+}
+
+void log_bootup()
+{
+	if (log.boot_FLAG != HAL_FLAG_SIGNATURE) {
+
+		log.boot_FLAG = HAL_FLAG_SIGNATURE;
+		log.boot_COUNT = 0U;
+
+		log.text_wp = 0;
+		log.text_rp = 0;
+	}
+	else {
+		log.boot_COUNT += 1U;
+	}
+}
+
+void log_putc(int c)
+{
+	if (unlikely(log.boot_FLAG != HAL_FLAG_SIGNATURE)) {
+
+		log.boot_FLAG = HAL_FLAG_SIGNATURE;
+		log.boot_COUNT = 0U;
+
+		log.text_wp = 0;
+		log.text_rp = 0;
+	}
+
+	log.text[log.text_wp] = (char) c;
+
+	log.text_wp = HAL_LOG_INC(log.text_wp);
+	log.text_rp = (log.text_rp == log.text_wp)
+		? HAL_LOG_INC(log.text_rp) : log.text_rp;
+}
+
+void log_flush()
+{
+	int		rp, wp;
+
+	if (log.boot_FLAG == HAL_FLAG_SIGNATURE) {
+
+		rp = log.text_rp;
+		wp = log.text_wp;
+
+		while (rp != wp) {
+
+			putc(log.text[rp]);
+
+			rp = HAL_LOG_INC(rp);
+		}
+
+		puts(EOL);
+	}
+}
+
+void log_clean()
+{
+	if (log.boot_FLAG == HAL_FLAG_SIGNATURE) {
+
+		log.text_wp = 0;
+		log.text_rp = 0;
+	}
+}
+
+void DBGMCU_mode_stop() { }
+
+void ADC_const_build()
+{
+	float			U_reference, R_equivalent;
+
+	U_reference = hal.ADC_reference_voltage / (float) ADC_RESOLUTION;
+	R_equivalent = hal.ADC_shunt_resistance * hal.ADC_amplifier_gain;
+
+	hal.const_ADC.GA = U_reference / R_equivalent;
+	hal.const_ADC.GU = U_reference / hal.ADC_voltage_ratio;
+	hal.const_ADC.GT = U_reference / hal.ADC_terminal_ratio;
+	hal.const_ADC.GS = hal.ADC_reference_voltage / (float) ADC_RESOLUTION;
+	hal.const_ADC.TS[1] = 0.323f;
+	hal.const_ADC.TS[0] = -279.f;
+
+#ifdef HW_HAVE_ANALOG_KNOB
+	hal.const_ADC.GK = 1.f / hal.ADC_knob_ratio;
+#endif /* HW_HAVE_ANALOG_KNOB */
+
+	hal.const_CNT[0] = 1.f / (float) CLOCK_TIM1_HZ;
+	hal.const_CNT[1] = 1.f / (float) CLOCK_TIM7_HZ;
+
+	/* Plant ADC has the same range as the board.
+	 * */
+	m.range_A = hal.const_ADC.GA * (float) (ADC_RESOLUTION / 2);
+	m.range_B = hal.const_ADC.GU * (float) ADC_RESOLUTION;
+}
+
+void ADC_startup()
+{
+	ADC_const_build();
+
+	priv_SIL.ADC_enabled = 1;
+}
+
+float ADC_get_sample(int xGPIO)
+{
+	int			xCH = XGPIO_GET_CH(xGPIO);
+	float			um = 0.f;
+
+	if (xCH == XGPIO_GET_CH(GPIO_ADC_TEMPINT)) {
+
+		um = 35.f;
+	}
+	else if (xCH == XGPIO_GET_CH(GPIO_ADC_VREFINT)) {
+
+		um = 1.21f;
+	}
+#ifdef GPIO_ADC_NTC_PCB
+	else if (xCH == XGPIO_GET_CH(GPIO_ADC_NTC_PCB)) {
+
+		/* NTC is at balance that is about 25 (C).
+		 * */
+		um = hal.ADC_reference_voltage / 2.f;
+	}
+#endif /* GPIO_ADC_NTC_PCB */
+
+	return um;
+}
+
+void PWM_startup()
+{
+	PWM_configure();
+}
+
+void PWM_configure()
+{
+	int		resolution;
+
+	resolution = (int) ((float) (CLOCK_TIM1_HZ / 2U) / hal.PWM_frequency + 0.5f);
+
+	hal.PWM_frequency = (float) (CLOCK_TIM1_HZ / 2U) / (float) resolution;
+	hal.PWM_resolution = resolution;
+
+	m.pwm_dT = 1. / (double) hal.PWM_frequency;
+	m.pwm_deadtime = (double) hal.PWM_deadtime * 1.E-9;
+	m.pwm_resolution = resolution;
+}
+
+void PWM_set_DC(int A, int B, int C)
+{
+#ifdef HW_HAVE_PWM_REVERSED
+	m.pwm_A = C;
+	m.pwm_B = B;
+	m.pwm_C = A;
+#else /* HW_HAVE_PWM_REVERSED */
+	m.pwm_A = A;
+	m.pwm_B = B;
+	m.pwm_C = C;
+#endif
+}
+
+void PWM_set_Z(int Z)
+{
+	/* Plant does not support separate legs to be detached.
+	 * */
+	m.pwm_Z = (Z != PM_Z_ABC) ? BLM_Z_NONE : BLM_Z_DETACHED;
+}
+
+int PWM_fault()
+{
+	return HAL_OK;
+}
+
+void GPIO_set_mode_INPUT(int xGPIO) { }
+void GPIO_set_mode_OUTPUT(int xGPIO) { }
+void GPIO_set_mode_ANALOG(int xGPIO) { }
+void GPIO_set_mode_FUNCTION(int xGPIO) { }
+void GPIO_set_mode_PUSH_PULL(int xGPIO) { }
+void GPIO_set_mode_OPEN_DRAIN(int xGPIO) { }
+void GPIO_set_mode_SPEED_LOW(int xGPIO) { }
+void GPIO_set_mode_SPEED_HIGH(int xGPIO) { }
+void GPIO_set_mode_SPEED_FAST(int xGPIO) { }
+void GPIO_set_mode_PULL_NONE(int xGPIO) { }
+void GPIO_set_mode_PULL_UP(int xGPIO) { }
+void GPIO_set_mode_PULL_DOWN(int xGPIO) { }
+
+void GPIO_set_HIGH(int xGPIO)
+{
+	priv_SIL.GPIO_ODR[XGPIO_GET_PORT(xGPIO)] |= (1U << XGPIO_GET_N(xGPIO));
+}
+
+void GPIO_set_LOW(int xGPIO)
+{
+	priv_SIL.GPIO_ODR[XGPIO_GET_PORT(xGPIO)] &= ~(1U << XGPIO_GET_N(xGPIO));
+}
+
+int GPIO_get_STATE(int xGPIO)
+{
+	return (priv_SIL.GPIO_ODR[XGPIO_GET_PORT(xGPIO)]
+			& (1U << XGPIO_GET_N(xGPIO))) ? 1 : 0;
+}
+
+void USART_startup()
+{
+	priv_SIL.USART_rx_queue = xQueueCreate(320, sizeof(char));
+	priv_SIL.USART_tx_queue = xQueueCreate(80, sizeof(char));
+}
+
+int USART_getc()
+{
+	char		xbyte;
+
+	xQueueReceive(priv_SIL.USART_rx_queue, &xbyte, portMAX_DELAY);
+
+	return (int) xbyte;
+}
+
+int USART_poll()
+{
+	return (int) uxQueueMessagesWaiting(priv_SIL.USART_rx_queue);
+}
+
+void USART_putc(int c)
+{
+	char		xbyte = (char) c;
+
+	xQueueSendToBack(priv_SIL.USART_tx_queue, &xbyte, portMAX_DELAY);
+}
+
+void USART_write(const void *b, int len)
+{
+	const char	*xb = (const char *) b;
+
+	for (; len > 0; --len) {
+
+		USART_putc(*xb++);
+	}
+}
+
+QueueHandle_t USART_public_rx_queue() { return priv_SIL.USART_rx_queue; }
+
+#ifdef HW_HAVE_NETWORK_EPCAN
+void CAN_startup() { }
+void CAN_configure() { }
+void CAN_bind_ID(int fs, int mb, int ID, int mask_ID) { }
+
+int CAN_send_msg(const CAN_msg_t *msg)
+{
+	/* There is no other node on the bus.
+	 * */
+	return HAL_OK;
+}
+
+int CAN_errate()
+{
+	return 0;
+}
+#endif /* HW_HAVE_NETWORK_EPCAN */
+
+void *FLASH_erase(uint32_t *flash)
+{
+	int		N;
+
+	for (N = 0; N < FLASH_config.total; ++N) {
+
+		if (		(uint32_t) flash >= FLASH_config.map[N]
+				&& (uint32_t) flash < FLASH_config.map[N + 1]) {
+
+			flash = (void *) FLASH_config.map[N];
+
+			memset(flash, 0xFF, FLASH_config.map[N + 1]
+					- FLASH_config.map[N]);
+			break;
+		}
+	}
+
+	return flash;
+}
+
+void FLASH_prog_u32(uint32_t *flash, uint32_t val)
+{
+	if (		(uint32_t) flash >= FLASH_config.flash
+			&& (uint32_t) flash < FLASH_config.map[FLASH_config.total]) {
+
+		/* Programming can only clear bits.
+		 * */
+		*flash &= val;
+	}
+}
+
+void TIM_startup() { }
+
+void TIM_wait_ns(int ns)
+{
+	/* Peripherals answer immediately so there is nothing to wait.
+	 * */
+}
+
+int TIM_get_CNT()
+{
+	return (int) ((uint32_t) (m.time * (double) CLOCK_TIM7_HZ) & 0xFFFFU);
+}
+
+void RNG_startup()
+{
+	priv_SIL.RNG_state = sil_seed() | 1U;
+}
+
+uint32_t RNG_urand()
+{
+	uint32_t		x = priv_SIL.RNG_state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+
+	priv_SIL.RNG_state = x;
+
+	return x;
+}
+
+uint32_t RNG_make_UID()
+{
+	return SIL_UID;
+}
+
+void WD_startup() { }
+void WD_kick() { }
+
+void DAC_startup(int mode) { }
+void DAC_halt() { }
+void DAC_set_OUT1(int xOUT) { }
+void DAC_set_OUT2(int xOUT) { }
+
+void DPS_startup() { }
+void DPS_configure() { }
+
+int DPS_get_HALL()
+{
+	return m.pulse_HS;
+}
+
+int DPS_get_EP()
+{
+	return m.pulse_EP;
+}
+
+void PPM_startup() { }
+void PPM_configure() { }
+
+float PPM_get_PULSE()
+{
+	return 0.f;
+}
+
+float PPM_get_PERIOD()
+{
+	return 0.f;
+}
+
+#ifdef HW_HAVE_STEP_DIR_KNOB
+void STEP_startup() { }
+void STEP_configure() { }
+
+int STEP_get_POSITION()
+{
+	return 0;
+}
+#endif /* HW_HAVE_STEP_DIR_KNOB */
+
+int SPI_is_halted(int bus)
+{
+	return (priv_SIL.SPI_enabled[bus] == 0) ? HAL_OK : HAL_FAULT;
+}
+
+void SPI_startup(int bus, int freq_hz, int mode)
+{
+	priv_SIL.SPI_enabled[bus] = 1;
+}
+
+void SPI_halt(int bus)
+{
+	priv_SIL.SPI_enabled[bus] = 0;
+}
+
+uint16_t SPI_transfer(int bus, uint16_t txbuf)
+{
+	/* There are no devices on the bus.
+	 * */
+	return 0xFFFFU;
+}
+
+void SPI_transfer_dma(int bus, const uint16_t *txbuf, uint16_t *rxbuf, int len)
+{
+	for (; len > 0; --len) {
+
+		*rxbuf++ = 0xFFFFU;
+	}
+}
+
@@ -0,0 +1,285 @@
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <termios.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "sil.h"
+
+#define SIL_TTY_ENV		"PMC_SIL_TTY"
+
+sil_config_t		sil;
+
+typedef struct {
+
+	int		fd_tty;
+	int		fd_slave;
+
+	char		**argv;
+}
+priv_HOST_t;
+
+static priv_HOST_t		priv_HOST;
+
+void *sil_flash_map(uint32_t base, size_t size, const char *file)
+{
+	struct stat		st;
+	void			*flash;
+	char			erased[4096];
+	int			fd;
+
+	fd = open(file, O_RDWR | O_CREAT, 0644);
+
+	if (fd < 0) {
+
+		fprintf(stderr, "sil: unable to open \"%s\" (%s)\n",
+				file, strerror(errno));
+		return NULL;
+	}
+
+	fstat(fd, &st);
+
+	if (st.st_size < (off_t) size) {
+
+		/* Fresh flash is in erased state.
+		 * */
+		memset(erased, 0xFF, sizeof(erased));
+
+		lseek(fd, st.st_size, SEEK_SET);
+
+		while (st.st_size < (off_t) size) {
+
+			if (write(fd, erased, sizeof(erased)) <= 0)
+				break;
+
+			st.st_size += sizeof(erased);
+		}
+	}
+
+	/* Firmware keeps flash addresses in 32-bit integers so we have to
+	 * map it exactly where it is on MCU.
+	 * */
+	flash = mmap((void *) (uintptr_t) base, size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0);
+
+	close(fd);
+
+	if (flash == MAP_FAILED || flash != (void *) (uintptr_t) base) {
+
+		fprintf(stderr, "sil: unable to map flash at %08x\n", base);
+		return NULL;
+	}
+
+	return flash;
+}
+
+static int
+sil_tty_open()
+{
+	struct termios		tio;
+	const char		*env;
+	int			fd;
+
+	env = getenv(SIL_TTY_ENV);
+
+	if (env != NULL) {
+
+		/* We are restarted by reset and keep the same pty.
+		 * */
+		fd = atoi(env);
+	}
+	else {
+		fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+		if (		fd < 0
+				|| grantpt(fd) != 0
+				|| unlockpt(fd) != 0) {
+
+			fprintf(stderr, "sil: unable to open pty (%s)\n",
+					strerror(errno));
+			return -1;
+		}
+	}
+
+	/* Keep the slave open to make the line raw and to not get EIO on the
+	 * master when nobody is connected.
+	 * */
+	priv_HOST.fd_slave = open(ptsname(fd), O_RDWR | O_NOCTTY);
+
+	if (priv_HOST.fd_slave >= 0) {
+
+		tcgetattr(priv_HOST.fd_slave, &tio);
+		cfmakeraw(&tio);
+		tcsetattr(priv_HOST.fd_slave, TCSANOW, &tio);
+	}
+
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+	fcntl(fd, F_SETFD, 0);
+
+	if (sil.tty_link != NULL) {
+
+		unlink(sil.tty_link);
+
+		if (symlink(ptsname(fd), sil.tty_link) != 0) {
+
+			fprintf(stderr, "sil: unable to link \"%s\" (%s)\n",
+					sil.tty_link, strerror(errno));
+		}
+	}
+
+	fprintf(stderr, "sil: USART on %s", ptsname(fd));
+
+	if (sil.tty_link != NULL) {
+
+		fprintf(stderr, " (%s)", sil.tty_link);
+	}
+
+	fprintf(stderr, "\n");
+
+	return fd;
+}
+
+int sil_tty_read(void *b, int len)
+{
+	int		rc;
+
+	rc = read(priv_HOST.fd_tty, b, len);
+
+	return (rc > 0) ? rc : 0;
+}
+
+int sil_tty_write(const void *b, int len)
+{
+	int		rc;
+
+	/* Data is dropped if the pty buffer is full like it is lost on the
+	 * wire when nobody listens.
+	 * */
+	rc = write(priv_HOST.fd_tty, b, len);
+
+	return (rc > 0) ? rc : 0;
+}
+
+double sil_clock()
+{
+	struct timespec		ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double) ts.tv_sec + (double) ts.tv_nsec * 1E-9;
+}
+
+void sil_sleep_until(double t)
+{
+	struct timespec		ts;
+
+	ts.tv_sec = (time_t) t;
+	ts.tv_nsec = (long) ((t - (double) ts.tv_sec) * 1E+9);
+
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) ;
+}
+
+uint32_t sil_seed()
+{
+	struct timespec		ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+
+	return (uint32_t) ts.tv_nsec ^ (uint32_t) getpid();
+}
+
+void sil_reset()
+{
+	char		env[16];
+
+	/* We restart the process image to get the same effect as MCU reset.
+	 * Flash content is kept in the file.
+	 * */
+	snprintf(env, sizeof(env), "%i", priv_HOST.fd_tty);
+	setenv(SIL_TTY_ENV, env, 1);
+
+	execv("/proc/self/exe", priv_HOST.argv);
+
+	fprintf(stderr, "sil: unable to reset (%s)\n", strerror(errno));
+
+	exit(EXIT_FAILURE);
+}
+
+void sil_exit(int code)
+{
+	if (sil.tty_link != NULL) {
+
+		unlink(sil.tty_link);
+	}
+
+	exit(code);
+}
+
+static void
+sil_usage(const char *name)
+{
+	fprintf(stderr,	"Usage: %s [options]\n"
+			"  -f            run as fast as firmware goes idle\n"
+			"  -t <time>     stop after simulated time (Second)\n"
+			"  -m <file>     flash storage file\n"
+			"  -l <link>     symlink to the USART pty\n", name);
+}
+
+int main(int argc, char *argv[])
+{
+	int		opt;
+
+	priv_HOST.argv = argv;
+
+	sil.fast = 0;
+	sil.time_limit = 0.;
+	sil.flash_file = "/tmp/pmc-sil.flash";
+	sil.tty_link = NULL;
+
+	while ((opt = getopt(argc, argv, "ft:m:l:")) != -1) {
+
+		switch (opt) {
+
+			case 'f':
+				sil.fast = 1;
+				break;
+
+			case 't':
+				sil.time_limit = strtod(optarg, NULL);
+				break;
+
+			case 'm':
+				sil.flash_file = optarg;
+				break;
+
+			case 'l':
+				sil.tty_link = optarg;
+				break;
+
+			default:
+				sil_usage(argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+
+	if (sil_flash_map(SIL_FLASH_BASE, SIL_FLASH_SIZE, sil.flash_file) == NULL)
+		return EXIT_FAILURE;
+
+	priv_HOST.fd_tty = sil_tty_open();
+
+	if (priv_HOST.fd_tty < 0)
+		return EXIT_FAILURE;
+
+	sil_cpu_startup();
+	sil_hal_main();
+
+	return 0;
+}
+
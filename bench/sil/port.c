@@ -0,0 +1,354 @@
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "sil.h"
+
+enum {
+	SIL_THREAD_RUN		= 0,
+	SIL_THREAD_DELETED,
+	SIL_THREAD_KILLED
+};
+
+typedef struct {
+
+	pthread_t		thread;
+	pthread_cond_t		wake;
+
+	TaskFunction_t		pxCode;
+	void			*pvParameters;
+
+	int			state;
+}
+sil_thread_t;
+
+typedef struct {
+
+	/* The CPU is held by the thread that runs the firmware code now.
+	 * */
+	pthread_mutex_t		cpu;
+
+	pthread_cond_t		irq_done;
+	pthread_cond_t		idle;
+
+	volatile int		irq_request;
+	volatile int		yield_pending;
+
+	int			idle_FLAG;
+
+	UBaseType_t		critical_nesting;
+}
+priv_PORT_t;
+
+static priv_PORT_t		priv_PORT = {
+
+	.cpu = PTHREAD_MUTEX_INITIALIZER,
+	.irq_done = PTHREAD_COND_INITIALIZER,
+	.idle = PTHREAD_COND_INITIALIZER
+};
+
+static __thread int		priv_in_ISR;
+
+extern void * volatile		pxCurrentTCB;
+
+static sil_thread_t *
+sil_thread_of(void *pxTCB)
+{
+	StackType_t		*pxTopOfStack;
+
+	/* The first member of TCB is the top of stack where we keep the
+	 * thread pointer.
+	 * */
+	pxTopOfStack = * (StackType_t **) pxTCB;
+
+	return * (sil_thread_t **) pxTopOfStack;
+}
+
+static sil_thread_t *
+sil_thread_current()
+{
+	return (pxCurrentTCB != NULL) ? sil_thread_of(pxCurrentTCB) : NULL;
+}
+
+static void
+sil_thread_exit(sil_thread_t *th)
+{
+	if (th->state == SIL_THREAD_KILLED) {
+
+		pthread_cond_destroy(&th->wake);
+		free(th);
+	}
+
+	/* We must not touch the thread data after we release the CPU as
+	 * it can be freed by the IDLE task.
+	 * */
+	pthread_mutex_unlock(&priv_PORT.cpu);
+	pthread_exit(NULL);
+}
+
+static void
+sil_thread_wait(sil_thread_t *th)
+{
+	while (		sil_thread_current() != th
+			&& th->state == SIL_THREAD_RUN) {
+
+		pthread_cond_wait(&th->wake, &priv_PORT.cpu);
+	}
+
+	if (th->state != SIL_THREAD_RUN) {
+
+		sil_thread_exit(th);
+	}
+}
+
+static void *
+sil_thread_entry(void *arg)
+{
+	sil_thread_t		*th = (sil_thread_t *) arg;
+
+	pthread_mutex_lock(&priv_PORT.cpu);
+
+	sil_thread_wait(th);
+
+	th->pxCode(th->pvParameters);
+
+	/* Task function should never return.
+	 * */
+	vTaskDelete(NULL);
+
+	return NULL;
+}
+
+static void
+sil_task_switch()
+{
+	sil_thread_t		*th, *self;
+
+	self = sil_thread_current();
+
+	priv_PORT.yield_pending = 0;
+
+	vTaskSwitchContext();
+
+	th = sil_thread_current();
+
+	if (th != self) {
+
+		pthread_cond_signal(&th->wake);
+
+		sil_thread_wait(self);
+	}
+}
+
+static void
+sil_irq_point()
+{
+	/* Let the plant thread run interrupts that are pending.
+	 * */
+	while (priv_PORT.irq_request != 0) {
+
+		pthread_cond_wait(&priv_PORT.irq_done, &priv_PORT.cpu);
+	}
+
+	if (priv_PORT.yield_pending != 0) {
+
+		sil_task_switch();
+	}
+}
+
+StackType_t *pxPortInitialiseStack(StackType_t *pxTopOfStack,
+		TaskFunction_t pxCode, void *pvParameters)
+{
+	sil_thread_t		*th;
+	pthread_attr_t		attr;
+
+	th = (sil_thread_t *) calloc(1, sizeof(sil_thread_t));
+
+	if (th == NULL) {
+
+		abort();
+	}
+
+	pthread_cond_init(&th->wake, NULL);
+
+	th->pxCode = pxCode;
+	th->pvParameters = pvParameters;
+	th->state = SIL_THREAD_RUN;
+
+	/* Task stack is not used by the code at all. We only keep the thread
+	 * pointer on top of it.
+	 * */
+	pxTopOfStack = (StackType_t *) (((uintptr_t) pxTopOfStack
+				- sizeof(sil_thread_t *)) & ~(uintptr_t) 7U);
+
+	* (sil_thread_t **) pxTopOfStack = th;
+
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+	if (pthread_create(&th->thread, &attr, &sil_thread_entry, th) != 0) {
+
+		abort();
+	}
+
+	pthread_attr_destroy(&attr);
+
+	return pxTopOfStack;
+}
+
+BaseType_t xPortStartScheduler()
+{
+	pthread_cond_signal(&sil_thread_current()->wake);
+	pthread_mutex_unlock(&priv_PORT.cpu);
+
+	/* The main thread now plays the role of hardware.
+	 * */
+	sil_plant_loop();
+
+	return pdFALSE;
+}
+
+void vPortEndScheduler() { }
+
+void vPortYield()
+{
+	priv_PORT.yield_pending = 1;
+
+	/* Context switch is delayed until the end of critical section
+	 * like PendSV does.
+	 * */
+	if (		priv_in_ISR == 0
+			&& priv_PORT.critical_nesting == 0) {
+
+		sil_irq_point();
+	}
+}
+
+void vPortYieldFromISR()
+{
+	priv_PORT.yield_pending = 1;
+}
+
+void vPortEnterCritical()
+{
+	priv_PORT.critical_nesting++;
+}
+
+void vPortExitCritical()
+{
+	priv_PORT.critical_nesting--;
+
+	if (		priv_PORT.critical_nesting == 0
+			&& priv_in_ISR == 0) {
+
+		sil_irq_point();
+	}
+}
+
+void vPortDeleteThread(void *pxTCB)
+{
+	sil_thread_of(pxTCB)->state = SIL_THREAD_DELETED;
+}
+
+void vPortCleanUpTCB(void *pxTCB)
+{
+	sil_thread_t		*th = sil_thread_of(pxTCB);
+
+	if (th->state == SIL_THREAD_DELETED) {
+
+		/* Thread has already gone.
+		 * */
+		pthread_cond_destroy(&th->wake);
+		free(th);
+	}
+	else {
+		/* Task is deleted by another one so we wake up its thread to
+		 * exit as soon as we release the CPU.
+		 * */
+		th->state = SIL_THREAD_KILLED;
+
+		pthread_cond_signal(&th->wake);
+	}
+}
+
+void sil_cpu_startup()
+{
+	pthread_mutex_lock(&priv_PORT.cpu);
+}
+
+void sil_cpu_sleep()
+{
+	priv_PORT.idle_FLAG = 1;
+
+	pthread_cond_signal(&priv_PORT.idle);
+
+	while (priv_PORT.yield_pending == 0) {
+
+		pthread_cond_wait(&priv_PORT.irq_done, &priv_PORT.cpu);
+	}
+
+	sil_irq_point();
+}
+
+void sil_cpu_wait_idle(double timeout)
+{
+	struct timespec		ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+
+	ts.tv_sec += (time_t) timeout;
+	ts.tv_nsec += (long) ((timeout - (double) (time_t) timeout) * 1E+9);
+
+	if (ts.tv_nsec >= 1000000000L) {
+
+		ts.tv_sec += 1;
+		ts.tv_nsec -= 1000000000L;
+	}
+
+	pthread_mutex_lock(&priv_PORT.cpu);
+
+	while (priv_PORT.idle_FLAG == 0) {
+
+		if (pthread_cond_timedwait(&priv_PORT.idle,
+					&priv_PORT.cpu, &ts) != 0)
+			break;
+	}
+
+	pthread_mutex_unlock(&priv_PORT.cpu);
+}
+
+void sil_irq_enter()
+{
+	__atomic_store_n(&priv_PORT.irq_request, 1, __ATOMIC_SEQ_CST);
+
+	pthread_mutex_lock(&priv_PORT.cpu);
+
+	priv_in_ISR = 1;
+}
+
+void sil_irq_leave()
+{
+	priv_in_ISR = 0;
+
+	if (priv_PORT.yield_pending != 0) {
+
+		priv_PORT.idle_FLAG = 0;
+	}
+
+	__atomic_store_n(&priv_PORT.irq_request, 0, __ATOMIC_SEQ_CST);
+
+	pthread_cond_broadcast(&priv_PORT.irq_done);
+	pthread_mutex_unlock(&priv_PORT.cpu);
+}
+
+void sil_irq_tick()
+{
+	if (xTaskIncrementTick() != pdFALSE) {
+
+		priv_PORT.yield_pending = 1;
+	}
+}
+
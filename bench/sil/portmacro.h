@@ -0,0 +1,76 @@
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+/* This is FreeRTOS port for software-in-the-loop (SIL) build. Each task is
+ * run by its own POSIX thread but only one of them holds the CPU at a time.
+ * Interrupts are emulated by the plant thread that takes the CPU at the
+ * points where the running task calls into the kernel. So the firmware is
+ * never preempted in the middle of arbitrary code and the whole run is
+ * deterministic against the simulated time.
+ * */
+
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE		uint32_t
+#define portBASE_TYPE		long
+#define portPOINTER_SIZE_TYPE	uintptr_t
+
+typedef portSTACK_TYPE		StackType_t;
+typedef long			BaseType_t;
+typedef unsigned long		UBaseType_t;
+typedef uint32_t		TickType_t;
+
+#define portMAX_DELAY			((TickType_t) 0xFFFFFFFFUL)
+#define portTICK_TYPE_IS_ATOMIC		1
+
+#define portSTACK_GROWTH		(-1)
+#define portTICK_PERIOD_MS		((TickType_t) 1000 / configTICK_RATE_HZ)
+#define portBYTE_ALIGNMENT		8
+#define portDONT_DISCARD		__attribute__ ((used))
+
+extern void vPortYield();
+extern void vPortYieldFromISR();
+extern void vPortEnterCritical();
+extern void vPortExitCritical();
+extern void vPortDeleteThread(void *pxTCB);
+extern void vPortCleanUpTCB(void *pxTCB);
+
+#define portYIELD()				vPortYield()
+#define portEND_SWITCHING_ISR(x)		if ((x) != pdFALSE) { vPortYieldFromISR(); }
+#define portYIELD_FROM_ISR(x)			portEND_SWITCHING_ISR(x)
+
+/* The plant thread owns the CPU exclusively while it runs interrupts so
+ * there is nothing to mask.
+ * */
+#define portSET_INTERRUPT_MASK_FROM_ISR()	0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	(void) (x)
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL()			vPortEnterCritical()
+#define portEXIT_CRITICAL()			vPortExitCritical()
+
+#define portPRE_TASK_DELETE_HOOK(pxTCB, pxYield)	vPortDeleteThread(pxTCB)
+#define portCLEAN_UP_TCB(pxTCB)				vPortCleanUpTCB(pxTCB)
+
+#define portTASK_FUNCTION_PROTO(vFunction, pvParameters)	void vFunction(void *pvParameters)
+#define portTASK_FUNCTION(vFunction, pvParameters)		void vFunction(void *pvParameters)
+
+#define portRECORD_READY_PRIORITY(uxPriority, uxReadyPriorities)	\
+					(uxReadyPriorities) |= (1UL << (uxPriority))
+#define portRESET_READY_PRIORITY(uxPriority, uxReadyPriorities)		\
+					(uxReadyPriorities) &= ~(1UL << (uxPriority))
+#define portGET_HIGHEST_PRIORITY(uxTopPriority, uxReadyPriorities)	\
+					uxTopPriority = (31UL - (uint32_t) __builtin_clz((uint32_t) (uxReadyPriorities)))
+
+#define portNOP()
+#define portINLINE			__inline
+#define portFORCE_INLINE		inline __attribute__ ((always_inline))
+#define portMEMORY_BARRIER()		__asm volatile ("" ::: "memory")
+
+#endif /* PORTMACRO_H */
+
@@ -0,0 +1,58 @@
+#ifndef _H_SIL_
+#define _H_SIL_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SIL_FLASH_BASE		0x08000000U
+#define SIL_FLASH_SIZE		0x00100000U
+
+typedef struct {
+
+	/* Run the plant as fast as firmware tasks go idle instead of pacing
+	 * to the wall clock.
+	 * */
+	int		fast;
+
+	/* Stop after this simulated time (Second).
+	 * */
+	double		time_limit;
+
+	const char	*flash_file;
+	const char	*tty_link;
+}
+sil_config_t;
+
+extern sil_config_t		sil;
+
+/* FreeRTOS port (port.c).
+ * */
+void sil_cpu_startup();
+void sil_cpu_sleep();
+void sil_cpu_wait_idle(double timeout);
+
+void sil_irq_enter();
+void sil_irq_leave();
+void sil_irq_tick();
+
+/* Host interface (host.c).
+ * */
+void *sil_flash_map(uint32_t base, size_t size, const char *file);
+
+int sil_tty_read(void *b, int len);
+int sil_tty_write(const void *b, int len);
+
+double sil_clock();
+void sil_sleep_until(double t);
+uint32_t sil_seed();
+
+void sil_reset();
+void sil_exit(int code);
+
+/* HAL (hal.c).
+ * */
+void sil_hal_main();
+void sil_plant_loop();
+
+#endif /* _H_SIL_ */
+
@@ -0,0 +1,406 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+
+#include <unistd.h>
+
+#include "blm.h"
+#include "lfg.h"
+#include "pm.h"
+#include "run.h"
+#include "sweep.h"
+#include "tsfunc.h"
+
+#define SWEEP_FILE		"/tmp/pm-sweep.csv"
+
+#define SWEEP_COLUMN_MAX	40
+
+typedef struct {
+
+	int		N;
+	int		stage;
+
+	double		wS_sum;
+	double		track_sum;
+	double		F_max;
+	long		track_N;
+}
+sweep_t;
+
+static sweep_t		sweep;
+
+enum {
+	SWEEP_STAGE_IDENT	= 0,
+	SWEEP_STAGE_TRACK,
+	SWEEP_STAGE_DONE
+};
+
+static const char	*sweep_column[] = {
+
+	"Rs@Ohm",
+	"Ld@H",
+	"Lq@H",
+	"lambda@Wb",
+	"Jm@kgm2",
+	"Udc@V",
+	"Rdc@Ohm",
+	"Cdc@F",
+	"Mq@k",
+	"tau_A@s",
+	"tau_B@s",
+	"adc_noise@LSB",
+	"deadtime@s",
+	"stage@",
+	"fsm_errno@",
+	"e_Rs@%",
+	"e_Ld@%",
+	"e_Lq@%",
+	"e_lambda@%",
+	"e_Jm@%",
+	"wS_rms@rad/s",
+	"F_max@deg",
+	"track_rms@rad/s",
+	NULL
+};
+
+/* Index of the first column that is summarised in sweep report.
+ * */
+#define SWEEP_COLUMN_STAT	15
+
+void sweep_capture()
+{
+	double		D, Q, A, B, eF;
+
+	if (		sweep.stage != SWEEP_STAGE_TRACK
+			|| pm.lu_MODE < PM_LU_ESTIMATE)
+		return ;
+
+	D = cos(m.state[3]);
+	Q = sin(m.state[3]);
+	A = D * pm.lu_F[0] + Q * pm.lu_F[1];
+	B = D * pm.lu_F[1] - Q * pm.lu_F[0];
+
+	eF = fabs(atan2(B, A)) * (180. / M_PI);
+
+	sweep.F_max = (eF > sweep.F_max) ? eF : sweep.F_max;
+
+	sweep.wS_sum += (pm.lu_wS - m.state[2]) * (pm.lu_wS - m.state[2]);
+	sweep.track_sum += (pm.s_track - m.state[2]) * (pm.s_track - m.state[2]);
+
+	sweep.track_N++;
+}
+
+static double
+sweep_error(double x, double ref)
+{
+	return (ref != 0.) ? 100. * (x - ref) / ref : 0.;
+}
+
+static void
+sweep_result()
+{
+	FILE		*fd;
+	char		file_res[RUN_PATH_MAX];
+	double		y[SWEEP_COLUMN_MAX];
+	int		N;
+
+	/* We get here by exit() so the result is written even if the sample
+	 * has failed in the middle of script.
+	 * */
+	snprintf(file_res, RUN_PATH_MAX, "%s/%02i.res", RUN_DIR, sweep.N);
+
+	fd = fopen(file_res, "w");
+
+	if (fd == NULL)
+		return ;
+
+	y[0] = m.Rs;
+	y[1] = m.Ld;
+	y[2] = m.Lq;
+	y[3] = m.lambda;
+	y[4] = m.Jm;
+	y[5] = m.Udc;
+	y[6] = m.Rdc;
+	y[7] = m.Cdc;
+	y[8] = run.sample[sweep.N].k_Mq;
+	y[9] = m.tau_A;
+	y[10] = m.tau_B;
+	y[11] = m.adc_noise;
+	y[12] = m.pwm_deadtime;
+	y[13] = sweep.stage;
+	y[14] = pm.fsm_errno;
+	y[15] = sweep_error(pm.const_Rs, m.Rs);
+	y[16] = sweep_error(pm.const_im_Ld, m.Ld);
+	y[17] = sweep_error(pm.const_im_Lq, m.Lq);
+	y[18] = sweep_error(pm.const_lambda, m.lambda);
+	y[19] = sweep_error(pm.const_Ja * pm.const_Zp * pm.const_Zp, m.Jm);
+
+	y[20] = (sweep.track_N != 0) ? sqrt(sweep.wS_sum / sweep.track_N) : 0.;
+	y[21] = sweep.F_max;
+	y[22] = (sweep.track_N != 0) ? sqrt(sweep.track_sum / sweep.track_N) : 0.;
+
+	for (N = 0; sweep_column[N] != NULL; ++N) {
+
+		fprintf(fd, "%s%.6E", (N != 0) ? "," : "", y[N]);
+	}
+
+	fprintf(fd, "\n");
+	fclose(fd);
+}
+
+void sweep_worker(int N)
+{
+	const ts_machine_t	*mach = &run.mach[N];
+	const ts_script_t	*ts;
+	const char		*script;
+	int			len;
+
+	sweep.N = N;
+	sweep.stage = SWEEP_STAGE_IDENT;
+
+	m.Mq[1] *= run.sample[N].k_Mq;
+	m.Mq[2] *= run.sample[N].k_Mq;
+	m.Mq[3] *= run.sample[N].k_Mq;
+	m.Cdc *= run.sample[N].k_Cdc;
+	m.tau_A *= run.sample[N].k_tau_A;
+	m.tau_B *= run.sample[N].k_tau_B;
+	m.adc_noise *= run.sample[N].k_adc_noise;
+	m.pwm_deadtime *= run.sample[N].k_deadtime;
+
+	atexit(&sweep_result);
+
+	/* Identification only, then we collect tracking metrics over the
+	 * scripts.
+	 * */
+	ts_script_machine(mach, "");
+
+	sweep.stage = SWEEP_STAGE_TRACK;
+
+	script = (run.script != NULL) ? run.script : mach->script;
+
+	while (*script != 0) {
+
+		len = strcspn(script, ",");
+
+		if (len != 0) {
+
+			ts = ts_script_search(script, len);
+
+			ts->proc();
+			blm_restart(&m);
+		}
+
+		script += (script[len] != 0) ? len + 1 : len;
+	}
+
+	sweep.stage = SWEEP_STAGE_DONE;
+}
+
+static double
+sweep_rand(lfg_t *lfg, double spread)
+{
+	/* Uniform deviate is in range from -1 to +1.
+	 * */
+	return 1. + spread * lfg_urand(lfg);
+}
+
+static void
+sweep_sample()
+{
+	static ts_machine_t	base[RUN_MACHINE_MAX];
+
+	ts_machine_t		*mach;
+	lfg_t			lfg;
+	char			name[80];
+	int			N, N_base;
+
+	lfg_start(&lfg, run.rseed);
+
+	N_base = run.N_mach;
+
+	for (N = 0; N < N_base; ++N) {
+
+		base[N] = run.mach[N];
+	}
+
+	run.N_sample = (run.N_sample < RUN_MACHINE_MAX)
+		? run.N_sample : RUN_MACHINE_MAX;
+
+	/* Each sample is a random deviation from one of the nominal machines
+	 * taken in turn.
+	 * */
+	for (N = 0; N < run.N_sample; ++N) {
+
+		mach = &run.mach[N];
+
+		*mach = base[N % N_base];
+
+		snprintf(name, sizeof(name), "%s #%i", mach->name, N);
+
+		mach->name = strdup(name);
+
+		mach->Rs *= sweep_rand(&lfg, 0.3);
+		mach->Ld *= sweep_rand(&lfg, 0.3);
+		mach->Lq *= sweep_rand(&lfg, 0.3);
+		mach->Udc *= sweep_rand(&lfg, 0.15);
+		mach->Rdc *= sweep_rand(&lfg, 0.5);
+		mach->Kv *= sweep_rand(&lfg, 0.2);
+		mach->Jm *= sweep_rand(&lfg, 0.5);
+
+		run.sample[N].k_Mq = sweep_rand(&lfg, 0.5);
+		run.sample[N].k_Cdc = sweep_rand(&lfg, 0.5);
+		run.sample[N].k_tau_A = sweep_rand(&lfg, 0.3);
+		run.sample[N].k_tau_B = sweep_rand(&lfg, 0.3);
+		run.sample[N].k_adc_noise = sweep_rand(&lfg, 0.75);
+		run.sample[N].k_deadtime = sweep_rand(&lfg, 0.5);
+	}
+
+	run.N_mach = run.N_sample;
+}
+
+static int
+sweep_compare(const void *a, const void *b)
+{
+	double		x = * (const double *) a;
+	double		y = * (const double *) b;
+
+	return (x < y) ? -1 : (x > y) ? 1 : 0;
+}
+
+static void
+sweep_report()
+{
+	static double	y[SWEEP_COLUMN_MAX][RUN_MACHINE_MAX];
+
+	FILE		*fd, *fd_res;
+	char		file_res[RUN_PATH_MAX], line[1000], *p;
+	double		x, mean, std;
+	int		N, K, N_pass, N_col;
+
+	fd = fopen(SWEEP_FILE, "w");
+
+	if (fd == NULL) {
+
+		fprintf(stderr, "fopen: %s\n", strerror(errno));
+		return ;
+	}
+
+	for (N_col = 0; sweep_column[N_col] != NULL; ++N_col) ;
+
+	fprintf(fd, "# rseed = %i\n", run.rseed);
+	fprintf(fd, "N,name,status");
+
+	for (K = 0; K < N_col; ++K) {
+
+		fprintf(fd, ",%s", sweep_column[K]);
+	}
+
+	fprintf(fd, "\n");
+
+	N_pass = 0;
+
+	for (N = 0; N < run.N_mach; ++N) {
+
+		fprintf(fd, "%i,\"%s\",%s", N, run.mach[N].name,
+				(run.job[N].status == 0) ? "PASS" : "FAIL");
+
+		snprintf(file_res, RUN_PATH_MAX, "%s/%02i.res", RUN_DIR, N);
+
+		fd_res = fopen(file_res, "r");
+
+		if (		fd_res != NULL
+				&& fgets(line, sizeof(line), fd_res) != NULL) {
+
+			fprintf(fd, ",%s", line);
+
+			p = line;
+
+			for (K = 0; K < N_col; ++K) {
+
+				x = strtod(p, &p);
+				p += (*p == ',') ? 1 : 0;
+
+				if (run.job[N].status == 0) {
+
+					y[K][N_pass] = x;
+				}
+			}
+
+			N_pass += (run.job[N].status == 0) ? 1 : 0;
+		}
+		else {
+			fprintf(fd, "\n");
+		}
+
+		if (fd_res != NULL) {
+
+			fclose(fd_res);
+		}
+	}
+
+	fclose(fd);
+
+	printf("\n%-16s %10s %10s %10s %10s\n", "sweep", "mean", "std",
+			"p95 |x|", "max |x|");
+
+	for (K = SWEEP_COLUMN_STAT; K < N_col && N_pass != 0; ++K) {
+
+		mean = 0.;
+		std = 0.;
+
+		for (N = 0; N < N_pass; ++N) {
+
+			mean += y[K][N];
+		}
+
+		mean /= N_pass;
+
+		for (N = 0; N < N_pass; ++N) {
+
+			std += (y[K][N] - mean) * (y[K][N] - mean);
+
+			y[K][N] = fabs(y[K][N]);
+		}
+
+		std = sqrt(std / N_pass);
+
+		qsort(y[K], N_pass, sizeof(double), &sweep_compare);
+
+		printf("%-16s %10.3f %10.3f %10.3f %10.3f\n", sweep_column[K],
+				mean, std, y[K][(N_pass * 95) / 100], y[K][N_pass - 1]);
+	}
+
+	printf("%i of %i samples passed, report in %s\n", N_pass,
+			run.N_mach, SWEEP_FILE);
+}
+
+int sweep_script()
+{
+	char		file_res[RUN_PATH_MAX];
+	int		N, rc;
+
+	for (N = 0; N < run.N_mach; ++N) {
+
+		if (ts_script_check((run.script != NULL) ? run.script
+					: run.mach[N].script) != 0)
+			return -1;
+	}
+
+	sweep_sample();
+
+	for (N = 0; N < run.N_mach; ++N) {
+
+		snprintf(file_res, RUN_PATH_MAX, "%s/%02i.res", RUN_DIR, N);
+		unlink(file_res);
+	}
+
+	run.sweep = 1;
+
+	rc = run_parallel();
+
+	sweep_report();
+
+	return rc;
+}
@@ -0,0 +1,10 @@
+#ifndef _H_SWEEP_
+#define _H_SWEEP_
+
+void sweep_capture();
+void sweep_worker(int N);
+
+int sweep_script();
+
+#endif /* _H_SWEEP_ */
+
@@ -0,0 +1,67 @@
+#ifndef _H_TRACE_
+#define _H_TRACE_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pm.h"
+
+/* Feedback trace to replay through the controller on host or on target
+ * model. The file contains the header, the controller state at the start
+ * of the trace and then the sequence of frames.
+ *
+ * Only the part of pmc_t before function pointers is stored so the layout
+ * is the same on 32-bit target and on 64-bit host. The rest of state that
+ * pm_feedback reads follows: the random seed and both LSE instances without
+ * their internal pointers. All the fields are in native byte order.
+ * */
+
+#define TRACE_MAGIC		0x45435254U
+#define TRACE_VERSION		2
+
+#define TRACE_PM_SIZE		offsetof(pmc_t, proc_set_DC)
+
+typedef struct {
+
+	uint32_t	magic;
+	uint32_t	version;
+
+	uint32_t	pm_size;
+	uint32_t	frame_size;
+	uint32_t	frame_N;
+	uint32_t	reserved;
+}
+trace_head_t;
+
+typedef struct {
+
+	int		n_cascades;
+	int		n_len_of_x;
+	int		n_len_of_z;
+	int		n_threshold;
+	int		n_total;
+
+	int		keep[LSE_CASCADE_MAX];
+	int		lazy[LSE_CASCADE_MAX];
+
+	lse_float_t	esv_min;
+	lse_float_t	esv_max;
+
+	lse_float_t	vm[sizeof(((lse_t *) 0)->vm) / sizeof(lse_float_t)];
+}
+trace_lse_t;
+
+typedef struct {
+
+	pmfb_t		fb;
+
+	/* Inputs that script changes between calls.
+	 * */
+	int		fsm_req;
+	float		s_setpoint_speed;
+	float		i_setpoint_current;
+}
+trace_frame_t;
+
+#endif /* _H_TRACE_ */
+
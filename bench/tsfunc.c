@@ -18,6 +18,8 @@
 #define TS_assert_absolute(x, r, a)	TS_assert(fabs((x) - (r)) < fabs(a))
 #define TS_assert_relative(x, r)	TS_assert(fabs((x) - (r)) < TS_TOL * fabs(r))
 
+int				ts_slow_DIV = 1;
+
 int ts_wait_IDLE()
 {
 	int			xTIME = 0;
@@ -449,6 +451,8 @@ void ts_script_default()
 
 	pm_auto(&pm, PM_AUTO_BASIC_DEFAULT);
 	pm_auto(&pm, PM_AUTO_CONFIG_DEFAULT);
+
+	pm.slow_DIV = ts_slow_DIV;
 }
 
 void ts_script_base()
@@ -503,6 +507,100 @@ ts_script_speed()
 	ts_wait_IDLE();
 }
 
+static void
+ts_script_current()
+{
+	float		s_maximal, s_reverse, iSP;
+	int		N;
+
+	s_maximal = pm.s_maximal;
+	s_reverse = pm.s_reverse;
+
+	pm.config_LU_DRIVE = PM_DRIVE_CURRENT;
+	pm.config_CC_BRAKE_STOP = PM_ENABLED;
+	pm.config_CC_SPEED_TRACK = PM_ENABLED;
+
+	pm.s_maximal = 10.f * pm.k_EMAX / 100.f
+		* pm.const_fb_U / pm.const_lambda;
+	pm.s_reverse = pm.s_maximal;
+
+	pm.fsm_req = PM_STATE_LU_STARTUP;
+	ts_wait_IDLE();
+
+	m.unsync_flag = 1;
+
+	iSP = pm.i_maximal * 0.2f;
+
+	/* Integral gain is applied on each PWM cycle in CURRENT drive so it
+	 * must not depend on slow_DIV.
+	 * */
+	pm.s_gain_I = pm.s_gain_P * 2.E-3f;
+
+	/* Speed is held at the limit by CC_SPEED_TRACK.
+	 * */
+	pm.i_setpoint_current = iSP;
+	sim_runtime(3.0);
+
+	TS_assert(pm.lu_MODE == PM_LU_ESTIMATE);
+	TS_assert_relative(pm.lu_wS, pm.s_maximal);
+
+	/* Machine is stopped by CC_BRAKE_STOP and does not run reverse until
+	 * we get out of high speed zone.
+	 * */
+	pm.i_setpoint_current = - iSP;
+
+	for (N = 0; N < 300; ++N) {
+
+		sim_runtime(0.01);
+
+		if (pm.lu_MODE != PM_LU_ESTIMATE || pm.flux_ZONE != PM_ZONE_HIGH)
+			break;
+
+		TS_assert(pm.lu_wS > - 0.1 * pm.s_maximal);
+	}
+
+	TS_assert(N < 300);
+
+	pm.i_setpoint_current = 0.f;
+
+	m.unsync_flag = 0;
+
+	pm.fsm_req = PM_STATE_LU_SHUTDOWN;
+	ts_wait_IDLE();
+
+	pm.config_LU_DRIVE = PM_DRIVE_SPEED;
+
+	pm.s_gain_I = 0.f;
+	pm.s_integral = 0.f;
+
+	pm.s_maximal = s_maximal;
+	pm.s_reverse = s_reverse;
+}
+
+static void
+ts_script_kalman()
+{
+	int		backup_LU_ESTIMATE;
+
+	backup_LU_ESTIMATE = pm.config_LU_ESTIMATE;
+
+	pm.config_LU_ESTIMATE = PM_FLUX_KALMAN;
+
+	ts_script_speed();
+
+	pm.config_LU_ESTIMATE = backup_LU_ESTIMATE;
+}
+
+static void
+ts_script_kalman_steady()
+{
+	pm.config_KALMAN_STEADY = PM_ENABLED;
+
+	ts_script_kalman();
+
+	pm.config_KALMAN_STEADY = PM_DISABLED;
+}
+
 static void
 ts_script_hfi()
 {
@@ -704,113 +802,148 @@ ts_script_eabi(int knob_EABI)
 	pm.config_LU_SENSOR = PM_SENSOR_NONE;
 }
 
-void ts_script_test()
+static void
+ts_script_eabi_incremental()
 {
-	blm_enable(&m);
-	blm_restart(&m);
+	ts_script_eabi(PM_EABI_INCREMENTAL);
+}
 
-	printf("\n---- XNOVA Lightning 4530 ----\n");
+static void
+ts_script_eabi_absolute()
+{
+	ts_script_eabi(PM_EABI_ABSOLUTE);
+}
 
-	tlm_restart();
+const ts_script_t	ts_script_list[] = {
 
-	m.Rs = 8.E-3;
-	m.Ld = 3.E-6;
-	m.Lq = 5.E-6;
-	m.Udc = 48.;
-	m.Rdc = 0.1;
-	m.Zp = 5;
-	m.lambda = blm_Kv_lambda(&m, 525.);
-	m.Jm = 2.E-4;
+	{ "speed", &ts_script_speed },
+	{ "current", &ts_script_current },
+	{ "kalman", &ts_script_kalman },
+	{ "kalman_steady", &ts_script_kalman_steady },
+	{ "hfi", &ts_script_hfi },
+	{ "weakening", &ts_script_weakening },
+	{ "hall", &ts_script_hall },
+	{ "eabi_inc", &ts_script_eabi_incremental },
+	{ "eabi_abs", &ts_script_eabi_absolute },
 
-	ts_script_default();
-	ts_script_base();
-	blm_restart(&m);
+	{ NULL, NULL }
+};
 
-	ts_script_speed();
-	blm_restart(&m);
+const ts_machine_t	ts_machine_list[] = {
 
-	/*ts_script_hfi();
-	  blm_restart(&m);*/
+	{ "XNOVA Lightning 4530", 8.E-3, 3.E-6, 5.E-6,
+		48., 0.1, 5, 525., 2.E-4, "speed,kalman_steady" },
 
-	printf("\n---- Turnigy RotoMax 1.20 ----\n");
+	{ "Turnigy RotoMax 1.20", 14.E-3, 10.E-6, 15.E-6,
+		22., 0.1, 14, 270., 3.E-4, "speed,hfi,eabi_inc,eabi_abs" },
 
-	tlm_restart();
+	{ "Hub Motor (250W)", 0.24, 520.E-6, 650.E-6,
+		48., 0.5, 15, 15., 6.E-3, "speed,weakening,hall" },
 
-	m.Rs = 14.E-3;
-	m.Ld = 10.E-6;
-	m.Lq = 15.E-6;
-	m.Udc = 22.;
-	m.Rdc = 0.1;
-	m.Zp = 14;
-	m.lambda = blm_Kv_lambda(&m, 270.);
-	m.Jm = 3.E-4;
+	{ "QS 138 (3000W)", 4.E-3, 31.E-6, 44.E-6,
+		48., 0.1, 5, 58., 15.E-3, "speed,hall" },
 
-	ts_script_default();
-	ts_script_base();
-	blm_restart(&m);
+	{ NULL }
+};
 
-	ts_script_speed();
-	blm_restart(&m);
+const ts_script_t *ts_script_search(const char *name, int len)
+{
+	const ts_script_t	*ts;
 
-	ts_script_hfi();
-	blm_restart(&m);
+	for (ts = ts_script_list; ts->name != NULL; ++ts) {
 
-	ts_script_eabi(PM_EABI_INCREMENTAL);
-	blm_restart(&m);
+		if (		strncmp(ts->name, name, len) == 0
+				&& ts->name[len] == 0) {
 
-	ts_script_eabi(PM_EABI_ABSOLUTE);
-	blm_restart(&m);
+			return ts;
+		}
+	}
 
-	printf("\n---- Hub Motor (250W) ----\n");
+	return NULL;
+}
 
-	tlm_restart();
+int ts_script_check(const char *script)
+{
+	int			len;
 
-	m.Rs = 0.24;
-	m.Ld = 520.E-6;
-	m.Lq = 650.E-6;
-	m.Udc = 48.;
-	m.Rdc = 0.5;
-	m.Zp = 15;
-	m.lambda = blm_Kv_lambda(&m, 15.);
-	m.Jm = 6.E-3;
+	while (*script != 0) {
 
-	ts_script_default();
-	ts_script_base();
-	blm_restart(&m);
+		len = strcspn(script, ",");
 
-	ts_script_speed();
-	blm_restart(&m);
+		if (		len != 0
+				&& ts_script_search(script, len) == NULL) {
 
-	ts_script_weakening();
-	blm_restart(&m);
+			fprintf(stderr, "unknown script \"%.*s\"\n", len, script);
+			return -1;
+		}
 
-	ts_script_hall();
-	blm_restart(&m);
+		script += (script[len] != 0) ? len + 1 : len;
+	}
+
+	return 0;
+}
+
+void ts_script_machine(const ts_machine_t *mach, const char *script)
+{
+	const ts_script_t	*ts;
+	int			len;
 
-	printf("\n---- QS 138 (3000W) ----\n");
+	printf("\n---- %s ----\n", mach->name);
 
 	tlm_restart();
 
-	m.Rs = 4.E-3;
-	m.Ld = 31.E-6;
-	m.Lq = 44.E-6;
-	m.Udc = 48.;
-	m.Rdc = 0.1;
-	m.Zp = 5;
-	m.lambda = blm_Kv_lambda(&m, 58.);
-	m.Jm = 15.E-3;
+	m.sol_N_step = 0;
+	m.sol_N_reject = 0;
+
+	m.Rs = mach->Rs;
+	m.Ld = mach->Ld;
+	m.Lq = mach->Lq;
+	m.Udc = mach->Udc;
+	m.Rdc = mach->Rdc;
+	m.Zp = mach->Zp;
+	m.lambda = blm_Kv_lambda(&m, mach->Kv);
+	m.Jm = mach->Jm;
 
 	ts_script_default();
 	ts_script_base();
 	blm_restart(&m);
 
-	ts_script_speed();
-	blm_restart(&m);
+	script = (script != NULL) ? script : mach->script;
 
-	/*ts_script_weakening();
-	  blm_restart(&m);*/
+	while (*script != 0) {
 
-	ts_script_hall();
-	blm_restart(&m);
+		len = strcspn(script, ",");
+
+		if (len != 0) {
+
+			ts = ts_script_search(script, len);
+
+			if (ts == NULL) {
+
+				fprintf(stderr, "unknown script \"%.*s\"\n", len, script);
+				exit(-1);
+			}
+
+			ts->proc();
+			blm_restart(&m);
+		}
+
+		script += (script[len] != 0) ? len + 1 : len;
+	}
+
+	printf("sol_N_step = %li\n", m.sol_N_step);
+	printf("sol_N_reject = %li\n", m.sol_N_reject);
 }
 
+void ts_script_test()
+{
+	const ts_machine_t	*mach;
+
+	blm_enable(&m);
+	blm_restart(&m);
+
+	for (mach = ts_machine_list; mach->name != NULL; ++mach) {
+
+		ts_script_machine(mach, NULL);
+	}
+}
@@ -1,9 +1,38 @@
 #ifndef _H_TSFUNC_
 #define _H_TSFUNC_
 
+typedef struct {
+
+	const char	*name;
+	void		(* proc) ();
+}
+ts_script_t;
+
+typedef struct {
+
+	const char	*name;
+
+	double		Rs;
+	double		Ld;
+	double		Lq;
+	double		Udc;
+	double		Rdc;
+	int		Zp;
+	double		Kv;
+	double		Jm;
+
+	const char	*script;
+}
+ts_machine_t;
+
 extern blm_t			m;
 extern pmc_t			pm;
 
+extern int			ts_slow_DIV;
+
+extern const ts_script_t	ts_script_list[];
+extern const ts_machine_t	ts_machine_list[];
+
 extern void tlm_restart();
 extern void sim_runtime(double dT);
 
@@ -16,6 +45,11 @@ void ts_adjust_sensor_eabi();
 
 void ts_script_default();
 void ts_script_base();
+
+const ts_script_t *ts_script_search(const char *name, int len);
+int ts_script_check(const char *script);
+
+void ts_script_machine(const ts_machine_t *mach, const char *script);
 void ts_script_test();
 
 #endif /* _H_TSFUNC_ */
@@ -0,0 +1,87 @@
+/*
+   Graph Plotter is a tool to analyse numerical data.
+   Copyright (C) 2024 Roman Belov <romblv@gmail.com>
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _H_COLUMN_
+#define _H_COLUMN_
+
+#include <stdint.h>
+
+/* Chunked columnar file of FP32 data. The file begins with the header and
+ * the list of column labels. Then follows a sequence of chunks each of
+ * them contains a blocks of all columns. The block is stored as is or is
+ * compressed with LZ4. All the fields are in native byte order and every
+ * part of file is aligned to 4 bytes so that raw blocks can be accessed
+ * directly from the mapped file.
+ *
+ * The label is written as "name@unit" the same way as in CSV header.
+ * */
+
+#define COLUMN_MAGIC		"GPCOLUMN"
+#define COLUMN_VERSION		1
+#define COLUMN_LABEL_MAX	80
+
+#define COLUMN_CHUNK_MAGIC	0x4B4E4843U
+
+#define COLUMN_ALIGN(n)		(((n) + 3U) & ~3U)
+
+enum {
+	COLUMN_BLOCK_RAW		= 0,
+	COLUMN_BLOCK_LZ4
+};
+
+typedef struct {
+
+	char		magic[8];
+
+	uint32_t	version;
+	uint32_t	column_N;
+	uint32_t	chunk_N;
+	uint32_t	flags;
+}
+column_head_t;
+
+typedef struct {
+
+	char		label[COLUMN_LABEL_MAX];
+}
+column_label_t;
+
+typedef struct {
+
+	uint32_t	magic;
+	uint32_t	row_N;
+
+	/* Length of all blocks that follows.
+	 * */
+	uint32_t	length;
+	uint32_t	reserved;
+}
+column_chunk_t;
+
+typedef struct {
+
+	uint32_t	type;
+
+	/* Length of block data without alignment.
+	 * */
+	uint32_t	length;
+}
+column_block_t;
+
+#endif /* _H_COLUMN_ */
+
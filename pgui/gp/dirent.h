@@ -60,5 +60,8 @@ void dirent_close(struct dirent_stat *sb);
 int file_stat(const char *file, unsigned long long *nsize);
 int file_remove(const char *file);
 
+void *file_map(const char *file, unsigned long long *nsize);
+void file_unmap(void *map, unsigned long long nsize);
+
 #endif /* _H_DIRENT_ */
 
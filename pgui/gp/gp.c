@@ -32,6 +32,7 @@
 #endif /* _WINDOWS */
 
 #include "gp.h"
+#include "column.h"
 #include "dirent.h"
 #include "draw.h"
 #include "edit.h"
@@ -600,6 +601,28 @@ gpFileIsGP(const char *file)
 	return rc;
 }
 
+static int
+gpFileIsColumn(const char *file)
+{
+	FILE		*fd;
+	char		magic[8];
+	int		rc = 0;
+
+	fd = unified_fopen(file, "rb");
+
+	if (fd != NULL) {
+
+		if (fread(magic, sizeof(magic), 1, fd) == 1) {
+
+			rc = (memcmp(magic, COLUMN_MAGIC, sizeof(magic)) == 0) ? 1 : 0;
+		}
+
+		fclose(fd);
+	}
+
+	return rc;
+}
+
 #ifdef _LEGACY
 static int
 legacy_FileIsBAT(const char *file)
@@ -710,6 +733,13 @@ gpUnifiedFileOpen(gpcon_t *gp, const char *file, int fromUI)
 	}
 #endif /* _LEGACY */
 
+	else if (gpFileIsColumn(file) != 0) {
+
+		sprintf(gp->sbuf[0],	"load 0 0 column \"%s\"\n"
+					"mkpages -2\n", file);
+
+		readConfigIN(rd, gp->sbuf[0], fromUI);
+	}
 	else {
 		sprintf(gp->sbuf[0],	"load 0 0 csv \"%s\"\n"
 					"mkpages -2\n", file);
@@ -975,6 +1005,10 @@ gpSymDatasetFormat(gpcon_t *gp, int dN)
 			sym = "FP64  ";
 			break;
 
+		case FORMAT_BINARY_COLUMN:
+			sym = "COLUMN";
+			break;
+
 		default:
 			sym = "LEGACY";
 			break;
@@ -28,10 +28,12 @@
 #endif /* _WINDOWS */
 
 #include "async.h"
+#include "column.h"
 #include "dirent.h"
 #include "draw.h"
 #include "edit.h"
 #include "lang.h"
+#include "lz4.h"
 #include "plot.h"
 #include "read.h"
 
@@ -1071,7 +1073,24 @@ readCSVGetCN(read_t *rd, int dN, FILE *fd, fval_t *rbuf, int *rbuf_N)
 static void
 readCloseFile(read_t *rd, int dN)
 {
-	async_close(rd->data[dN].afd);
+	cmap_t		*cm = rd->data[dN].cmap;
+
+	if (rd->data[dN].afd != NULL) {
+
+		async_close(rd->data[dN].afd);
+	}
+
+	if (cm != NULL) {
+
+		file_unmap(cm->map, cm->length);
+
+		if (cm->unpack != NULL) {
+
+			free(cm->unpack);
+		}
+
+		free(cm);
+	}
 
 	if (rd->data[dN].fd != stdin) {
 
@@ -1080,6 +1099,194 @@ readCloseFile(read_t *rd, int dN)
 
 	rd->data[dN].fd = NULL;
 	rd->data[dN].afd = NULL;
+	rd->data[dN].cmap = NULL;
+}
+
+static int
+readColumnOpen(read_t *rd, int dN, const char *file, int *lN)
+{
+	const column_head_t	*head;
+	const column_label_t	*label;
+	const column_chunk_t	*chunk;
+
+	cmap_t			*cm;
+	unsigned long long	offset;
+	int			N, cN, total_N;
+
+	cm = (cmap_t *) calloc(1, sizeof(cmap_t));
+
+	if (cm == NULL) {
+
+		ERROR("No memory allocated for column map\n");
+		return 0;
+	}
+
+	/* We map the whole file so raw blocks are read in place without the
+	 * async reader. Dataset keeps the rows interleaved so each row is
+	 * still copied by plotDataInsert the same way as other formats.
+	 * */
+	cm->map = file_map(file, &cm->length);
+
+	if (cm->map == NULL) {
+
+		ERROR("Unable to map file \"%s\"\n", file);
+
+		free(cm);
+		return 0;
+	}
+
+	head = (const column_head_t *) cm->map;
+
+	if (		cm->length < sizeof(column_head_t)
+			|| memcmp(head->magic, COLUMN_MAGIC, sizeof(head->magic)) != 0
+			|| head->version != COLUMN_VERSION) {
+
+		ERROR("No column header in file \"%s\"\n", file);
+
+		file_unmap(cm->map, cm->length);
+		free(cm);
+		return 0;
+	}
+
+	cN = (int) head->column_N;
+
+	offset = sizeof(column_head_t) + sizeof(column_label_t) * cN;
+
+	if (		cN < 1 || cN > READ_COLUMN_MAX
+			|| head->chunk_N < 1
+			|| offset > cm->length) {
+
+		ERROR("Invalid column header in file \"%s\"\n", file);
+
+		file_unmap(cm->map, cm->length);
+		free(cm);
+		return 0;
+	}
+
+	label = (const column_label_t *) (head + 1);
+
+	for (N = 0; N < cN; ++N) {
+
+		memcpy(rd->data[dN].label[N], label[N].label, READ_TOKEN_MAX - 1);
+		rd->data[dN].label[N][READ_TOKEN_MAX - 1] = 0;
+	}
+
+	cm->chunk_N = (int) head->chunk_N;
+	cm->offset = offset;
+
+	/* Walk through the chunk headers to get the exact length.
+	 * */
+	total_N = 0;
+
+	while (offset + sizeof(column_chunk_t) <= cm->length) {
+
+		chunk = (const column_chunk_t *) ((const char *) cm->map + offset);
+
+		if (chunk->magic != COLUMN_CHUNK_MAGIC)
+			break;
+
+		offset += sizeof(column_chunk_t) + chunk->length;
+		total_N += (int) chunk->row_N;
+	}
+
+	*lN = (*lN < 1) ? total_N : *lN;
+
+	rd->data[dN].cmap = cm;
+
+	return cN;
+}
+
+static int
+readColumnChunk(read_t *rd, int dN)
+{
+	cmap_t			*cm = rd->data[dN].cmap;
+
+	const column_chunk_t	*chunk;
+	const column_block_t	*block;
+	const char		*base = (const char *) cm->map;
+
+	unsigned long long	offset, end;
+	int			N, bSIZE, lzLEN;
+
+	offset = cm->offset;
+
+	if (offset + sizeof(column_chunk_t) > cm->length)
+		return 0;
+
+	chunk = (const column_chunk_t *) (base + offset);
+
+	offset += sizeof(column_chunk_t);
+	end = offset + chunk->length;
+
+	if (		chunk->magic != COLUMN_CHUNK_MAGIC
+			|| chunk->row_N < 1
+			|| (int) chunk->row_N > cm->chunk_N
+			|| end > cm->length) {
+
+		ERROR("Broken chunk in file \"%s\"\n", rd->data[dN].file);
+		return 0;
+	}
+
+	bSIZE = (int) chunk->row_N * sizeof(float);
+
+	for (N = 0; N < rd->data[dN].column_N; ++N) {
+
+		block = (const column_block_t *) (base + offset);
+
+		offset += sizeof(column_block_t);
+
+		if (		offset > end
+				|| offset + block->length > end) {
+
+			ERROR("Broken block in file \"%s\"\n", rd->data[dN].file);
+			return 0;
+		}
+
+		if (		block->type == COLUMN_BLOCK_RAW
+				&& (int) block->length == bSIZE) {
+
+			cm->column[N] = (const float *) (base + offset);
+		}
+		else if (block->type == COLUMN_BLOCK_LZ4) {
+
+			if (cm->unpack == NULL) {
+
+				cm->unpack = (float *) malloc(sizeof(float)
+						* cm->chunk_N * rd->data[dN].column_N);
+
+				if (cm->unpack == NULL) {
+
+					ERROR("No memory allocated for LZ4 unpack\n");
+					return 0;
+				}
+			}
+
+			lzLEN = LZ4_decompress_safe(base + offset,
+					(char *) (cm->unpack + cm->chunk_N * N),
+					(int) block->length, bSIZE);
+
+			if (lzLEN != bSIZE) {
+
+				ERROR("Unable to decompress block in file \"%s\"\n",
+						rd->data[dN].file);
+				return 0;
+			}
+
+			cm->column[N] = cm->unpack + cm->chunk_N * N;
+		}
+		else {
+			ERROR("Unknown block in file \"%s\"\n", rd->data[dN].file);
+			return 0;
+		}
+
+		offset += COLUMN_ALIGN(block->length);
+	}
+
+	cm->offset = end;
+	cm->row_N = (int) chunk->row_N;
+	cm->row_ID = 0;
+
+	return 1;
 }
 
 void readOpenUnified(read_t *rd, int dN, int cN, int lN, const char *file, int fmt)
@@ -1162,6 +1369,19 @@ void readOpenUnified(read_t *rd, int dN, int cN, int lN, const char *file, int f
 			lN = (lN < 1) ? (int) (bF / (cN * sizeof(double))) : lN;
 			rd->data[dN].line_N = 1;
 		}
+		else if (fmt == FORMAT_BINARY_COLUMN) {
+
+			cN = readColumnOpen(rd, dN, file, &lN);
+
+			if (cN < 1) {
+
+				fclose(fd);
+				return ;
+			}
+
+			lN = (lN < 1) ? 1 : lN;
+			rd->data[dN].line_N = 1;
+		}
 
 #ifdef _LEGACY
 		else if (fmt == FORMAT_BINARY_LEGACY_V1) {
@@ -1197,7 +1417,11 @@ void readOpenUnified(read_t *rd, int dN, int cN, int lN, const char *file, int f
 		strcpy(rd->data[dN].file, file);
 
 		rd->data[dN].fd = fd;
-		rd->data[dN].afd = async_open(fd, rd->preload, rd->chunk, rd->timeout);
+
+		if (fmt != FORMAT_BINARY_COLUMN) {
+
+			rd->data[dN].afd = async_open(fd, rd->preload, rd->chunk, rd->timeout);
+		}
 
 		rd->keep_N += 1;
 		rd->bind_N = dN;
@@ -1355,6 +1579,31 @@ readFP64(read_t *rd, int dN)
 	return 0;
 }
 
+static int
+readCOLUMN(read_t *rd, int dN)
+{
+	cmap_t		*cm = rd->data[dN].cmap;
+	int		N, cN = rd->pl->data[dN].column_N;
+
+	if (cm->row_ID >= cm->row_N) {
+
+		if (readColumnChunk(rd, dN) == 0) {
+
+			readCloseFile(rd, dN);
+			return 0;
+		}
+	}
+
+	for (N = 0; N < cN; ++N)
+		rd->data[dN].row[N] = (fval_t) cm->column[N][cm->row_ID];
+
+	cm->row_ID++;
+
+	plotDataInsert(rd->pl, dN, rd->data[dN].row);
+
+	return 1;
+}
+
 #ifdef _LEGACY
 static int
 readLEGACY(read_t *rd, int dN)
@@ -1443,6 +1692,16 @@ int readDataLoad(read_t *rd)
 						break;
 					}
 				}
+				else if (rd->data[dN].format == FORMAT_BINARY_COLUMN) {
+
+					if (readCOLUMN(rd, dN) != 0) {
+
+						ulN += 1;
+					}
+					else {
+						break;
+					}
+				}
 
 #ifdef _LEGACY
 				else if (rd->data[dN].format == FORMAT_BINARY_LEGACY_V1
@@ -2462,6 +2721,10 @@ configParseFSM(read_t *rd, parse_t *pa)
 
 							argi[2] = FORMAT_BINARY_FP_64;
 						}
+						else if (strcmp(tbuf, "column") == 0) {
+
+							argi[2] = FORMAT_BINARY_COLUMN;
+						}
 						else {
 							sprintf(msg_tbuf, "invalid file format \"%.80s\"", tbuf);
 							break;
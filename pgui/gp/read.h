@@ -48,6 +48,7 @@ enum {
 	FORMAT_TEXT_CSV,
 	FORMAT_BINARY_FP_32,
 	FORMAT_BINARY_FP_64,
+	FORMAT_BINARY_COLUMN,
 
 #ifdef _LEGACY
 	FORMAT_BINARY_LEGACY_V1,
@@ -124,6 +125,21 @@ typedef struct {
 }
 page_t;
 
+typedef struct {
+
+	void			*map;
+	unsigned long long	length;
+	unsigned long long	offset;
+
+	int			chunk_N;
+	int			row_N;
+	int			row_ID;
+
+	float			*unpack;
+	const float		*column[READ_COLUMN_MAX];
+}
+cmap_t;
+
 typedef struct {
 
 	char		file[READ_FILE_PATH_MAX];
@@ -182,6 +198,7 @@ typedef struct {
 
 		FILE		*fd;
 		async_FILE	*afd;
+		cmap_t		*cmap;
 
 		char		buf[READ_TOKEN_MAX * READ_COLUMN_MAX];
 		fval_t		row[READ_COLUMN_MAX];
@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <float.h>
 #include <time.h>
 
 #include <SDL2/SDL.h>
@@ -17,6 +18,14 @@
 #define LINK_ALLOC_MAX			92160U
 #define LINK_CACHE_MAX			4096U
 
+#define LINK_BULK_FRAME			54
+#define LINK_BULK_ENTRY			8
+#define LINK_BULK_QUEUE			96
+#define LINK_BULK_KNOWN			0x100
+
+#define LINK_LIVE_BIN			32768
+#define LINK_LIVE_MAX			2048
+
 enum {
 	LINK_MODE_IDLE			= 0,
 	LINK_MODE_HWINFO,
@@ -25,6 +34,13 @@ enum {
 	LINK_MODE_EPCAN_MAP,
 	LINK_MODE_FLASH_MAP,
 	LINK_MODE_UNABLE_WARNING,
+	LINK_MODE_LIVE_BIN,
+};
+
+struct link_bulk {
+
+	unsigned char		raw[LINK_BULK_FRAME];
+	int			len;
 };
 
 struct link_priv {
@@ -34,6 +50,26 @@ struct link_priv {
 	int			link_mode;
 	int			reg_push_ID;
 
+	int			bulk_version;
+
+	struct link_bulk	bulk_read;
+	struct link_bulk	bulk_write;
+
+	unsigned char		live_bin[LINK_LIVE_BIN];
+	int			live_len;
+
+	float			live_dT;
+	float			live_scale[LINK_LIVE_COLUMN];
+	float			live_offset[LINK_LIVE_COLUMN];
+	int			live_fmt[LINK_LIVE_COLUMN];
+
+	int			live_seq;
+	long			live_clock;
+
+	double			live_row[LINK_LIVE_MAX][LINK_LIVE_COLUMN];
+	int			live_rp;
+	int			live_wp;
+
 	char			lbuf[LINK_MESSAGE_MAX];
 
 	FILE			*fd_log;
@@ -217,6 +253,299 @@ lk_hash(const char *sym)
 	return hash;
 }
 
+static const char	lk_base64_alpha[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+				"abcdefghijklmnopqrstuvwxyz0123456789-_";
+
+static unsigned long
+lk_crc32(const unsigned char *raw, int len)
+{
+	unsigned long		crc32 = 0xFFFFFFFFUL;
+	int			N;
+
+	while (len > 0) {
+
+		crc32 ^= *raw++;
+
+		for (N = 0; N < 8; ++N) {
+
+			crc32 = (crc32 & 1UL) ? (crc32 >> 1) ^ 0xEDB88320UL
+				: (crc32 >> 1);
+		}
+
+		--len;
+	}
+
+	return crc32 ^ 0xFFFFFFFFUL;
+}
+
+static void
+lk_base64_encode(char *s, const unsigned char *raw, int len)
+{
+	unsigned long		bits = 0UL;
+	int			n = 0;
+
+	while (len > 0) {
+
+		bits = (bits << 8) | *raw++;
+		n += 8;
+
+		while (n >= 6) {
+
+			n -= 6;
+			*s++ = lk_base64_alpha[(bits >> n) & 0x3FUL];
+		}
+
+		--len;
+	}
+
+	if (n > 0) {
+
+		*s++ = lk_base64_alpha[(bits << (6 - n)) & 0x3FUL];
+	}
+
+	*s = 0;
+}
+
+static int
+lk_base64_decode(unsigned char *raw, const char *s, int max)
+{
+	const char		*p;
+	unsigned long		bits = 0UL;
+	int			len = 0, n = 0;
+
+	while (*s != 0 && strchr(LINK_EOL LINK_SPACE, *s) == NULL) {
+
+		p = strchr(lk_base64_alpha, *s);
+
+		if (p == NULL)
+			return -1;
+
+		bits = (bits << 6) | (unsigned long) (p - lk_base64_alpha);
+		n += 6;
+
+		if (n >= 8) {
+
+			n -= 8;
+
+			if (len >= max)
+				return -1;
+
+			raw[len++] = (unsigned char) (bits >> n);
+		}
+
+		++s;
+	}
+
+	return len;
+}
+
+static unsigned long
+lk_le32(const unsigned char *raw)
+{
+	return    (unsigned long) raw[0]
+		| (unsigned long) raw[1] << 8
+		| (unsigned long) raw[2] << 16
+		| (unsigned long) raw[3] << 24;
+}
+
+static float
+lk_le32_float(const unsigned char *raw)
+{
+	union {
+
+		float		f;
+		unsigned int	i;
+	}
+	u = { .i = (unsigned int) lk_le32(raw) };
+
+	return u.f;
+}
+
+static int
+lk_fp_special(char *s, float x)
+{
+	if (x != x) {
+
+		strcpy(s, "NaN");
+		return 1;
+	}
+	else if (x > FLT_MAX) {
+
+		strcpy(s, "Inf");
+		return 1;
+	}
+
+	return 0;
+}
+
+/* We mimic the floating-point formats of firmware libc so that values from
+ * bulk replies look the same as in text replies.
+ * */
+static void
+lk_fp_fixed(char *s, float x, int n)
+{
+	int		i, v;
+	float		h;
+
+	if (x < 0.f) { *s++ = '-'; x = - x; }
+
+	if (lk_fp_special(s, x) != 0)
+		return ;
+
+	v = 0;
+	h = 0.5f;
+
+	for (i = 0; i < n; ++i)
+		h /= 10.f;
+
+	x += h;
+
+	while (x >= 10.f) { x /= 10.f; v++; }
+
+	i = (int) x;
+	x -= (float) i;
+
+	*s++ = '0' + i;
+
+	for (; v > 0; --v) {
+
+		x *= 10.f;
+		i = (int) x;
+		x -= (float) i;
+
+		*s++ = '0' + i;
+	}
+
+	*s++ = '.';
+
+	for (; n > 0; --n) {
+
+		x *= 10.f;
+		i = (int) x;
+		x -= (float) i;
+
+		*s++ = '0' + i;
+	}
+
+	*s = 0;
+}
+
+static void
+lk_fp_normal(char *s, float x, int n, int pretty)
+{
+	int		i, v;
+	float		h;
+
+	if (x < 0.f) { *s++ = '-'; x = - x; }
+
+	if (lk_fp_special(s, x) != 0)
+		return ;
+
+	v = 0;
+	h = 0.5f;
+
+	while (x > 0.f && x < 1.f) { x *= 10.f; v--; }
+	while (x >= 10.f) { x /= 10.f; v++; }
+
+	if (pretty != 0) { n--; }
+
+	for (i = 0; i < n; ++i)
+		h /= 10.f;
+
+	x += h;
+
+	if (x >= 10.f) { x /= 10.f; v++; }
+
+	i = (int) x;
+	x -= (float) i;
+
+	*s++ = '0' + i;
+
+	if (pretty != 0) {
+
+		for (; v % 3 != 0; --v, --n) {
+
+			x *= 10.f;
+			i = (int) x;
+			x -= (float) i;
+
+			*s++ = '0' + i;
+		}
+	}
+
+	*s++ = '.';
+
+	for (; n > 0; --n) {
+
+		x *= 10.f;
+		i = (int) x;
+		x -= (float) i;
+
+		*s++ = '0' + i;
+	}
+
+	*s = 0;
+
+	if (pretty != 0) {
+
+		if (v == - 9) { strcpy(s, "n"); }
+		else if (v == - 6) { strcpy(s, "u"); }
+		else if (v == - 3) { strcpy(s, "m"); }
+		else if (v == 3) { strcpy(s, "K"); }
+		else if (v == 6) { strcpy(s, "M"); }
+		else if (v == 9) { strcpy(s, "G"); }
+		else if (v != 0) {
+
+			sprintf(s, (v >= 0) ? "E+%i" : "E%i", v);
+		}
+	}
+	else {
+		sprintf(s, (v >= 0) ? "E+%i" : "E%i", v);
+	}
+}
+
+static void
+lk_format_rval(char *s, int fmt, unsigned long rval)
+{
+	union {
+
+		float		f;
+		unsigned int	i;
+	}
+	u = { .i = (unsigned int) rval };
+
+	int		n = (fmt >> 4) & 0xF;
+
+	switch (fmt & 0xF) {
+
+		case 0:
+			sprintf(s, "%i", (int) u.i);
+			break;
+
+		case 1:
+			if (n == 2) { sprintf(s, "%02X", u.i & 0xFFU); }
+			else if (n == 4) { sprintf(s, "%04X", u.i & 0xFFFFU); }
+			else { sprintf(s, "%08X", u.i); }
+			break;
+
+		case 2:
+			lk_fp_fixed(s, u.f, n);
+			break;
+
+		case 3:
+			lk_fp_normal(s, u.f, n, 0);
+			break;
+
+		case 4:
+			lk_fp_normal(s, u.f, n, 1);
+			break;
+
+		default:
+			s[0] = 0;
+			break;
+	}
+}
+
 static char *
 link_mballoc(struct link_pmc *lp, int len)
 {
@@ -421,6 +750,69 @@ link_fetch_reg_format(struct link_pmc *lp)
 	}
 }
 
+static void
+link_fetch_reg_bulk(struct link_pmc *lp)
+{
+	struct link_priv	*priv = lp->priv;
+	struct link_reg		*reg;
+	unsigned char		raw[LINK_MESSAGE_MAX];
+	unsigned long		rval, crc32;
+	char			*sp = priv->lbuf + 5;
+	int			reg_ID, len, N;
+
+	if (strstr(priv->lbuf, "BULK ") == priv->lbuf) {
+
+		if (lk_stoi(&N, lk_token(&sp)) != NULL) {
+
+			priv->bulk_version = N;
+		}
+
+		return ;
+	}
+
+	if (priv->lbuf[0] != '$')
+		return ;
+
+	len = lk_base64_decode(raw, priv->lbuf + 1, sizeof(raw));
+
+	if (len < LINK_BULK_ENTRY + 4)
+		return ;
+
+	len -= 4;
+
+	crc32 = lk_le32(raw + len);
+
+	if (crc32 != lk_crc32(raw, len))
+		return ;
+
+	for (N = 0; N + LINK_BULK_ENTRY <= len; N += LINK_BULK_ENTRY) {
+
+		reg_ID = raw[N] | raw[N + 1] << 8;
+
+		if (reg_ID >= LINK_REGS_MAX)
+			continue;
+
+		reg = lp->reg + reg_ID;
+
+		rval = lk_le32(raw + N + 4);
+
+		reg->mode = raw[N + 2];
+		reg->bulk_fmt = raw[N + 3] | LINK_BULK_KNOWN;
+
+		if ((reg->mode & LINK_REG_HIDDEN) == 0) {
+
+			lk_format_rval(reg->val, reg->bulk_fmt, rval);
+			link_reg_postproc(lp, reg);
+		}
+
+		reg->fetched = lp->clock;
+		reg->queued = 0;
+
+		lp->reg_MAX_N = (reg_ID + 1 > lp->reg_MAX_N)
+			? reg_ID + 1 : lp->reg_MAX_N;
+	}
+}
+
 static void
 link_fetch_hwinfo(struct link_pmc *lp)
 {
@@ -559,6 +951,184 @@ link_fetch_unable_warning(struct link_pmc *lp)
 	}
 }
 
+static void
+link_live_frame(struct link_pmc *lp, const unsigned char *raw)
+{
+	struct link_priv	*priv = lp->priv;
+	const unsigned char	*pl = raw + 8;
+	double			*row;
+	long			clock;
+	int			len, seq, row_N, N;
+
+	len = raw[4] | raw[5] << 8;
+	seq = raw[6] | raw[7] << 8;
+
+	if (raw[2] == 'H') {
+
+		N = pl[0];
+
+		if (N + 1 > LINK_LIVE_COLUMN || len < 8 + N * 12)
+			return ;
+
+		priv->live_dT = lk_le32_float(pl + 4);
+
+		lp->live.column_N = N + 1;
+		lp->live.reg_ID[0] = 0;
+
+		for (N = 1; N < lp->live.column_N; ++N) {
+
+			pl = raw + 8 + 8 + (N - 1) * 12;
+
+			lp->live.reg_ID[N] = pl[0] | pl[1] << 8;
+
+			priv->live_fmt[N] = pl[2];
+			priv->live_scale[N] = lk_le32_float(pl + 4);
+			priv->live_offset[N] = lk_le32_float(pl + 8);
+		}
+
+		priv->live_seq = 1;
+		priv->live_clock = 0;
+
+		lp->live.started = 1;
+	}
+	else if (raw[2] == 'D' && lp->live.started != 0) {
+
+		if (len < 4)
+			return ;
+
+		row_N = (len - 4) / ((lp->live.column_N - 1) * 4);
+
+		/* We count the rows that were lost in transmission or were
+		 * dropped by overrun on the other side.
+		 * */
+		clock = (long) lk_le32(pl);
+
+		if (clock > priv->live_clock) {
+
+			lp->live.lost_N += (int) (clock - priv->live_clock);
+		}
+
+		if (seq != priv->live_seq) {
+
+			lp->live.frame_lost_N += (seq - priv->live_seq) & 0xFFFF;
+		}
+
+		priv->live_seq = (seq + 1) & 0xFFFF;
+		priv->live_clock = clock;
+
+		pl += 4;
+
+		for (; row_N > 0; --row_N) {
+
+			row = priv->live_row[priv->live_wp];
+
+			row[0] = (double) priv->live_clock * priv->live_dT;
+
+			for (N = 1; N < lp->live.column_N; ++N) {
+
+				if ((priv->live_fmt[N] & 0xF) < 2) {
+
+					row[N] = (double) (int) lk_le32(pl);
+				}
+				else {
+					row[N] = (double) (lk_le32_float(pl)
+						* priv->live_scale[N]
+						+ priv->live_offset[N]);
+				}
+
+				pl += 4;
+			}
+
+			N = (priv->live_wp < LINK_LIVE_MAX - 1) ? priv->live_wp + 1 : 0;
+
+			if (N != priv->live_rp) {
+
+				priv->live_wp = N;
+			}
+			else {
+				lp->live.lost_N++;
+			}
+
+			priv->live_clock++;
+
+			lp->live.row_N++;
+		}
+	}
+	else if (raw[2] == 'E') {
+
+		if (len >= 4) {
+
+			lp->live.overrun_N = (int) lk_le32(pl);
+		}
+
+		priv->link_mode = LINK_MODE_IDLE;
+	}
+}
+
+static int
+link_fetch_live_bin(struct link_pmc *lp)
+{
+	struct link_priv	*priv = lp->priv;
+	unsigned char		*raw = priv->live_bin;
+	int			len, total, N, frame_N = 0;
+
+	len = serial_fread(priv->fd, raw + priv->live_len,
+			LINK_LIVE_BIN - priv->live_len);
+
+	if (len > 0) {
+
+		priv->live_len += len;
+		lp->active = lp->clock;
+	}
+
+	N = 0;
+
+	while (		priv->live_len - N >= 12
+			&& priv->link_mode == LINK_MODE_LIVE_BIN) {
+
+		if (raw[N] != 0xA5U || raw[N + 1] != 0x5AU) {
+
+			N++;
+			continue;
+		}
+
+		total = 8 + (raw[N + 4] | raw[N + 5] << 8) + 4;
+
+		if (total > LINK_LIVE_BIN) {
+
+			N += 2;
+			continue;
+		}
+
+		if (priv->live_len - N < total)
+			break;
+
+		if (lk_le32(raw + N + total - 4) != lk_crc32(raw + N, total - 4)) {
+
+			lp->live.lost_N++;
+
+			N += 2;
+			continue;
+		}
+
+		link_live_frame(lp, raw + N);
+
+		N += total;
+		frame_N++;
+	}
+
+	if (priv->link_mode == LINK_MODE_LIVE_BIN) {
+
+		memmove(raw, raw + N, priv->live_len - N);
+		priv->live_len -= N;
+	}
+	else {
+		priv->live_len = 0;
+	}
+
+	return frame_N;
+}
+
 void link_open(struct link_pmc *lp, struct config_phobia *fe,
 		const char *devname, int baudrate, const char *mode)
 {
@@ -610,6 +1180,9 @@ void link_open(struct link_pmc *lp, struct config_phobia *fe,
 	sprintf(priv->lbuf, "reg" LINK_EOL);
 	serial_fputs(priv->fd, priv->lbuf);
 
+	sprintf(priv->lbuf, "reg_bulk" LINK_EOL);
+	serial_fputs(priv->fd, priv->lbuf);
+
 	lp->linked = 1;
 }
 
@@ -656,6 +1229,10 @@ void link_remote(struct link_pmc *lp)
 	priv->reg_push_ID = 0;
 	priv->mbflow = priv->mb;
 
+	priv->bulk_version = 0;
+	priv->bulk_read.len = 0;
+	priv->bulk_write.len = 0;
+
 	if (priv->fd_grab != NULL) {
 
 		fclose(priv->fd_grab);
@@ -687,6 +1264,9 @@ void link_remote(struct link_pmc *lp)
 
 	sprintf(priv->lbuf, "reg" LINK_EOL);
 	serial_fputs(priv->fd, priv->lbuf);
+
+	sprintf(priv->lbuf, "reg_bulk" LINK_EOL);
+	serial_fputs(priv->fd, priv->lbuf);
 }
 
 int link_fetch(struct link_pmc *lp, int clock)
@@ -709,11 +1289,13 @@ int link_fetch(struct link_pmc *lp, int clock)
 		{ "flash_info",		LINK_MODE_FLASH_MAP },
 		{ "flash_prog",		LINK_MODE_UNABLE_WARNING },
 		{ "flash_wipe",		LINK_MODE_UNABLE_WARNING },
+		{ "flash_profile_",	LINK_MODE_UNABLE_WARNING },
 		{ "pm_self_",		LINK_MODE_UNABLE_WARNING },
 		{ "pm_probe_",		LINK_MODE_UNABLE_WARNING },
 		{ "pm_adjust_",		LINK_MODE_UNABLE_WARNING },
 		{ "tlm_flush_sync",	LINK_MODE_DATA_GRAB },
 		{ "tlm_live_sync",	LINK_MODE_DATA_GRAB },
+		{ "tlm_live_bin",	LINK_MODE_LIVE_BIN },
 		{ "net_survey",		LINK_MODE_EPCAN_MAP },
 		{ "net_assign",		LINK_MODE_UNABLE_WARNING },
 		{ "net_revoke",		LINK_MODE_UNABLE_WARNING },
@@ -727,7 +1309,13 @@ int link_fetch(struct link_pmc *lp, int clock)
 	if (lp->linked == 0)
 		return 0;
 
-	while (serial_fgets(priv->fd, priv->lbuf, sizeof(priv->lbuf)) == SERIAL_OK) {
+	if (priv->link_mode == LINK_MODE_LIVE_BIN) {
+
+		N += link_fetch_live_bin(lp);
+	}
+
+	while (		priv->link_mode != LINK_MODE_LIVE_BIN
+			&& serial_fgets(priv->fd, priv->lbuf, sizeof(priv->lbuf)) == SERIAL_OK) {
 
 		lp->active = lp->clock;
 
@@ -756,6 +1344,7 @@ int link_fetch(struct link_pmc *lp, int clock)
 		}
 		else {
 			link_fetch_reg_format(lp);
+			link_fetch_reg_bulk(lp);
 		}
 
 		switch (priv->link_mode) {
@@ -793,6 +1382,14 @@ int link_fetch(struct link_pmc *lp, int clock)
 						lp->command_state = LINK_COMMAND_RUNING;
 					}
 				}
+				else if (priv->link_mode == LINK_MODE_LIVE_BIN) {
+
+					memset(&lp->live, 0, sizeof(lp->live));
+
+					priv->live_len = 0;
+					priv->live_rp = 0;
+					priv->live_wp = 0;
+				}
 				break;
 
 			case LINK_MODE_HWINFO:
@@ -838,6 +1435,13 @@ int link_fetch(struct link_pmc *lp, int clock)
 			link_grab_file_close(lp);
 		}
 	}
+	else if (priv->link_mode == LINK_MODE_LIVE_BIN) {
+
+		if (lp->active + 1000 < lp->clock) {
+
+			priv->link_mode = LINK_MODE_IDLE;
+		}
+	}
 	else {
 		if (lp->active + 12000 < lp->clock) {
 
@@ -892,11 +1496,130 @@ link_reg_all_queued(struct link_pmc *lp)
 	return busy_N;
 }
 
+static int
+link_bulk_send(struct link_pmc *lp, struct link_bulk *bk)
+{
+	struct link_priv	*priv = lp->priv;
+	char			text[LINK_BULK_FRAME * 2];
+	unsigned long		crc32;
+	int			N, rc = SERIAL_OK;
+
+	if (bk->len != 0) {
+
+		crc32 = lk_crc32(bk->raw, bk->len);
+
+		for (N = 0; N < 4; ++N) {
+
+			bk->raw[bk->len++] = (unsigned char) (crc32 >> (N * 8));
+		}
+
+		lk_base64_encode(text, bk->raw, bk->len);
+
+		sprintf(priv->lbuf, "reg_bulk %s" LINK_EOL, text);
+
+		rc = serial_fputs(priv->fd, priv->lbuf);
+
+		bk->len = 0;
+	}
+
+	return rc;
+}
+
+static void
+link_bulk_append(struct link_pmc *lp, struct link_bulk *bk, int op,
+		const unsigned char *raw, int len)
+{
+	if (bk->len + len + 4 > LINK_BULK_FRAME) {
+
+		link_bulk_send(lp, bk);
+	}
+
+	if (bk->len == 0) {
+
+		bk->raw[bk->len++] = (unsigned char) op;
+	}
+
+	memcpy(bk->raw + bk->len, raw, len);
+
+	bk->len += len;
+}
+
+static int
+link_bulk_read(struct link_pmc *lp, int reg_ID)
+{
+	struct link_priv	*priv = lp->priv;
+	unsigned char		raw[2];
+
+	/* We read the register in bulk once its unit is known from the text
+	 * reply.
+	 * */
+	if (priv->bulk_version < 1 || lp->reg[reg_ID].fetched == 0)
+		return 0;
+
+	raw[0] = (unsigned char) (reg_ID);
+	raw[1] = (unsigned char) (reg_ID >> 8);
+
+	link_bulk_append(lp, &priv->bulk_read, 'L', raw, 2);
+
+	return 1;
+}
+
+static int
+link_bulk_write(struct link_pmc *lp, int reg_ID)
+{
+	struct link_priv	*priv = lp->priv;
+	struct link_reg		*reg = lp->reg + reg_ID;
+	unsigned char		raw[6];
+	double			dval;
+	int			lval;
+
+	union {
+
+		float		f;
+		unsigned int	i;
+	}
+	u;
+
+	if (		priv->bulk_version < 1
+			|| (reg->bulk_fmt & LINK_BULK_KNOWN) == 0
+			|| (reg->mode & LINK_REG_LINKED) != 0)
+		return 0;
+
+	if ((reg->bulk_fmt & 0xF) == 0) {
+
+		if (lk_stoi(&lval, reg->val) == NULL)
+			return 0;
+
+		u.i = (unsigned int) lval;
+	}
+	else if ((reg->bulk_fmt & 0xF) >= 2) {
+
+		if (lk_stod(&dval, reg->val) == NULL)
+			return 0;
+
+		u.f = (float) dval;
+	}
+	else {
+		return 0;
+	}
+
+	raw[0] = (unsigned char) (reg_ID);
+	raw[1] = (unsigned char) (reg_ID >> 8);
+	raw[2] = (unsigned char) (u.i);
+	raw[3] = (unsigned char) (u.i >> 8);
+	raw[4] = (unsigned char) (u.i >> 16);
+	raw[5] = (unsigned char) (u.i >> 24);
+
+	link_bulk_append(lp, &priv->bulk_write, 'W', raw, 6);
+
+	return 1;
+}
+
 void link_push(struct link_pmc *lp)
 {
 	struct link_priv	*priv = lp->priv;
 	struct link_reg		*reg;
-	int			reg_ID, dofetch, busy_N;
+	int			reg_ID, dofetch, busy_N, busy_MAX;
 
 	if (lp->linked == 0)
 		return ;
@@ -904,12 +1627,14 @@ void link_push(struct link_pmc *lp)
 	if (lp->locked > lp->clock)
 		return ;
 
-	if (priv->link_mode == LINK_MODE_DATA_GRAB)
+	if (		priv->link_mode == LINK_MODE_DATA_GRAB
+			|| priv->link_mode == LINK_MODE_LIVE_BIN)
 		return ;
 
 	busy_N = link_reg_all_queued(lp);
+	busy_MAX = (priv->bulk_version != 0) ? LINK_BULK_QUEUE : 10;
 
-	if (busy_N > 10)
+	if (busy_N > busy_MAX)
 		return ;
 
 	reg_ID = priv->reg_push_ID;
@@ -944,28 +1669,46 @@ void link_push(struct link_pmc *lp)
 
 			if (reg->modified > reg->fetched) {
 
-				sprintf(priv->lbuf, "reg %i %.79s" LINK_EOL,
-						reg_ID, reg->val);
-
-				if (serial_fputs(priv->fd, priv->lbuf) == SERIAL_OK) {
+				if (link_bulk_write(lp, reg_ID) != 0) {
 
 					reg->queued = lp->clock;
 					lp->locked = lp->clock;
 
 					busy_N++;
 				}
+				else {
+					sprintf(priv->lbuf, "reg %i %.79s" LINK_EOL,
+							reg_ID, reg->val);
+
+					if (serial_fputs(priv->fd, priv->lbuf) == SERIAL_OK) {
+
+						reg->queued = lp->clock;
+						lp->locked = lp->clock;
+
+						busy_N++;
+					}
+				}
 			}
 			else if (dofetch != 0) {
 
-				sprintf(priv->lbuf, "reg %i" LINK_EOL, reg_ID);
-
-				if (serial_fputs(priv->fd, priv->lbuf) == SERIAL_OK) {
+				if (link_bulk_read(lp, reg_ID) != 0) {
 
 					reg->queued = lp->clock;
 					lp->locked = lp->clock;
 
 					busy_N++;
 				}
+				else {
+					sprintf(priv->lbuf, "reg %i" LINK_EOL, reg_ID);
+
+					if (serial_fputs(priv->fd, priv->lbuf) == SERIAL_OK) {
+
+						reg->queued = lp->clock;
+						lp->locked = lp->clock;
+
+						busy_N++;
+					}
+				}
 			}
 
 			if (		(reg->mode & LINK_REG_TYPE_ENUMERATE) != 0
@@ -994,7 +1737,7 @@ void link_push(struct link_pmc *lp)
 		if (reg_ID >= lp->reg_MAX_N)
 			reg_ID = 0;
 
-		if (busy_N > 10)
+		if (busy_N > busy_MAX)
 			break;
 
 		if (reg_ID == priv->reg_push_ID)
@@ -1002,6 +1745,9 @@ void link_push(struct link_pmc *lp)
 	}
 	while (1);
 
+	link_bulk_send(lp, &priv->bulk_write);
+	link_bulk_send(lp, &priv->bulk_read);
+
 	priv->reg_push_ID = reg_ID;
 }
 
@@ -1278,3 +2024,24 @@ void link_grab_file_close(struct link_pmc *lp)
 	}
 }
 
+int link_live_fetch(struct link_pmc *lp, double *row)
+{
+	struct link_priv	*priv = lp->priv;
+	int			N;
+
+	if (lp->linked == 0)
+		return 0;
+
+	if (priv->live_rp == priv->live_wp)
+		return 0;
+
+	for (N = 0; N < lp->live.column_N; ++N) {
+
+		row[N] = priv->live_row[priv->live_rp][N];
+	}
+
+	priv->live_rp = (priv->live_rp < LINK_LIVE_MAX - 1) ? priv->live_rp + 1 : 0;
+
+	return 1;
+}
+
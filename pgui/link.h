@@ -9,6 +9,7 @@
 #define LINK_COMBO_MAX		40
 #define LINK_EPCAN_MAX		32
 #define LINK_FLASH_MAX		10
+#define LINK_LIVE_COLUMN	21
 
 enum {
 	LINK_REG_CONFIG		= 1U,
@@ -69,6 +70,8 @@ struct link_reg {
 
 	int		um_sel;
 	int		primal;
+
+	int		bulk_fmt;
 };
 
 struct link_pmc {
@@ -111,6 +114,19 @@ struct link_pmc {
 	int			line_N;
 	int			grab_N;
 
+	struct {
+
+		int		started;
+		int		column_N;
+		int		reg_ID[LINK_LIVE_COLUMN];
+
+		int		row_N;
+		int		lost_N;
+		int		frame_lost_N;
+		int		overrun_N;
+	}
+	live;
+
 	struct link_reg		reg[LINK_REGS_MAX];
 
 	int			reg_MAX_N;
@@ -137,6 +153,7 @@ void link_config_read(struct link_pmc *lp, const char *file);
 int link_log_file_open(struct link_pmc *lp, const char *file);
 int link_grab_file_open(struct link_pmc *lp, const char *file);
 void link_grab_file_close(struct link_pmc *lp);
+int link_live_fetch(struct link_pmc *lp, double *row);
 
 #endif /* _H_LINK_ */
 
@@ -129,6 +129,8 @@ struct public {
 	struct {
 
 		int			wait_GP;
+		int			wait_BIN;
+		int			live_GP;
 
 		char			file_snap[PHOBIA_PATH_MAX];
 		char			file_grab[PHOBIA_NAME_MAX];
@@ -960,6 +962,8 @@ pub_open_GP(struct public *pub, const char *file)
 
 	pub->gp = gp_Alloc();
 
+	pub->telemetry.live_GP = 0;
+
 	sprintf(pub->lbuf,	"chunk 10\n"
 				"timeout 1000\n"
 				"load 0 0 csv \"%s\"\n"
@@ -973,6 +977,46 @@ pub_open_GP(struct public *pub, const char *file)
 	pub->gp_ID = gp_OpenWindow(pub->gp);
 }
 
+static void
+pub_open_live_GP(struct public *pub)
+{
+	struct link_pmc		*lp = pub->lp;
+	struct link_reg		*reg;
+	int			N;
+
+	if (pub->gp != NULL) {
+
+		gp_Clean(pub->gp);
+	}
+
+	pub->gp = gp_Alloc();
+
+	sprintf(pub->lbuf,	"chunk 10\n"
+				"timeout 1000\n"
+				"load 0 0 stub %i\n", lp->live.column_N);
+
+	gp_TakeConfig(pub->gp, pub->lbuf);
+
+	for (N = 1; N < lp->live.column_N; ++N) {
+
+		reg = &lp->reg[lp->live.reg_ID[N]];
+
+		sprintf(pub->lbuf,	"page \"%.79s\"\n"
+					"label 0 \"time@s\"\n"
+					"figure 0 %i \"%.79s@%.79s\"\n",
+					reg->sym, N, reg->sym, reg->um);
+
+		gp_TakeConfig(pub->gp, pub->lbuf);
+	}
+
+	(void) gp_GetSurface(pub->gp);
+	gp_PageCombine(pub->gp, 1, GP_PAGE_SELECT);
+
+	pub->gp_ID = gp_OpenWindow(pub->gp);
+
+	pub->telemetry.live_GP = 1;
+}
+
 static void
 pub_popup_telemetry_grab(struct public *pub, int popup)
 {
@@ -1017,6 +1061,10 @@ pub_popup_telemetry_grab(struct public *pub, int popup)
 		nk_layout_row_template_push_static(ctx, pub->fe_base);
 		nk_layout_row_template_push_static(ctx, pub->fe_base * 7);
 		nk_layout_row_template_push_static(ctx, pub->fe_base);
+		nk_layout_row_template_push_static(ctx, pub->fe_base * 7);
+		nk_layout_row_template_push_static(ctx, pub->fe_base);
+		nk_layout_row_template_push_static(ctx, pub->fe_base * 7);
+		nk_layout_row_template_push_static(ctx, pub->fe_base);
 		nk_layout_row_template_end(ctx);
 
 		nk_spacer(ctx);
@@ -1045,6 +1093,18 @@ pub_popup_telemetry_grab(struct public *pub, int popup)
 
 		nk_spacer(ctx);
 
+		if (nk_button_label(ctx, "Trigger")) {
+
+			link_command(lp, "tlm_trigger");
+
+			if (reg_tlm != NULL) {
+
+				reg_tlm->lval = 1;
+			}
+		}
+
+		nk_spacer(ctx);
+
 		if (reg_tlm != NULL && reg_tlm->lval == 0) {
 
 			if (nk_button_label(ctx, "Flush GP")) {
@@ -1111,6 +1171,21 @@ pub_popup_telemetry_grab(struct public *pub, int popup)
 
 		nk_spacer(ctx);
 
+		if (nk_button_label(ctx, "Live BIN")) {
+
+			if (link_command(lp, "tlm_live_bin") != 0) {
+
+				pub->telemetry.wait_BIN = 1;
+			}
+
+			if (reg_tlm != NULL) {
+
+				reg_tlm->lval = 1;
+			}
+		}
+
+		nk_spacer(ctx);
+
 		nk_layout_row_dynamic(ctx, pub->fe_base, 1);
 		nk_spacer(ctx);
 
@@ -1271,6 +1346,14 @@ pub_popup_telemetry_grab(struct public *pub, int popup)
 			pub_open_GP(pub, pub->telemetry.file_snap);
 		}
 
+		if (		pub->telemetry.wait_BIN != 0
+				&& lp->live.started != 0) {
+
+			pub->telemetry.wait_BIN = 0;
+
+			pub_open_live_GP(pub);
+		}
+
 		nk_popup_end(ctx);
 	}
 	else {
@@ -3569,6 +3652,7 @@ page_in_network(struct public *pub)
 
 	reg_float(pub, "net.node_ID", "Node network ID");
 	reg_enum_combo(pub, "net.log_MODE", "Messages logging", 1);
+	reg_enum_combo(pub, "net.flow_MODE", "Serial IO flow control", 1);
 	reg_float(pub, "net.timeout_EP", "EP shutdown timeout");
 
 	nk_layout_row_dynamic(ctx, 0, 1);
@@ -3747,6 +3831,23 @@ page_in_network(struct public *pub)
 			reg_float(pub, "net.ep0_rate", "EP 0 frequency");
 			reg_float(pub, "net.ep0_range0", "EP 0 range LOW");
 			reg_float(pub, "net.ep0_range1", "EP 0 range HIGH");
+
+			reg = link_reg_lookup(lp, "net.ep0_PAYLOAD");
+
+			if (reg != NULL && reg->lval >= 2) {
+
+				reg_linked(pub, "net.ep0_pack0_ID", "EP 0 field 1 register ID");
+				reg_float(pub, "net.ep0_pack0_range0", "EP 0 field 1 range LOW");
+				reg_float(pub, "net.ep0_pack0_range1", "EP 0 field 1 range HIGH");
+
+				reg_linked(pub, "net.ep0_pack1_ID", "EP 0 field 2 register ID");
+				reg_float(pub, "net.ep0_pack1_range0", "EP 0 field 2 range LOW");
+				reg_float(pub, "net.ep0_pack1_range1", "EP 0 field 2 range HIGH");
+
+				reg_linked(pub, "net.ep0_pack2_ID", "EP 0 field 3 register ID");
+				reg_float(pub, "net.ep0_pack2_range0", "EP 0 field 3 range LOW");
+				reg_float(pub, "net.ep0_pack2_range1", "EP 0 field 3 range HIGH");
+			}
 		}
 
 		nk_layout_row_dynamic(ctx, 0, 1);
@@ -3770,6 +3871,23 @@ page_in_network(struct public *pub)
 			reg_float(pub, "net.ep1_rate", "EP 1 frequency");
 			reg_float(pub, "net.ep1_range0", "EP 1 range LOW");
 			reg_float(pub, "net.ep1_range1", "EP 1 range HIGH");
+
+			reg = link_reg_lookup(lp, "net.ep1_PAYLOAD");
+
+			if (reg != NULL && reg->lval >= 2) {
+
+				reg_linked(pub, "net.ep1_pack0_ID", "EP 1 field 1 register ID");
+				reg_float(pub, "net.ep1_pack0_range0", "EP 1 field 1 range LOW");
+				reg_float(pub, "net.ep1_pack0_range1", "EP 1 field 1 range HIGH");
+
+				reg_linked(pub, "net.ep1_pack1_ID", "EP 1 field 2 register ID");
+				reg_float(pub, "net.ep1_pack1_range0", "EP 1 field 2 range LOW");
+				reg_float(pub, "net.ep1_pack1_range1", "EP 1 field 2 range HIGH");
+
+				reg_linked(pub, "net.ep1_pack2_ID", "EP 1 field 3 register ID");
+				reg_float(pub, "net.ep1_pack2_range0", "EP 1 field 3 range LOW");
+				reg_float(pub, "net.ep1_pack2_range1", "EP 1 field 3 range HIGH");
+			}
 		}
 
 		nk_layout_row_dynamic(ctx, 0, 1);
@@ -3793,6 +3911,23 @@ page_in_network(struct public *pub)
 			reg_float(pub, "net.ep2_rate", "EP 2 frequency");
 			reg_float(pub, "net.ep2_range0", "EP 2 range LOW");
 			reg_float(pub, "net.ep2_range1", "EP 2 range HIGH");
+
+			reg = link_reg_lookup(lp, "net.ep2_PAYLOAD");
+
+			if (reg != NULL && reg->lval >= 2) {
+
+				reg_linked(pub, "net.ep2_pack0_ID", "EP 2 field 1 register ID");
+				reg_float(pub, "net.ep2_pack0_range0", "EP 2 field 1 range LOW");
+				reg_float(pub, "net.ep2_pack0_range1", "EP 2 field 1 range HIGH");
+
+				reg_linked(pub, "net.ep2_pack1_ID", "EP 2 field 2 register ID");
+				reg_float(pub, "net.ep2_pack1_range0", "EP 2 field 2 range LOW");
+				reg_float(pub, "net.ep2_pack1_range1", "EP 2 field 2 range HIGH");
+
+				reg_linked(pub, "net.ep2_pack2_ID", "EP 2 field 3 register ID");
+				reg_float(pub, "net.ep2_pack2_range0", "EP 2 field 3 range LOW");
+				reg_float(pub, "net.ep2_pack2_range1", "EP 2 field 3 range HIGH");
+			}
 		}
 
 		nk_layout_row_dynamic(ctx, 0, 1);
@@ -3816,6 +3951,23 @@ page_in_network(struct public *pub)
 			reg_float(pub, "net.ep3_rate", "EP 3 frequency");
 			reg_float(pub, "net.ep3_range0", "EP 3 range LOW");
 			reg_float(pub, "net.ep3_range1", "EP 3 range HIGH");
+
+			reg = link_reg_lookup(lp, "net.ep3_PAYLOAD");
+
+			if (reg != NULL && reg->lval >= 2) {
+
+				reg_linked(pub, "net.ep3_pack0_ID", "EP 3 field 1 register ID");
+				reg_float(pub, "net.ep3_pack0_range0", "EP 3 field 1 range LOW");
+				reg_float(pub, "net.ep3_pack0_range1", "EP 3 field 1 range HIGH");
+
+				reg_linked(pub, "net.ep3_pack1_ID", "EP 3 field 2 register ID");
+				reg_float(pub, "net.ep3_pack1_range0", "EP 3 field 2 range LOW");
+				reg_float(pub, "net.ep3_pack1_range1", "EP 3 field 2 range HIGH");
+
+				reg_linked(pub, "net.ep3_pack2_ID", "EP 3 field 3 register ID");
+				reg_float(pub, "net.ep3_pack2_range0", "EP 3 field 3 range LOW");
+				reg_float(pub, "net.ep3_pack2_range1", "EP 3 field 3 range HIGH");
+			}
 		}
 	}
 
@@ -4272,6 +4424,7 @@ page_config(struct public *pub)
 		reg_float(pub, "pm.dc_clearance", "Clearance before ADC sample");
 		reg_float(pub, "pm.dc_skip", "Skip after ADC sample");
 		reg_float(pub, "pm.dc_bootstrap", "Bootstrap retention time");
+		reg_float(pub, "pm.slow_DIV", "Slow stages decimation");
 
 		nk_layout_row_dynamic(ctx, 0, 1);
 		nk_spacer(ctx);
@@ -4294,6 +4447,7 @@ page_config(struct public *pub)
 		reg_enum_toggle(pub, "pm.config_LU_FORCED", "FORCED control");
 		reg_enum_toggle(pub, "pm.config_LU_FREEWHEEL", "Allow FREEWHEELING");
 		reg_enum_combo(pub, "pm.config_LU_ESTIMATE", "SENSORLESS estimate", 1);
+		reg_enum_toggle(pub, "pm.config_KALMAN_STEADY", "KALMAN steady gains");
 		reg_enum_combo(pub, "pm.config_LU_SENSOR", "Position SENSOR type", 1);
 		reg_enum_combo(pub, "pm.config_LU_LOCATION", "Servo LOCATION source", 1);
 		reg_enum_combo(pub, "pm.config_LU_DRIVE", "DRIVE control loop", 0);
@@ -5538,6 +5692,14 @@ page_telemetry(struct public *pub)
 		nk_layout_row_dynamic(ctx, 0, 1);
 		nk_spacer(ctx);
 
+		reg_linked(pub, "tlm.trig_reg_ID", "Trigger register ID");
+		reg_enum_combo(pub, "tlm.trig_MODE", "Trigger condition", 0);
+		reg_float(pub, "tlm.trig_level", "Trigger level");
+		reg_float(pub, "tlm.trig_pre", "Pretrigger depth");
+
+		nk_layout_row_dynamic(ctx, 0, 1);
+		nk_spacer(ctx);
+
 		for (N = 0; N < 20; ++N) {
 
 			sprintf(pub->lbuf, "tlm.reg_ID%d", N);
@@ -5559,6 +5721,12 @@ page_telemetry(struct public *pub)
 					reg->update = 1000;
 				}
 			}
+
+			sprintf(pub->lbuf, "tlm.reg_div%d", N);
+			reg_float(pub, pub->lbuf, "Sampling rate divider");
+
+			sprintf(pub->lbuf, "tlm.reg_pack%d", N);
+			reg_enum_combo(pub, pub->lbuf, "Storage packing", 0);
 		}
 
 		nk_layout_row_dynamic(ctx, 0, 1);
@@ -6015,6 +6183,17 @@ int main(int argc, char **argv)
 			nk->active = 1;
 		}
 
+		if (		pub->gp != NULL
+				&& pub->telemetry.live_GP != 0) {
+
+			double		row[LINK_LIVE_COLUMN];
+
+			while (link_live_fetch(lp, row) != 0) {
+
+				(void) gp_DataAdd(pub->gp, 0, row);
+			}
+		}
+
 		if (nk->active != 0) {
 
 			nk->idled = 0;
@@ -6126,6 +6305,7 @@ int main(int argc, char **argv)
 				gp_Clean(pub->gp);
 
 				pub->gp = NULL;
+				pub->telemetry.live_GP = 0;
 			}
 
 			SDL_Delay(10);
@@ -175,6 +175,28 @@ async_fgets(struct async_priv *ap, char *sbuf, int n)
 	}
 }
 
+static int
+async_read(struct async_priv *ap, char *b, int n)
+{
+	int		cq, nq = 0;
+
+	while (nq < n) {
+
+		cq = async_getc(ap);
+
+		if (cq == SERIAL_ASYNC_WAIT)
+			break;
+
+		b[nq++] = (char) cq;
+	}
+
+	/* Forget the partial line scanned by async_fgets.
+	 * */
+	ap->cached = -1;
+
+	return nq;
+}
+
 static int
 async_space_available(struct async_priv *ap)
 {
@@ -799,3 +821,8 @@ int serial_fgets(struct serial_fd *fd, char *s, int n)
 	return async_fgets(fd->rxq, s, n);
 }
 
+int serial_fread(struct serial_fd *fd, void *b, int n)
+{
+	return async_read(fd->rxq, (char *) b, n);
+}
+
@@ -9,6 +9,42 @@
 #include "regfile.h"
 #include "shell.h"
 
+/* Serial IO is segmented into frames that begin with the sequence number
+ * (SN) and carry up to 7 bytes. The receiver replies with flow control that
+ * holds the next expected SN and the number of frames it is ready to take.
+ * */
+#define EPCAN_FLOW_PAYLOAD		7
+#define EPCAN_PLAIN_PAYLOAD		8
+#define EPCAN_FLOW_WINDOW		8
+#define EPCAN_FLOW_WINDOW_MAX		16
+#define EPCAN_FLOW_BLOCK		4
+
+/* Period of window probe and the timeout after which we think the receiver
+ * is gone (in ticks).
+ * */
+#define EPCAN_FLOW_PROBE		2
+#define EPCAN_FLOW_TIMEOUT		100
+
+typedef struct {
+
+	volatile uint8_t	seq;		/* SN of the next frame */
+	volatile uint8_t	ack;		/* SN expected by receiver */
+	volatile uint8_t	window;		/* frames allowed after ack */
+
+	volatile int		reply_N;
+}
+epcan_flow_tx_t;
+
+typedef struct {
+
+	uint8_t			seq;		/* SN we expect */
+
+	int			sync;
+	int			block_N;
+	int			lost_N;
+}
+epcan_flow_rx_t;
+
 typedef struct {
 
 	uint32_t		UID;
@@ -37,7 +73,23 @@ typedef struct {
 	 * */
 	int			remote_node_ID;
 
-	/* TX pause notice (flow control).
+	/* Flow control of serial IO.
+	 * */
+	epcan_flow_tx_t		tx_flow;
+	epcan_flow_rx_t		rx_flow;
+
+	epcan_flow_tx_t		remote_tx_flow;
+	epcan_flow_rx_t		remote_rx_flow;
+
+	/* Bytes taken from TX queue that are not yet sent.
+	 * */
+	volatile int		tx_pending;
+
+	/* Serializes frames of node TX as they are numbered.
+	 * */
+	SemaphoreHandle_t	tx_mutex;
+
+	/* TX pause notice (plain flow).
 	 * */
 	int			flow_tx_paused;
 
@@ -58,70 +110,158 @@ epcan_t				net;
 
 static epcan_local_t		local;
 
-static void
-EPCAN_pipe_INCOMING(epcan_pipe_t *ep, const CAN_msg_t *msg)
+static int
+EPCAN_pipe_fields(const epcan_pipe_t *ep, int *size)
 {
+	int			fields = 0;
+
 	switch (ep->PAYLOAD) {
 
 		case EPCAN_PAYLOAD_FLOAT:
 
-			if (msg->len == 4) {
-
-				ep->reg_DATA = ep->range[1] * msg->payload.f[0] + ep->range[0];
-			}
+			*size = 4;
+			fields = 1;
 			break;
 
 		case EPCAN_PAYLOAD_INT_16:
 
-			if (msg->len == 2) {
+			*size = 2;
+			fields = 1;
+			break;
 
-				ep->reg_DATA = ep->range[0] + (float) msg->payload.s[0]
-					* (ep->range[1] - ep->range[0]) * (1.f / 65535.f);
-			}
+		case EPCAN_PAYLOAD_PACK_FLOAT:
+
+			*size = 4;
+			fields = sizeof(((CAN_msg_t *) 0)->payload) / 4;
+			break;
+
+		case EPCAN_PAYLOAD_PACK_INT_16:
+
+			*size = 2;
+			fields = sizeof(((CAN_msg_t *) 0)->payload) / 2;
 			break;
 
 		default: break;
 	}
 
-	if (ep->reg_ID != ID_NULL) {
+	fields = (fields < EPCAN_PACK_MAX + 1) ? fields : EPCAN_PACK_MAX + 1;
+
+	return fields;
+}
+
+static int
+EPCAN_pipe_field(epcan_pipe_t *ep, int N, float **range)
+{
+	if (N == 0) {
+
+		*range = ep->range;
+
+		return ep->reg_ID;
+	}
+	else {
+		*range = ep->pack_range[N - 1];
 
-		reg_SET_F(ep->reg_ID, ep->reg_DATA);
+		return ep->pack_ID[N - 1];
 	}
 }
 
 static void
-EPCAN_pipe_OUTGOING(epcan_pipe_t *ep)
+EPCAN_pipe_INCOMING(epcan_pipe_t *ep, const CAN_msg_t *msg)
 {
-	CAN_msg_t		msg;
+	float			*range, fval;
+	int			N, size, fields, reg_ID;
+
+	fields = EPCAN_pipe_fields(ep, &size);
 
-	if (ep->reg_ID != ID_NULL) {
+	if (fields == 1 && msg->len != size) {
 
-		ep->reg_DATA = reg_GET_F(ep->reg_ID);
+		/* Single value must fill the frame exactly.
+		 * */
+		return ;
 	}
 
+	for (N = 0; N < fields && (N + 1) * size <= msg->len; ++N) {
+
+		reg_ID = EPCAN_pipe_field(ep, N, &range);
+
+		if (size == 4) {
+
+			fval = range[1] * msg->payload.f[N] + range[0];
+		}
+		else {
+			fval = range[0] + (float) msg->payload.s[N]
+				* (range[1] - range[0]) * (1.f / 65535.f);
+		}
+
+		if (N == 0) {
+
+			ep->reg_DATA = fval;
+		}
+
+		if (reg_ID != ID_NULL) {
+
+			reg_SET_F(reg_ID, fval);
+		}
+	}
+}
+
+static void
+EPCAN_pipe_OUTGOING(epcan_pipe_t *ep)
+{
+	CAN_msg_t		msg;
+	float			*range, fval;
+	int			N, size, fields, reg_ID;
+
+	fields = EPCAN_pipe_fields(ep, &size);
+
 	msg.ID = ep->ID;
+	msg.len = 0;
 
-	switch (ep->PAYLOAD) {
+	for (N = 0; N < fields; ++N) {
 
-		float			fval;
+		reg_ID = EPCAN_pipe_field(ep, N, &range);
 
-		case EPCAN_PAYLOAD_FLOAT:
+		if (N == 0) {
 
-			msg.len = 4;
-			msg.payload.f[0] = ep->range[1] * ep->reg_DATA + ep->range[0];
-			break;
+			if (reg_ID != ID_NULL) {
 
-		case EPCAN_PAYLOAD_INT_16:
+				ep->reg_DATA = reg_GET_F(reg_ID);
+			}
+
+			fval = ep->reg_DATA;
+		}
+		else if (reg_ID != ID_NULL) {
 
-			msg.len = 2;
+			fval = reg_GET_F(reg_ID);
+		}
+		else {
+			/* Unused field is sent as zero.
+			 * */
+			if (size == 4) {
 
-			fval = (ep->reg_DATA - ep->range[0]) / (ep->range[1] - ep->range[0]);
+				msg.payload.l[N] = 0U;
+			}
+			else {
+				msg.payload.s[N] = 0U;
+			}
+
+			continue;
+		}
+
+		if (size == 4) {
+
+			msg.payload.f[N] = range[1] * fval + range[0];
+		}
+		else {
+			fval = (fval - range[0]) / (range[1] - range[0]);
 			fval = (fval < 0.f) ? 0.f : (fval > 1.f) ? 1.f : fval;
 
-			msg.payload.s[0] = (uint16_t) (fval * 65535.f);
-			break;
+			msg.payload.s[N] = (uint16_t) (fval * 65535.f);
+		}
 
-		default: break;
+		/* We do not send the unused fields at the end.
+		 * */
+		msg.len = (N + 1) * size;
 	}
 
 	if (CAN_send_msg(&msg) == HAL_OK) {
@@ -543,6 +683,168 @@ EPCAN_remote_node_REQ(int node_REQ)
 	EPCAN_send_msg(&msg);
 }
 
+static int
+EPCAN_flow_payload()
+{
+	return (net.flow_MODE == EPCAN_FLOW_WINDOWED)
+		? EPCAN_FLOW_PAYLOAD : EPCAN_PLAIN_PAYLOAD;
+}
+
+static void
+EPCAN_flow_reset(epcan_flow_tx_t *tx)
+{
+	tx->ack = tx->seq;
+	tx->window = EPCAN_FLOW_WINDOW;
+}
+
+static void
+EPCAN_flow_update(epcan_flow_tx_t *tx, const CAN_msg_t *msg)
+{
+	tx->ack = msg->payload.b[1];
+	tx->window = msg->payload.b[2];
+	tx->reply_N += 1;
+}
+
+static void
+EPCAN_flow_wait(epcan_flow_tx_t *tx, int ID)
+{
+	CAN_msg_t		msg;
+	int			reply_N, wait_N = 0;
+
+	reply_N = tx->reply_N;
+
+	while ((uint8_t) (tx->seq - tx->ack) >= tx->window) {
+
+		vTaskDelay((TickType_t) 1);
+
+		if (reply_N != tx->reply_N) {
+
+			/* Receiver is alive but has no space for now.
+			 * */
+			reply_N = tx->reply_N;
+			wait_N = 0;
+		}
+
+		wait_N++;
+
+		if (wait_N >= EPCAN_FLOW_TIMEOUT) {
+
+			/* No reply so we think the receiver is gone.
+			 * */
+			EPCAN_flow_reset(tx);
+			break;
+		}
+
+		if (wait_N % EPCAN_FLOW_PROBE == 0) {
+
+			/* Empty frame asks the receiver for window update.
+			 * */
+			msg.ID = ID;
+			msg.len = 1;
+
+			msg.payload.b[0] = tx->seq;
+
+			EPCAN_send_msg(&msg);
+		}
+	}
+}
+
+static void
+EPCAN_flow_send(epcan_flow_tx_t *tx, int ID, const char *b, int len)
+{
+	CAN_msg_t		msg;
+
+	if (net.flow_MODE != EPCAN_FLOW_WINDOWED) {
+
+		/* Plain frame without SN.
+		 * */
+		msg.ID = ID;
+		msg.len = len;
+
+		memcpy(&msg.payload.b[0], b, len);
+
+		EPCAN_send_msg(&msg);
+		return ;
+	}
+
+	EPCAN_flow_wait(tx, ID);
+
+	msg.ID = ID;
+	msg.len = len + 1;
+
+	msg.payload.b[0] = tx->seq;
+
+	memcpy(&msg.payload.b[1], b, len);
+
+	if (EPCAN_send_msg(&msg) == HAL_OK) {
+
+		tx->seq += 1;
+	}
+}
+
+static void
+EPCAN_flow_receive(epcan_flow_rx_t *rx, QueueHandle_t queue,
+		const CAN_msg_t *msg, int fc_ID, int fc_code)
+{
+	CAN_msg_t		fc;
+	uint8_t			seq;
+	int			N, window;
+
+	if (net.flow_MODE != EPCAN_FLOW_WINDOWED) {
+
+		for (N = 0; N < msg->len; ++N) {
+
+			xQueueSendToBack(queue, &msg->payload.b[N], (TickType_t) 0);
+		}
+
+		return ;
+	}
+
+	if (msg->len < 1)
+		return ;
+
+	seq = msg->payload.b[0];
+
+	if (msg->len > 1) {
+
+		if (rx->sync != 0 && seq != rx->seq) {
+
+			rx->lost_N += (uint8_t) (seq - rx->seq);
+		}
+
+		for (N = 1; N < msg->len; ++N) {
+
+			xQueueSendToBack(queue, &msg->payload.b[N], (TickType_t) 0);
+		}
+
+		rx->block_N += 1;
+	}
+
+	/* Probe also brings us SN to expect.
+	 * */
+	rx->seq = (msg->len > 1) ? seq + 1 : seq;
+	rx->sync = 1;
+
+	window = uxQueueSpacesAvailable(queue) / EPCAN_FLOW_PAYLOAD;
+	window = (window < EPCAN_FLOW_WINDOW_MAX) ? window : EPCAN_FLOW_WINDOW_MAX;
+
+	if (		msg->len == 1
+			|| rx->block_N >= EPCAN_FLOW_BLOCK
+			|| window <= EPCAN_FLOW_BLOCK) {
+
+		fc.ID = fc_ID;
+		fc.len = 3;
+
+		fc.payload.b[0] = fc_code;
+		fc.payload.b[1] = rx->seq;
+		fc.payload.b[2] = window;
+
+		EPCAN_send_msg(&fc);
+
+		rx->block_N = 0;
+	}
+}
+
 static void
 EPCAN_node_DATA(int reg_ID)
 {
@@ -561,8 +863,6 @@ EPCAN_node_DATA(int reg_ID)
 static void
 EPCAN_message_IN(const CAN_msg_t *msg)
 {
-	int			N;
-
 	/* Network functions.
 	 * */
 	if (		msg->ID == EPCAN_ID_NET_SURVEY
@@ -598,6 +898,11 @@ EPCAN_message_IN(const CAN_msg_t *msg)
 
 			local.flow_tx_paused = 1;
 		}
+		else if (	msg->payload.b[0] == EPCAN_REQ_FLOW_CONTROL
+				&& msg->len == 3) {
+
+			EPCAN_flow_update(&local.tx_flow, msg);
+		}
 	}
 	else if (	EPCAN_GET_FUNC(msg->ID) == EPCAN_NODE_ACK
 			&& EPCAN_GET_NODE(msg->ID) > 0U
@@ -608,6 +913,14 @@ EPCAN_message_IN(const CAN_msg_t *msg)
 
 			local_node_insert(msg->payload.l[0], msg->payload.b[5]);
 		}
+		else if (	msg->payload.b[0] == EPCAN_ACK_FLOW_CONTROL
+				&& msg->len == 3) {
+
+			if (EPCAN_GET_NODE(msg->ID) == local.remote_node_ID) {
+
+				EPCAN_flow_update(&local.remote_tx_flow, msg);
+			}
+		}
 		else if (msg->len == 2) {
 
 			local_node_update_ACK(msg->payload.b[1], msg->payload.b[0]);
@@ -615,23 +928,22 @@ EPCAN_message_IN(const CAN_msg_t *msg)
 	}
 	else if (msg->ID == EPCAN_ID(net.node_ID, EPCAN_NODE_RX)) {
 
-		for (N = 0; N < msg->len; ++N) {
-
-			xQueueSendToBack(local.rx_queue, &msg->payload.b[N], (TickType_t) 0);
-		}
+		EPCAN_flow_receive(&local.rx_flow, local.rx_queue, msg,
+				EPCAN_ID(net.node_ID, EPCAN_NODE_ACK),
+				EPCAN_ACK_FLOW_CONTROL);
 
 		IODEF_TO_CAN();
 	}
 	else if (msg->ID == EPCAN_ID(local.remote_node_ID, EPCAN_NODE_TX)) {
 
-		for (N = 0; N < msg->len; ++N) {
-
-			/* Remote NODE output via LOG.
-			 * */
-			EPCAN_log_putc(msg->payload.b[N]);
-		}
+		/* Remote NODE output via LOG.
+		 * */
+		EPCAN_flow_receive(&local.remote_rx_flow, local.log_queue, msg,
+				EPCAN_ID(local.remote_node_ID, EPCAN_NODE_REQ),
+				EPCAN_REQ_FLOW_CONTROL);
 
-		if (uxQueueSpacesAvailable(local.log_queue) < 20) {
+		if (		net.flow_MODE != EPCAN_FLOW_WINDOWED
+				&& uxQueueSpacesAvailable(local.log_queue) < 20) {
 
 			/* Notify remote node about overflow.
 			 * */
@@ -674,40 +986,47 @@ LD_TASK void task_EPCAN_IN(void *pData)
 
 LD_TASK void task_EPCAN_TX(void *pData)
 {
-	CAN_msg_t		msg;
-	char			xbyte;
+	char			xbuf[EPCAN_PLAIN_PAYLOAD];
+	int			len, len_max;
 
 	do {
-		msg.len = 0;
+		if (xQueueReceive(local.tx_queue, &xbuf[0], portMAX_DELAY) == pdTRUE) {
 
-		while (xQueueReceive(local.tx_queue, &xbyte, (TickType_t) 10) == pdTRUE) {
+			/* We run above the shell priority so the flag is set
+			 * before the writer can see the queue empty.
+			 * */
+			local.tx_pending = 1;
 
-			msg.payload.b[msg.len++] = xbyte;
+			len_max = EPCAN_flow_payload();
+			len = 1;
 
-			if (msg.len >= 8) {
+			while (len < len_max) {
 
-				break;
+				if (xQueueReceive(local.tx_queue, &xbuf[len],
+							(TickType_t) 1) != pdTRUE)
+					break;
+
+				len++;
 			}
-		}
 
-		if (msg.len > 0) {
+			xSemaphoreTake(local.tx_mutex, portMAX_DELAY);
 
-			msg.ID = EPCAN_ID(net.node_ID, EPCAN_NODE_TX);
+			EPCAN_flow_send(&local.tx_flow, EPCAN_ID(net.node_ID,
+						EPCAN_NODE_TX), xbuf, len);
 
-			EPCAN_send_msg(&msg);
+			xSemaphoreGive(local.tx_mutex);
 
-			/* Do not send messages too frequently
-			 * especially if you were asked to.
-			 * */
-			if (local.flow_tx_paused != 0) {
+			local.tx_pending = 0;
 
-				vTaskDelay((TickType_t) 10);
+			if (net.flow_MODE != EPCAN_FLOW_WINDOWED) {
+
+				/* Do not send messages too frequently
+				 * especially if you were asked to.
+				 * */
+				vTaskDelay((TickType_t) ((local.flow_tx_paused != 0) ? 10 : 1));
 
 				local.flow_tx_paused = 0;
 			}
-			else {
-				vTaskDelay((TickType_t) 1);
-			}
 		}
 	}
 	while (1);
@@ -724,6 +1043,54 @@ void EPCAN_putc(int c)
 	GPIO_set_LOW(GPIO_LED_ALERT);
 }
 
+void EPCAN_write(const void *b, int len)
+{
+	const char	*xb = (const char *) b;
+	int		N;
+
+	if (net.flow_MODE != EPCAN_FLOW_WINDOWED) {
+
+		/* Plain frames are paced by TX task.
+		 * */
+		while (len > 0) {
+
+			EPCAN_putc(*xb++);
+			len--;
+		}
+
+		return ;
+	}
+
+	GPIO_set_HIGH(GPIO_LED_ALERT);
+
+	/* Wait for the queued bytes to go first.
+	 * */
+	while (		uxQueueMessagesWaiting(local.tx_queue) != 0
+			|| local.tx_pending != 0) {
+
+		vTaskDelay((TickType_t) 1);
+	}
+
+	/* Then we send frames directly from the block.
+	 * */
+	xSemaphoreTake(local.tx_mutex, portMAX_DELAY);
+
+	while (len > 0) {
+
+		N = (len < EPCAN_FLOW_PAYLOAD) ? len : EPCAN_FLOW_PAYLOAD;
+
+		EPCAN_flow_send(&local.tx_flow, EPCAN_ID(net.node_ID,
+					EPCAN_NODE_TX), xb, N);
+
+		xb += N;
+		len -= N;
+	}
+
+	xSemaphoreGive(local.tx_mutex);
+
+	GPIO_set_LOW(GPIO_LED_ALERT);
+}
+
 extern QueueHandle_t USART_public_rx_queue();
 
 void EPCAN_startup()
@@ -741,9 +1108,12 @@ void EPCAN_startup()
 	local.log_queue = xQueueCreate(320, sizeof(char));
 	local.net_queue = xQueueCreate(10, sizeof(int));
 
+	EPCAN_flow_reset(&local.tx_flow);
+
 	/* Allocate semaphore.
 	 * */
 	local.log_mutex = xSemaphoreCreateMutex();
+	local.tx_mutex = xSemaphoreCreateMutex();
 
 	/* Create EPCAN tasks.
 	 * */
@@ -924,27 +1294,26 @@ SH_DEF(net_revoke)
 
 LD_TASK void task_epcan_REMOTE(void *pData)
 {
-	CAN_msg_t		msg;
-	int			xbyte;
+	char			xbuf[EPCAN_PLAIN_PAYLOAD];
+	int			len, len_max;
 
 	do {
-		msg.len = 0;
+		if (xQueueReceive(local.remote_queue, &xbuf[0], portMAX_DELAY) == pdTRUE) {
 
-		while (xQueueReceive(local.remote_queue, &xbyte, (TickType_t) 10) == pdTRUE) {
+			len_max = EPCAN_flow_payload();
+			len = 1;
 
-			msg.payload.b[msg.len++] = xbyte;
+			while (len < len_max) {
 
-			if (msg.len >= 8) {
+				if (xQueueReceive(local.remote_queue, &xbuf[len],
+							(TickType_t) 1) != pdTRUE)
+					break;
 
-				break;
+				len++;
 			}
-		}
-
-		if (msg.len > 0) {
 
-			msg.ID = EPCAN_ID(local.remote_node_ID, EPCAN_NODE_RX);
-
-			EPCAN_send_msg(&msg);
+			EPCAN_flow_send(&local.remote_tx_flow, EPCAN_ID(local.remote_node_ID,
+						EPCAN_NODE_RX), xbuf, len);
 		}
 	}
 	while (1);
@@ -983,6 +1352,11 @@ SH_DEF(net_node_remote)
 
 	if (local.remote_node_ID != 0) {
 
+		EPCAN_flow_reset(&local.remote_tx_flow);
+
+		local.remote_rx_flow.sync = 0;
+		local.remote_rx_flow.lost_N = 0;
+
 		/* Do listen to incoming messages from remote node.
 		 * */
 		CAN_bind_ID(4, 0, EPCAN_ID(local.remote_node_ID, EPCAN_NODE_TX), EPCAN_FILTER_MATCH);
@@ -1018,6 +1392,12 @@ SH_DEF(net_node_remote)
 		/* Do pretty line feed.
 		 * */
 		puts(EOL);
+
+		if (local.remote_rx_flow.lost_N != 0) {
+
+			printf("Lost %i frames from remote node" EOL,
+					local.remote_rx_flow.lost_N);
+		}
 	}
 }
 #endif /* HW_HAVE_NETWORK_EPCAN */
@@ -34,12 +34,14 @@ enum {
 
 enum {
 	EPCAN_REQ_NOTHING		= 0,
-	EPCAN_REQ_FLOW_TX_PAUSE			/* node flow control */
+	EPCAN_REQ_FLOW_TX_PAUSE,		/* node flow control */
+	EPCAN_REQ_FLOW_CONTROL			/* window of node TX */
 };
 
 enum {
 	EPCAN_ACK_NOTHING		= 0,
-	EPCAN_ACK_NETWORK_REPLY			/* reply to network survey */
+	EPCAN_ACK_NETWORK_REPLY,		/* reply to network survey */
+	EPCAN_ACK_FLOW_CONTROL			/* window of node RX */
 };
 
 enum {
@@ -48,6 +50,11 @@ enum {
 	EPCAN_LOG_PROMISCUOUS
 };
 
+enum {
+	EPCAN_FLOW_DISABLED		= 0,	/* plain frames of serial IO */
+	EPCAN_FLOW_WINDOWED			/* numbered frames with window */
+};
+
 enum {
 	EPCAN_PIPE_DISABLED		= 0,
 	EPCAN_PIPE_INCOMING,
@@ -57,11 +64,19 @@ enum {
 
 enum {
 	EPCAN_PAYLOAD_FLOAT		= 0,
-	EPCAN_PAYLOAD_INT_16
+	EPCAN_PAYLOAD_INT_16,
+	EPCAN_PAYLOAD_PACK_FLOAT,		/* 2 x float in one frame */
+	EPCAN_PAYLOAD_PACK_INT_16		/* 4 x int16 in one frame */
 };
 
 enum {
 	EPCAN_PIPE_MAX			= 4,
+
+	/* Number of packed fields after the first one. The number of fields
+	 * that fit into the frame is taken from CAN payload size so with FD
+	 * layout this only needs to be increased.
+	 * */
+	EPCAN_PACK_MAX			= 3
 };
 
 typedef struct {
@@ -80,6 +95,9 @@ typedef struct {
 	int		rate;		/* transfer rate */
 	float		range[2];	/* natural data range */
 
+	int		pack_ID[EPCAN_PACK_MAX];	/* packed register IDs */
+	float		pack_range[EPCAN_PACK_MAX][2];
+
 	int		tx_clock;
 	int		tx_flag;
 }
@@ -89,6 +107,7 @@ typedef struct {
 
 	int			node_ID;	/* EPCAN node ID */
 	int			log_MODE;
+	int			flow_MODE;
 	int			timeout_EP;
 
 	epcan_pipe_t		ep[EPCAN_PIPE_MAX];
@@ -100,6 +119,7 @@ extern epcan_t			net;
 void EPCAN_pipe_REGULAR();
 
 void EPCAN_putc(int c);
+void EPCAN_write(const void *b, int len);
 
 void EPCAN_startup();
 void EPCAN_bind();
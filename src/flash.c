@@ -10,10 +10,31 @@
 
 #define REGS_SYM_MAX				79
 
+#define FLASH_BLOCK_MAGIC			0x34434D50U
+#define FLASH_BLOCK_MAGIC_NAMED			0x33434D50U
+#define FLASH_CONTENT_MAX			4094
+#define FLASH_HEAD_MAX				8
+#define FLASH_NAME_MAX				16
+
+/* Live blocks of other profiles are moved out of the sector before it is
+ * erased so the number of profiles is limited by the sector size.
+ * */
+#define FLASH_PROFILE_MAX			6
+
+/* Configuration block begins with the magic, the hash of register layout,
+ * the number of packed values, the profile number and its name. Then go
+ * the packed values of REG_CONFIG registers in the order of regfile and the
+ * hashes of their symbolic names to load them into the firmware of different
+ * register layout. At last we have the number of linked registers and pairs
+ * of hashes of the linked register name and the name it is linked to.
+ *
+ * Blocks of previous formats keep the values by full symbolic names. We are
+ * only able to read them.
+ * */
 typedef struct {
 
 	uint32_t		number;
-	uint32_t		content[4094];
+	uint32_t		content[FLASH_CONTENT_MAX];
 	uint32_t		crc32;
 }
 flash_block_t;
@@ -33,6 +54,10 @@ typedef struct {
 }
 flash_prog_t;
 
+typedef void (* flash_apply_t) (const reg_t *reg, uint32_t lval);
+
+static int			flash_changed_N;
+
 static int
 flash_prog_u8(flash_prog_t *pg, uint8_t u)
 {
@@ -58,7 +83,7 @@ flash_prog_u8(flash_prog_t *pg, uint8_t u)
 	return rc;
 }
 
-static void
+static int
 flash_prog_u32(flash_prog_t *pg, uint32_t l)
 {
 	union {
@@ -70,7 +95,8 @@ flash_prog_u32(flash_prog_t *pg, uint32_t l)
 	flash_prog_u8(pg, packed.b[0]);
 	flash_prog_u8(pg, packed.b[1]);
 	flash_prog_u8(pg, packed.b[2]);
-	flash_prog_u8(pg, packed.b[3]);
+
+	return flash_prog_u8(pg, packed.b[3]);
 }
 
 static const char *
@@ -104,8 +130,24 @@ flash_block_crc32(const flash_block_t *block)
 	return crc32u(block, sizeof(flash_block_t) - sizeof(uint32_t));
 }
 
+static int
+flash_block_is_headed(const flash_block_t *block)
+{
+	return (	   block->content[0] == FLASH_BLOCK_MAGIC
+			|| block->content[0] == FLASH_BLOCK_MAGIC_NAMED) ? 1 : 0;
+}
+
+static int
+flash_block_profile(const flash_block_t *block)
+{
+	/* Block without header belongs to the default profile.
+	 * */
+	return (flash_block_is_headed(block) != 0)
+		? (int) block->content[3] : 0;
+}
+
 static flash_block_t *
-flash_block_scan()
+flash_block_scan(int profile)
 {
 	flash_block_t		*block, *last;
 
@@ -113,7 +155,9 @@ flash_block_scan()
 	last = NULL;
 
 	do {
-		if (flash_block_crc32(block) == block->crc32) {
+		if (		flash_block_crc32(block) == block->crc32
+				&& (	   profile < 0
+					|| flash_block_profile(block) == profile)) {
 
 			if (last != NULL) {
 
@@ -135,25 +179,284 @@ flash_block_scan()
 	return last;
 }
 
-int flash_block_regs_load()
+static int
+flash_block_is_live(const flash_block_t *block)
 {
-	const flash_block_t	*block;
-	const reg_t		*reg, *linked;
+	return (	   flash_block_crc32(block) == block->crc32
+			&& flash_block_scan(flash_block_profile(block)) == block)
+		? 1 : 0;
+}
+
+static uint32_t
+flash_layout_hash()
+{
+	const reg_t		*reg;
 	const char		*lsym;
+	uint32_t		hash = 2166136261U;
 
-	char			symbuf[REGS_SYM_MAX + 1];
-	int			rc = 0;
+	/* We hash the symbolic names of all registers as linked registers
+	 * are stored by ID.
+	 * */
+	for (reg = regfile; reg->sym != NULL; ++reg) {
 
-	block = flash_block_scan();
+		for (lsym = reg->sym; *lsym != 0; ++lsym) {
 
-	if (block == NULL) {
+			hash = (hash ^ (uint8_t) *lsym) * 16777619U;
+		}
 
-		/* No valid configuration block found.
+		hash = (hash ^ (uint32_t) (reg->mode & (REG_CONFIG | REG_LINKED)))
+			* 16777619U;
+	}
+
+	return hash;
+}
+
+static uint32_t
+flash_sym_hash(const char *sym)
+{
+	uint32_t		hash = 2166136261U;
+
+	while (*sym != 0) {
+
+		hash = (hash ^ (uint8_t) *sym++) * 16777619U;
+	}
+
+	return hash;
+}
+
+static int
+flash_config_count()
+{
+	const reg_t		*reg;
+	int			count = 0;
+
+	for (reg = regfile; reg->sym != NULL; ++reg) {
+
+		if (reg->mode & REG_CONFIG) {
+
+			count++;
+		}
+	}
+
+	return count;
+}
+
+static void
+flash_reg_assign(const reg_t *reg, uint32_t lval)
+{
+	reg->link->i = (int) lval;
+}
+
+static void
+flash_reg_update(const reg_t *reg, uint32_t lval)
+{
+	rval_t			rval;
+	int			reg_ID, kept;
+
+	if ((uint32_t) reg->link->i != lval) {
+
+		kept = reg->link->i;
+		reg->link->i = (int) lval;
+
+		if (reg->proc != NULL) {
+
+			reg_ID = (int) (reg - regfile);
+
+			/* We write the value through register proc as from the
+			 * shell to keep derived and hardware state in sync. The
+			 * stored value is in link units so we get it back by proc.
+			 * */
+			reg_GET(reg_ID, &rval);
+
+			reg->link->i = kept;
+
+			reg_SET(reg_ID, &rval);
+		}
+
+		flash_changed_N++;
+	}
+}
+
+static int
+flash_reg_is_startup(const reg_t *reg)
+{
+	/* These registers have no proc and are only read on startup.
+	 * */
+	return (	   reg->proc == NULL
+			&& strcmpn(reg->sym, "hal.USART_", 10) == 10) ? 1 : 0;
+}
+
+static void
+flash_reg_startup(const reg_t *reg, uint32_t lval)
+{
+	if (		(uint32_t) reg->link->i != lval
+			&& flash_reg_is_startup(reg) != 0) {
+
+		printf("%s takes effect after reboot" EOL, reg->sym);
+	}
+}
+
+static void
+flash_reg_format(const reg_t *reg, uint32_t lval)
+{
+	rval_t			rval;
+
+	rval.i = (int) lval;
+
+	if (reg->format != NULL) {
+
+		reg->format(reg, &rval);
+	}
+	else {
+		reg_format_rval(reg, &rval);
+
+		if (reg->mode & REG_LINKED) {
+
+			/* Linked ID is known to be valid as it was stored or
+			 * found with the same register layout.
+			 * */
+			printf(" (%s)", regfile[rval.i].sym);
+		}
+	}
+}
+
+static void
+flash_reg_diff(const reg_t *reg, uint32_t lval)
+{
+	if ((uint32_t) reg->link->i != lval) {
+
+		printf("%s = ", reg->sym);
+
+		flash_reg_format(reg, (uint32_t) reg->link->i);
+
+		puts(" -> ");
+
+		flash_reg_format(reg, lval);
+
+		puts(EOL);
+
+		flash_changed_N++;
+	}
+}
+
+static int
+flash_block_regs_packed(const uint32_t *lval, flash_apply_t apply)
+{
+	const reg_t		*reg;
+
+	for (reg = regfile; reg->sym != NULL; ++reg) {
+
+		if (reg->mode & REG_CONFIG) {
+
+			apply(reg, *lval++);
+		}
+	}
+
+	return 0;
+}
+
+static const reg_t *
+flash_reg_search_hash(uint32_t hash)
+{
+	const reg_t		*reg;
+
+	for (reg = regfile; reg->sym != NULL; ++reg) {
+
+		if (flash_sym_hash(reg->sym) == hash)
+			break;
+	}
+
+	return (reg->sym != NULL) ? reg : NULL;
+}
+
+static const uint32_t *
+flash_linked_search(const uint32_t *llink, int linked_N, uint32_t hash)
+{
+	int			N;
+
+	for (N = 0; N < linked_N; ++N) {
+
+		if (llink[N * 2] == hash)
+			return llink + N * 2 + 1;
+	}
+
+	return NULL;
+}
+
+static int
+flash_block_regs_hashed(const uint32_t *content, int count, flash_apply_t apply)
+{
+	const reg_t		*reg, *linked;
+	const uint32_t		*lval, *lhash, *llink, *lname;
+
+	uint32_t		hash;
+	int			N, index, linked_N;
+
+	lval = content + FLASH_HEAD_MAX;
+	lhash = lval + count;
+	linked_N = (int) lhash[count];
+	llink = lhash + count + 1;
+
+	if (		linked_N < 0
+			|| linked_N > (FLASH_CONTENT_MAX - FLASH_HEAD_MAX
+				- count * 2 - 1) / 2) {
+
+		return 1;
+	}
+
+	index = 0;
+
+	for (reg = regfile; reg->sym != NULL; ++reg) {
+
+		if ((reg->mode & REG_CONFIG) == 0)
+			continue;
+
+		hash = flash_sym_hash(reg->sym);
+
+		/* Search goes on from the previous match as the order of
+		 * registers is mostly kept between firmware versions.
 		 * */
-		return rc;
+		for (N = 0; N < count; ++N) {
+
+			if (lhash[index] == hash)
+				break;
+
+			index = (index < count - 1) ? index + 1 : 0;
+		}
+
+		if (N >= count)
+			continue;
+
+		lname = flash_linked_search(llink, linked_N, hash);
+
+		if (reg->mode & REG_LINKED) {
+
+			linked = (lname != NULL) ? flash_reg_search_hash(*lname) : NULL;
+
+			if (linked != NULL) {
+
+				apply(reg, (uint32_t) (linked - regfile));
+			}
+		}
+		else if (lname == NULL) {
+
+			apply(reg, lval[index]);
+		}
+
+		index = (index < count - 1) ? index + 1 : 0;
 	}
 
-	lsym = (const char *) block->content;
+	return 0;
+}
+
+static int
+flash_block_regs_named(const char *lsym, flash_apply_t apply)
+{
+	const reg_t		*reg, *linked;
+
+	char			symbuf[REGS_SYM_MAX + 1];
+	uint32_t		lval;
+	int			rc = 0;
 
 	while (*lsym != 0xFF) {
 
@@ -174,7 +477,7 @@ int flash_block_regs_load()
 
 				if (linked != NULL) {
 
-					reg->link->i = (int) (linked - regfile);
+					apply(reg, (uint32_t) (linked - regfile));
 				}
 			}
 		}
@@ -182,7 +485,9 @@ int flash_block_regs_load()
 
 			if (reg != NULL && reg->mode & REG_CONFIG) {
 
-				memcpy((void *) reg->link, lsym + 1, sizeof(uint32_t));
+				memcpy(&lval, lsym + 1, sizeof(uint32_t));
+
+				apply(reg, lval);
 			}
 
 			lsym += 5;
@@ -200,6 +505,99 @@ int flash_block_regs_load()
 	return rc;
 }
 
+static int
+flash_block_regs_apply(const flash_block_t *block, flash_apply_t apply)
+{
+	const uint32_t		*content = block->content;
+	int			rc, count;
+
+	if (flash_block_is_headed(block) != 0) {
+
+		count = (int) content[2];
+
+		if (		count < 0
+				|| count > (FLASH_CONTENT_MAX - FLASH_HEAD_MAX - 1) / 2) {
+
+			rc = 1;
+		}
+		else if (	   content[1] == flash_layout_hash()
+				&& count == flash_config_count()) {
+
+			/* Register layout is the same so we take packed values.
+			 * */
+			rc = flash_block_regs_packed(content + FLASH_HEAD_MAX, apply);
+		}
+		else if (content[0] == FLASH_BLOCK_MAGIC) {
+
+			rc = flash_block_regs_hashed(content, count, apply);
+		}
+		else {
+			rc = flash_block_regs_named((const char *)
+					(content + FLASH_HEAD_MAX + count), apply);
+		}
+	}
+	else {
+		/* Block of the first format has named values only.
+		 * */
+		rc = flash_block_regs_named((const char *) content, apply);
+	}
+
+	return rc;
+}
+
+int flash_block_regs_load()
+{
+	const flash_block_t	*block;
+	int			rc = 0;
+
+	block = flash_block_scan(0);
+
+	if (block == NULL) {
+
+		/* No valid configuration block found.
+		 * */
+		return rc;
+	}
+
+	rc = flash_block_regs_apply(block, &flash_reg_assign);
+
+	ap.flash_PROFILE = 0;
+
+	return rc;
+}
+
+int flash_profile_switch(int profile)
+{
+	const flash_block_t	*block;
+
+	if (		profile < 0
+			|| profile >= FLASH_PROFILE_MAX
+			|| pm.lu_MODE != PM_LU_DISABLED) {
+
+		return -1;
+	}
+
+	block = flash_block_scan(profile);
+
+	if (block == NULL) {
+
+		return -1;
+	}
+
+	/* We only write the registers whose value differs from the profile.
+	 * */
+	flash_changed_N = 0;
+
+	if (flash_block_regs_apply(block, &flash_reg_update) != 0) {
+
+		return -1;
+	}
+
+	ap.flash_PROFILE = profile;
+
+	return flash_changed_N;
+}
+
 static int
 flash_is_block_dirty(const flash_block_t *block)
 {
@@ -222,43 +620,57 @@ flash_is_block_dirty(const flash_block_t *block)
 }
 
 static int
-flash_prog_config_regs(flash_block_t *block)
+flash_prog_config_regs(flash_block_t *block, int profile, const char *name)
 {
 	const reg_t		*reg;
-	const char		*lsym;
 
 	flash_prog_t		pg;
-	int			rc = 0;
+	int			N, linked_N, rc;
 
 	pg.flash = block->content;
 	pg.index = 0;
 	pg.total = sizeof(block->content);
 
+	flash_prog_u32(&pg, FLASH_BLOCK_MAGIC);
+	flash_prog_u32(&pg, flash_layout_hash());
+	flash_prog_u32(&pg, flash_config_count());
+	flash_prog_u32(&pg, profile);
+
+	for (N = 0; N < FLASH_NAME_MAX; ++N) {
+
+		flash_prog_u8(&pg, (*name != 0 && N < FLASH_NAME_MAX - 1) ? *name++ : 0);
+	}
+
 	for (reg = regfile; reg->sym != NULL; ++reg) {
 
 		if (reg->mode & REG_CONFIG) {
 
-			lsym = reg->sym;
+			flash_prog_u32(&pg, reg->link->i);
+		}
+	}
 
-			/* Store symbolic name of the register.
-			 * */
-			while (*lsym != 0) { flash_prog_u8(&pg, *lsym++); }
+	linked_N = 0;
 
-			if (reg->mode & REG_LINKED) {
+	for (reg = regfile; reg->sym != NULL; ++reg) {
 
-				lsym = regfile[reg->link->i].sym;
+		if (reg->mode & REG_CONFIG) {
 
-				flash_prog_u8(&pg, 0xBF);
+			flash_prog_u32(&pg, flash_sym_hash(reg->sym));
 
-				while (*lsym != 0) { flash_prog_u8(&pg, *lsym++); }
-			}
-			else {
-				flash_prog_u8(&pg, 0xFF);
-				flash_prog_u32(&pg, reg->link->i);
-			}
+			linked_N += (reg->mode & REG_LINKED) ? 1 : 0;
+		}
+	}
 
-			if ((rc = flash_prog_u8(&pg, 0xFF)) == 0)
-				break;
+	rc = flash_prog_u32(&pg, linked_N);
+
+	for (reg = regfile; reg->sym != NULL; ++reg) {
+
+		if (		reg->mode & REG_CONFIG
+				&& reg->mode & REG_LINKED) {
+
+			flash_prog_u32(&pg, flash_sym_hash(reg->sym));
+
+			rc = flash_prog_u32(&pg, flash_sym_hash(regfile[reg->link->i].sym));
 		}
 	}
 
@@ -275,14 +687,179 @@ flash_prog_config_regs(flash_block_t *block)
 	return rc;
 }
 
+static void
+flash_block_copy(flash_block_t *block, const flash_block_t *keep)
+{
+	uint32_t		*ldst;
+	const uint32_t		*lsrc, *lend;
+
+	ldst = (uint32_t *) block;
+	lsrc = (const uint32_t *) keep;
+	lend = (const uint32_t *) (keep + 1);
+
+	while (lsrc < lend) {
+
+		if (*lsrc != 0xFFFFFFFFU) {
+
+			FLASH_prog_u32(ldst, *lsrc);
+		}
+
+		ldst++;
+		lsrc++;
+	}
+}
+
 static int
-flash_block_prog()
+flash_sector_of(const flash_block_t *block)
+{
+	int			N;
+
+	for (N = 0; N < FLASH_config.total - 1; ++N) {
+
+		if ((uint32_t) block < FLASH_config.map[N + 1])
+			break;
+	}
+
+	return N;
+}
+
+static void
+flash_sector_reserve(const flash_block_t *last)
+{
+	flash_block_t		*block, *fresh;
+	int			N, S, dirty = 0;
+
+	if (FLASH_config.total < 2)
+		return ;
+
+	S = flash_sector_of(last);
+	N = (S + 1 < FLASH_config.total) ? S + 1 : 0;
+
+	block = (flash_block_t *) FLASH_config.map[N];
+
+	while ((uint32_t) block < FLASH_config.map[N + 1]) {
+
+		dirty |= flash_is_block_dirty(block);
+
+		block += 1;
+	}
+
+	if (dirty == 0)
+		return ;
+
+	/* We keep the sector next to the one being written erased. Live
+	 * blocks of other profiles are moved to the free blocks of current
+	 * sector before erase so they are always kept in flash.
+	 * */
+	block = (flash_block_t *) FLASH_config.map[N];
+	fresh = (flash_block_t *) last + 1;
+
+	while ((uint32_t) block < FLASH_config.map[N + 1]) {
+
+		if (flash_block_is_live(block) != 0) {
+
+			while (		(uint32_t) fresh < FLASH_config.map[S + 1]
+					&& flash_is_block_dirty(fresh) != 0) {
+
+				fresh += 1;
+			}
+
+			if ((uint32_t) fresh >= FLASH_config.map[S + 1]) {
+
+				/* No room so we keep the sector as is.
+				 * */
+				return ;
+			}
+
+			flash_block_copy(fresh, block);
+
+			if (flash_block_crc32(fresh) != fresh->crc32)
+				return ;
+
+			fresh += 1;
+		}
+
+		block += 1;
+	}
+
+	FLASH_erase((uint32_t *) FLASH_config.map[N]);
+}
+
+static flash_block_t *
+flash_sector_erase(flash_block_t *origin, int profile)
+{
+	flash_block_t		*block, *keep;
+	int			N, keep_N = 0;
+
+	keep = (flash_block_t *) tlm.rdata;
+
+	N = flash_sector_of(origin);
+
+	/* All flash storage is dirty that is only possible if it was written
+	 * by previous firmware. Telemetry memory is used to keep the last
+	 * blocks of other profiles that are in the sector to be erased. Note
+	 * that we lose these blocks on power failure until they are written
+	 * back.
+	 * */
+	block = (flash_block_t *) FLASH_config.map[N];
+
+	while ((uint32_t) block < FLASH_config.map[N + 1]) {
+
+		if (		flash_block_is_live(block) != 0
+				&& flash_block_profile(block) != profile) {
+
+			if (tlm.mode != TLM_MODE_DISABLED) {
+
+				/* Do not clobber telemetry in progress.
+				 * */
+				return NULL;
+			}
+
+			keep_N++;
+		}
+
+		block += 1;
+	}
+
+	if (keep_N != 0) {
+
+		tlm_halt(&tlm);
+
+		keep_N = 0;
+		block = (flash_block_t *) FLASH_config.map[N];
+
+		while ((uint32_t) block < FLASH_config.map[N + 1]) {
+
+			if (		flash_block_is_live(block) != 0
+					&& flash_block_profile(block) != profile) {
+
+				memcpy(&keep[keep_N++], block, sizeof(flash_block_t));
+			}
+
+			block += 1;
+		}
+	}
+
+	block = FLASH_erase((uint32_t *) origin);
+
+	for (N = 0; N < keep_N; ++N) {
+
+		flash_block_copy(block, &keep[N]);
+
+		block += 1;
+	}
+
+	return block;
+}
+
+static int
+flash_block_prog(int profile, const char *name)
 {
 	flash_block_t		*block, *origin;
 	uint32_t		number, crc32;
 	int			rc = 0;
 
-	block = flash_block_scan();
+	block = flash_block_scan(-1);
 
 	if (block != NULL) {
 
@@ -310,14 +887,19 @@ flash_block_prog()
 
 			/* All flash storage is dirty.
 			 * */
-			block = FLASH_erase((uint32_t *) block);
+			block = flash_sector_erase(block, profile);
 			break;
 		}
 	}
 
+	if (block == NULL) {
+
+		return rc;
+	}
+
 	FLASH_prog_u32(&block->number, number);
 
-	if ((rc = flash_prog_config_regs(block)) != 0) {
+	if ((rc = flash_prog_config_regs(block, profile, name)) != 0) {
 
 		crc32 = flash_block_crc32(block);
 
@@ -326,6 +908,11 @@ flash_block_prog()
 		rc = (flash_block_crc32(block) == block->crc32) ? 1 : 0;
 	}
 
+	if (rc != 0) {
+
+		flash_sector_reserve(block);
+	}
+
 	return rc;
 }
 
@@ -341,7 +928,7 @@ SH_DEF(flash_prog)
 
 	printf("Flash ... ");
 
-	rc = flash_block_prog();
+	rc = flash_block_prog(0, "");
 
 	printf("%s" EOL, (rc != 0) ? "Done" : "Fail");
 }
@@ -412,3 +999,123 @@ SH_DEF(flash_wipe)
 	while (1);
 }
 
+SH_DEF(flash_profile_list)
+{
+	const flash_block_t		*block;
+	char				name[FLASH_NAME_MAX];
+	int				profile;
+
+	for (profile = 0; profile < FLASH_PROFILE_MAX; ++profile) {
+
+		block = flash_block_scan(profile);
+
+		printf("%c %i ", (profile == ap.flash_PROFILE) ? '*' : ' ', profile);
+
+		if (block != NULL) {
+
+			if (flash_block_is_headed(block) != 0) {
+
+				memcpy(name, block->content + 4, FLASH_NAME_MAX);
+
+				name[FLASH_NAME_MAX - 1] = 0;
+			}
+			else {
+				name[0] = 0;
+			}
+
+			printf("[%i] %s", block->number, name);
+		}
+		else {
+			printf("(empty)");
+		}
+
+		puts(EOL);
+	}
+}
+
+SH_DEF(flash_profile_store)
+{
+	int			rc, profile;
+
+	if (pm.lu_MODE != PM_LU_DISABLED) {
+
+		printf("Unable when PM is running" EOL);
+		return ;
+	}
+
+	if (		stoi(&profile, s) == NULL
+			|| profile < 0
+			|| profile >= FLASH_PROFILE_MAX) {
+
+		printf("Profile number from 0 to %i" EOL, FLASH_PROFILE_MAX - 1);
+		return ;
+	}
+
+	printf("Flash ... ");
+
+	rc = flash_block_prog(profile, sh_next_arg(s));
+
+	if (rc != 0) {
+
+		ap.flash_PROFILE = profile;
+	}
+
+	printf("%s" EOL, (rc != 0) ? "Done" : "Fail");
+}
+
+SH_DEF(flash_profile_load)
+{
+	const flash_block_t	*block;
+	int			rc, profile;
+
+	if (pm.lu_MODE != PM_LU_DISABLED) {
+
+		printf("Unable when PM is running" EOL);
+		return ;
+	}
+
+	if (stoi(&profile, s) != NULL) {
+
+		block = (		profile >= 0
+				&& profile < FLASH_PROFILE_MAX)
+			? flash_block_scan(profile) : NULL;
+
+		if (block != NULL) {
+
+			flash_block_regs_apply(block, &flash_reg_startup);
+		}
+
+		rc = flash_profile_switch(profile);
+
+		if (rc >= 0) {
+
+			printf("%i registers changed" EOL, rc);
+		}
+		else {
+			printf("Fail" EOL);
+		}
+	}
+}
+
+SH_DEF(flash_profile_diff)
+{
+	const flash_block_t	*block;
+	int			profile;
+
+	if (		stoi(&profile, s) != NULL
+			&& profile >= 0
+			&& profile < FLASH_PROFILE_MAX) {
+
+		block = flash_block_scan(profile);
+
+		if (block != NULL) {
+
+			flash_changed_N = 0;
+
+			flash_block_regs_apply(block, &flash_reg_diff);
+
+			printf("%i registers differ" EOL, flash_changed_N);
+		}
+	}
+}
+
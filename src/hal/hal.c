@@ -109,6 +109,19 @@ core_startup()
 
 	NVIC_SetPriorityGrouping(0U);
 
+#ifdef _PM_PROF
+	/* Enable DWT cycle counter for stage probes.
+	 * */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+#ifdef STM32F7
+	DWT->LAR = 0xC5ACCE55U;
+#endif /* STM32F7 */
+
+	DWT->CYCCNT = 0U;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif /* _PM_PROF */
+
 	/* Reset RCC.
 	 * */
 	MODIFY_REG(RCC->CR, RCC_CR_PLLI2SON | RCC_CR_PLLON | RCC_CR_CSSON
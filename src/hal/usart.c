@@ -15,9 +15,12 @@
 typedef struct {
 
 	USART_TypeDef		*BASE;
+	DMA_Stream_TypeDef	*DMA_TX;
 
 	QueueHandle_t		rx_queue;
 	QueueHandle_t		tx_queue;
+
+	volatile int		tx_block;
 }
 priv_USART_t;
 
@@ -95,6 +98,18 @@ void USART_startup()
 		priv_USART.BASE = USART3;
 	}
 
+	/* We transmit large blocks by DMA. Note that USART1 has no free
+	 * stream because DMA2_Stream7 is used by SPI.
+	 * */
+	if (_HW_HAVE_USART2) {
+
+		priv_USART.DMA_TX = DMA1_Stream6;
+	}
+	else if (_HW_HAVE_USART3) {
+
+		priv_USART.DMA_TX = DMA1_Stream3;
+	}
+
 	/* Enable USART clock.
 	 * */
 	if (_HW_HAVE_USART1) {
@@ -169,6 +184,24 @@ void USART_startup()
 	priv_USART.BASE->CR2 = 0;
 	priv_USART.BASE->CR3 = 0;
 
+	if (priv_USART.DMA_TX != NULL) {
+
+		/* Enable DMA on USART_TX.
+		 * */
+		RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+
+		priv_USART.DMA_TX->CR = (4U << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_PL_0
+			| DMA_SxCR_MINC | DMA_SxCR_DIR_0;
+
+#if defined(STM32F4)
+		priv_USART.DMA_TX->PAR = (uint32_t) &priv_USART.BASE->DR;
+#elif defined(STM32F7)
+		priv_USART.DMA_TX->PAR = (uint32_t) &priv_USART.BASE->TDR;
+#endif /* STM32Fx */
+
+		priv_USART.DMA_TX->FCR = 0;
+	}
+
 	/* Enable IRQ.
 	 * */
 	if (_HW_HAVE_USART1) {
@@ -210,7 +243,78 @@ void USART_putc(int c)
 
 	xQueueSendToBack(priv_USART.tx_queue, &xbyte, portMAX_DELAY);
 
-	priv_USART.BASE->CR1 |= USART_CR1_TXEIE;
+	if (priv_USART.tx_block == 0) {
+
+		priv_USART.BASE->CR1 |= USART_CR1_TXEIE;
+	}
+
+	GPIO_set_LOW(GPIO_LED_ALERT);
+}
+
+void USART_write(const void *b, int len)
+{
+	const char	*xb = (const char *) b;
+
+	if (priv_USART.DMA_TX == NULL) {
+
+		for (; len > 0; --len) {
+
+			USART_putc(*xb++);
+		}
+
+		return ;
+	}
+
+	GPIO_set_HIGH(GPIO_LED_ALERT);
+
+	/* Wait for the queue to drain and keep it paused while DMA owns the
+	 * transmitter.
+	 * */
+	priv_USART.tx_block = 1;
+
+	while (uxQueueMessagesWaiting(priv_USART.tx_queue) != 0) {
+
+		priv_USART.BASE->CR1 |= USART_CR1_TXEIE;
+
+		vTaskDelay((TickType_t) 1);
+	}
+
+	priv_USART.BASE->CR1 &= ~USART_CR1_TXEIE;
+
+#ifdef STM32F7
+	/* Clean D-Cache on the block.
+	 * */
+	SCB_CleanDCache_by_Addr((void *) b, len);
+#endif /* STM32F7 */
+
+	if (priv_USART.DMA_TX == DMA1_Stream3) {
+
+		DMA1->LIFCR = DMA_LIFCR_CTCIF3 | DMA_LIFCR_CHTIF3
+			| DMA_LIFCR_CTEIF3 | DMA_LIFCR_CDMEIF3 | DMA_LIFCR_CFEIF3;
+	}
+	else {
+		DMA1->HIFCR = DMA_HIFCR_CTCIF6 | DMA_HIFCR_CHTIF6
+			| DMA_HIFCR_CTEIF6 | DMA_HIFCR_CDMEIF6 | DMA_HIFCR_CFEIF6;
+	}
+
+	priv_USART.DMA_TX->M0AR = (uint32_t) b;
+	priv_USART.DMA_TX->NDTR = len;
+
+	priv_USART.BASE->CR3 |= USART_CR3_DMAT;
+	priv_USART.DMA_TX->CR |= DMA_SxCR_EN;
+
+	while ((priv_USART.DMA_TX->CR & DMA_SxCR_EN) != 0) {
+
+		vTaskDelay((TickType_t) 1);
+	}
+
+	priv_USART.BASE->CR3 &= ~USART_CR3_DMAT;
+	priv_USART.tx_block = 0;
+
+	if (uxQueueMessagesWaiting(priv_USART.tx_queue) != 0) {
+
+		priv_USART.BASE->CR1 |= USART_CR1_TXEIE;
+	}
 
 	GPIO_set_LOW(GPIO_LED_ALERT);
 }
@@ -6,6 +6,7 @@ void USART_startup();
 int USART_getc();
 int USART_poll();
 void USART_putc(int c);
+void USART_write(const void *b, int len);
 
 #endif /* _H_USART_ */
 
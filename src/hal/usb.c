@@ -30,6 +30,8 @@ typedef struct {
 
 	int			rx_flag;
 	int			tx_flag;
+
+	volatile int		tx_block;
 }
 priv_USB_t;
 
@@ -130,6 +132,13 @@ usbd_cdc_acm_bulk_in(uint8_t ep, uint32_t nbytes)
 	BaseType_t		xWoken = pdFALSE;
 	int			len = 0;
 
+	if (priv_USB.tx_block != 0) {
+
+		/* Block transfer is done so we give the buffer back.
+		 * */
+		priv_USB.tx_block = 0;
+	}
+
 	while (		len < CDC_DATA_SZ
 			&& xQueueReceiveFromISR(priv_USB.tx_queue,
 				&priv_USB.tx_buf[len], &xWoken) == pdTRUE) {
@@ -140,7 +149,7 @@ usbd_cdc_acm_bulk_in(uint8_t ep, uint32_t nbytes)
 
 		usbd_ep_start_write(CDC_IN_EP, priv_USB.tx_buf, len);
 	}
-	else if (nbytes == CDC_DATA_SZ) {
+	else if (nbytes != 0 && (nbytes % CDC_DATA_SZ) == 0) {
 
 		usbd_ep_start_write(CDC_IN_EP, NULL, 0);
 	}
@@ -179,7 +188,7 @@ task_cdc_acm_flag_poll()
 		}
 	}
 
-	if (priv_USB.tx_flag == 0) {
+	if (priv_USB.tx_flag == 0 && priv_USB.tx_block == 0) {
 
 		len = 0;
 
@@ -281,3 +290,74 @@ void USB_putc(int c)
 	GPIO_set_LOW(GPIO_LED_ALERT);
 }
 
+static void
+usbd_cdc_acm_in_abort()
+{
+	const struct usb_endpoint_descriptor	ep_desc = {
+
+		.bLength = USB_SIZEOF_ENDPOINT_DESC,
+		.bDescriptorType = USB_DESCRIPTOR_TYPE_ENDPOINT,
+		.bEndpointAddress = CDC_IN_EP,
+		.bmAttributes = USB_ENDPOINT_TYPE_BULK,
+		.wMaxPacketSize = CDC_DATA_SZ,
+		.bInterval = 0
+	};
+
+	USB_OTG_DeviceTypeDef		*dev = (USB_OTG_DeviceTypeDef *)
+		(USB_OTG_FS_PERIPH_BASE + USB_OTG_DEVICE_BASE);
+
+	NVIC_DisableIRQ(OTG_FS_IRQn);
+
+	/* Disable IN endpoint and stop TX FIFO refill from the buffer then
+	 * open it again with flushed FIFO.
+	 * */
+	usbd_ep_close(CDC_IN_EP);
+
+	dev->DIEPEMPMSK &= ~(1U << (CDC_IN_EP & 0x0FU));
+
+	usbd_ep_open(&ep_desc);
+
+	priv_USB.tx_block = 0;
+	priv_USB.tx_flag = 0;
+
+	NVIC_EnableIRQ(OTG_FS_IRQn);
+}
+
+void USB_write(const void *b, int len)
+{
+	int		wait;
+
+	GPIO_set_HIGH(GPIO_LED_ALERT);
+
+	/* Wait for the queue to drain then give the block to endpoint.
+	 * */
+	while (		priv_USB.tx_flag != 0
+			|| uxQueueMessagesWaiting(priv_USB.tx_queue) != 0) {
+
+		vTaskDelay((TickType_t) 1);
+	}
+
+	priv_USB.tx_block = 1;
+	priv_USB.tx_flag = 1;
+
+	usbd_ep_start_write(CDC_IN_EP, (const uint8_t *) b, len);
+
+	for (wait = 0; priv_USB.tx_block != 0; ++wait) {
+
+		if (wait > 1000) {
+
+			/* Host does not read the endpoint so we abort the
+			 * transfer to give the buffer back to the caller.
+			 * */
+			log_TRACE("USB write timeout" EOL);
+
+			usbd_cdc_acm_in_abort();
+			break;
+		}
+
+		vTaskDelay((TickType_t) 1);
+	}
+
+	GPIO_set_LOW(GPIO_LED_ALERT);
+}
+
@@ -3,6 +3,7 @@
 
 void USB_startup();
 void USB_putc(int c);
+void USB_write(const void *b, int len);
 
 #endif /* _H_USB_ */
 
@@ -72,10 +72,12 @@ void *memcpy(void *restrict d, const void *restrict s, size_t len)
 
 int strcmp(const char *s, const char *p)
 {
-	char		c;
+	int		c;
 
 	do {
-		c = *s - *p;
+		/* We compare as unsigned to get the order right.
+		 * */
+		c = (int) (uint8_t) *s - (int) (uint8_t) *p;
 
 		if (c || *s == 0)
 			break;
@@ -233,6 +235,22 @@ void xputs(io_ops_t *io, const char *s)
 	while (*s) io->putc(*s++);
 }
 
+void xputb(io_ops_t *io, const void *b, int len)
+{
+	const char	*s = (const char *) b;
+
+	if (io->write != NULL) {
+
+		io->write(b, len);
+	}
+	else {
+		for (; len > 0; --len) {
+
+			io->putc(*s++);
+		}
+	}
+}
+
 void xputs_left(io_ops_t *io, const char *s, int len)
 {
 	while (*s) {
@@ -748,6 +766,11 @@ void puts(const char *s)
 	xputs(iodef, s);
 }
 
+void putb(const void *b, int len)
+{
+	xputb(iodef, b, len);
+}
+
 void printf(const char *fmt, ...)
 {
         va_list		ap;
@@ -868,10 +891,11 @@ const char *stof(float *x, const char *s)
 	return s;
 }
 
-uint32_t crc32u(const void *raw, size_t len)
+uint32_t crc32u_next(uint32_t crcsum, const void *raw, size_t len)
 {
 	const uint32_t		*ip = (const uint32_t *) raw;
-	uint32_t		crcsum, seq;
+	const uint8_t		*bp;
+	uint32_t		seq;
 
 	static const uint32_t	lt[16] = {
 
@@ -881,12 +905,10 @@ uint32_t crc32u(const void *raw, size_t len)
 		0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
 	};
 
-	crcsum = 0xFFFFFFFFU;
-
 	while (len >= 4U) {
 
 		seq = *ip++;
-		len += - 4U;
+		len -= 4U;
 
 		crcsum = crcsum ^ seq;
 
@@ -900,7 +922,28 @@ uint32_t crc32u(const void *raw, size_t len)
 		crcsum = (crcsum >> 4) ^ lt[crcsum & 0x0FU];
 	}
 
-	return crcsum ^ 0xFFFFFFFFU;
+	bp = (const uint8_t *) ip;
+
+	/* Fold in the tail bytes so we get the same CRC as the bytewise
+	 * algorithm for any length.
+	 * */
+	while (len >= 1U) {
+
+		seq = *bp++;
+		len -= 1U;
+
+		crcsum = crcsum ^ seq;
+
+		crcsum = (crcsum >> 4) ^ lt[crcsum & 0x0FU];
+		crcsum = (crcsum >> 4) ^ lt[crcsum & 0x0FU];
+	}
+
+	return crcsum;
+}
+
+uint32_t crc32u(const void *raw, size_t len)
+{
+	return crc32u_next(0xFFFFFFFFU, raw, len) ^ 0xFFFFFFFFU;
 }
 
 uint32_t urand()
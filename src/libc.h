@@ -28,6 +28,11 @@ typedef struct {
 	int		(* getc) ();
 	int		(* poll) ();
 	void		(* putc) (int c);
+
+	/* Optional block write that may use DMA. The buffer must stay
+	 * unchanged until return.
+	 * */
+	void		(* write) (const void *b, int len);
 }
 io_ops_t;
 
@@ -58,6 +63,7 @@ int strlen(const char *s);
 const char *strchr(const char *s, int c);
 
 void xputs(io_ops_t *io, const char *s);
+void xputb(io_ops_t *io, const void *b, int len);
 void xprintf(io_ops_t *io, const char *fmt, ...);
 
 int getc();
@@ -65,12 +71,14 @@ int poll();
 void putc(int c);
 
 void puts(const char *s);
+void putb(const void *b, int len);
 void printf(const char *fmt, ...);
 
 const char *stoi(int *x, const char *s);
 const char *htoi(int *x, const char *s);
 const char *stof(float *x, const char *s);
 
+uint32_t crc32u_next(uint32_t crcsum, const void *raw, size_t len);
 uint32_t crc32u(const void *raw, size_t len);
 uint32_t urand();
 
@@ -545,6 +545,9 @@ static void
 default_flash_load()
 {
 	float			halt_I, halt_U;
+#ifdef HW_HAVE_NETWORK_EPCAN
+	int			N, K;
+#endif /* HW_HAVE_NETWORK_EPCAN */
 
 	hal.USART_baudrate = 57600;
 	hal.USART_parity = PARITY_EVEN;
@@ -603,6 +606,7 @@ default_flash_load()
 #ifdef HW_HAVE_NETWORK_EPCAN
 	net.node_ID = 0;
 	net.log_MODE = EPCAN_LOG_DISABLED;
+	net.flow_MODE = EPCAN_FLOW_DISABLED;
 	net.timeout_EP = 100 * HW_PWM_FREQUENCY_HZ / 1000;
 	net.ep[0].ID = 10;
 	net.ep[0].rate = HW_PWM_FREQUENCY_HZ / 1000;
@@ -620,6 +624,15 @@ default_flash_load()
 	net.ep[3].rate = net.ep[0].rate;
 	net.ep[3].range[0] = 0.f;
 	net.ep[3].range[1] = 1.f;
+
+	for (N = 0; N < EPCAN_PIPE_MAX; ++N) {
+
+		for (K = 0; K < EPCAN_PACK_MAX; ++K) {
+
+			net.ep[N].pack_range[K][0] = 0.f;
+			net.ep[N].pack_range[K][1] = 1.f;
+		}
+	}
 #endif /* HW_HAVE_NETWORK_EPCAN */
 
 	ap.ppm_reg_ID = ID_PM_S_SETPOINT_SPEED_KNOB;
@@ -741,6 +754,10 @@ default_flash_load()
 
 	pm_auto(&pm, PM_AUTO_MAXIMAL_CURRENT);
 
+#ifdef _PM_PROF
+	pm_prof_reset(&pm.prof);
+#endif /* _PM_PROF */
+
 	pm.watt_wA_maximal = (float) (int) (0.66666667f * pm.i_maximal);
 	pm.watt_wA_reverse = pm.watt_wA_maximal;
 
@@ -836,17 +853,20 @@ LD_TASK void task_INIT(void *pData)
 	io_USART.getc = &USART_getc;
 	io_USART.poll = &USART_poll;
 	io_USART.putc = &USART_putc;
+	io_USART.write = &USART_write;
 
 #ifdef HW_HAVE_USB_CDC_ACM
 	io_USB.getc = &USART_getc;
 	io_USB.poll = &USART_poll;
 	io_USB.putc = &USB_putc;
+	io_USB.write = &USB_write;
 #endif /* HW_HAVE_USB_CDC_ACM */
 
 #ifdef HW_HAVE_NETWORK_EPCAN
 	io_CAN.getc = &USART_getc;
 	io_CAN.poll = &USART_poll;
 	io_CAN.putc = &EPCAN_putc;
+	io_CAN.write = &EPCAN_write;
 #endif /* HW_HAVE_NETWORK_EPCAN */
 
 	/* Default to USART.
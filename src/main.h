@@ -106,6 +106,10 @@ typedef struct {
 	 * */
 	int			load_HX711;
 
+	/* Configuration profile in flash.
+	 * */
+	int			flash_PROFILE;
+
 	/* SPI absolute encoder (e.g. AS5047).
 	 * */
 	int 			(* proc_get_EP) ();
@@ -117,6 +121,7 @@ extern pmc_t			pm;
 extern tlm_t			tlm;
 
 extern int flash_block_regs_load();
+extern int flash_profile_switch(int profile);
 extern int pm_wait_IDLE();
 
 void app_halt();
@@ -55,6 +55,31 @@ void m_rotatef(float x[2], float r)
 	x[0] = q;
 }
 
+void m_rotorf(float F[2], float r)
+{
+	float		q;
+
+	/* Get the rotor \F of small angle \r to apply it several times.
+	 * */
+
+	q = r * r;
+
+	F[1] = r * (1.f - q * (1.6666667E-1f - 8.3333338E-3f * q));
+	F[0] = 1.f - q * (0.5f - 4.1666668E-2f * q);
+}
+
+void m_turnf(float x[2], const float F[2])
+{
+	float		q;
+
+	/* Rotate the vector \x by rotor \F.
+	 * */
+
+	   q = F[0] * x[0] - F[1] * x[1];
+	x[1] = F[1] * x[0] + F[0] * x[1];
+	x[0] = q;
+}
+
 void m_normalizef(float x[2])
 {
 	float		l;
@@ -130,18 +155,18 @@ float m_atan2f(float y, float x)
 	return u;
 }
 
+static const float	lt_sincosf[] = {
+
+	 2.5981195E-6f,
+	-1.9804760E-4f,
+	 8.3329641E-3f,
+	-1.6666652E-1f,
+	 9.9999998E-1f
+};
+
 static float
 m_sincosf(float x)
 {
-	static const float	lt_sincosf[] = {
-
-		 2.5981195E-6f,
-		-1.9804760E-4f,
-		 8.3329641E-3f,
-		-1.6666652E-1f,
-		 9.9999998E-1f
-	};
-
 	float		u, q;
 
 	q = x * x;
@@ -155,6 +180,33 @@ m_sincosf(float x)
 	return u * x;
 }
 
+static void
+m_sincosf_v2(float u[2], const float x[2])
+{
+	float		q[2];
+
+	/* Two independent chains are interleaved so the FPU pipeline is
+	 * kept busy.
+	 * */
+
+	q[0] = x[0] * x[0];
+	q[1] = x[1] * x[1];
+
+	u[0] = lt_sincosf[0];
+	u[1] = lt_sincosf[0];
+	u[0] = lt_sincosf[1] + u[0] * q[0];
+	u[1] = lt_sincosf[1] + u[1] * q[1];
+	u[0] = lt_sincosf[2] + u[0] * q[0];
+	u[1] = lt_sincosf[2] + u[1] * q[1];
+	u[0] = lt_sincosf[3] + u[0] * q[0];
+	u[1] = lt_sincosf[3] + u[1] * q[1];
+	u[0] = lt_sincosf[4] + u[0] * q[0];
+	u[1] = lt_sincosf[4] + u[1] * q[1];
+
+	u[0] *= x[0];
+	u[1] *= x[1];
+}
+
 float m_sinf(float x)
 {
 	float           y, u;
@@ -184,6 +236,26 @@ float m_cosf(float x)
 	return u;
 }
 
+void m_cossinf(float F[2], float x)
+{
+	float		y[2], u;
+
+	/* Get both cosine and sine of the same angle \x with single range
+	 * reduction.
+	 * */
+
+	u = x * (1.f / M_2_PI_F) + 12582912.f;
+	x = x - (u - 12582912.f) * M_2_PI_F;
+
+	y[0] = M_PI_F / 2.f - m_fabsf(x);
+	y[1] = m_fabsf(x);
+	y[1] = (y[1] > M_PI_F / 2.f) ? M_PI_F - y[1] : y[1];
+
+	m_sincosf_v2(F, y);
+
+	F[1] = (x < 0.f) ? - F[1] : F[1];
+}
+
 float m_log2f(float x)
 {
 	union {
@@ -24,6 +24,8 @@ float m_fast_recipf(float x);
 float m_fast_rsqrtf(float x);
 
 void m_rotatef(float x[2], float r);
+void m_rotorf(float F[2], float r);
+void m_turnf(float x[2], const float F[2]);
 void m_normalizef(float x[2]);
 
 void m_rsumf(float *sum, float *rem, float x);
@@ -31,6 +33,7 @@ void m_rsumf(float *sum, float *rem, float x);
 float m_atan2f(float y, float x);
 float m_sinf(float x);
 float m_cosf(float x);
+void m_cossinf(float F[2], float x);
 float m_log2f(float x);
 float m_log10f(float x);
 float m_logf(float x);
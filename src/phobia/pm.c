@@ -3,6 +3,8 @@
 
 void pm_quick_build(pmc_t *pm)
 {
+	int		N;
+
 	if (PM_CONFIG_NOP(pm) == PM_NOP_THREE_PHASE) {
 
 		pm->k_UMAX = 0.66666667f;	/* 2 / NOP */
@@ -24,6 +26,19 @@ void pm_quick_build(pmc_t *pm)
 	pm->ts_bootstrap = PM_TSMS(pm, pm->dc_bootstrap);
 	pm->ts_inverted = 1.f / (float) pm->dc_resolution;
 
+	pm->quick_slow_dT = pm->m_dT * (float) pm->slow_DIV;
+
+	pm->quick_kalman_wS = (float) PM_KALMAN_TAB_W / pm->s_maximal;
+	pm->quick_kalman_iQ = (float) PM_KALMAN_TAB_I * 0.5f / pm->i_maximal;
+
+	/* Steady KALMAN gains are learned from scratch as machine constants
+	 * may have been changed.
+	 * */
+	for (N = 0; N < PM_KALMAN_TAB; ++N) {
+
+		pm->kalman_tab_N[N] = 0;
+	}
+
 	if (pm->const_lambda > M_EPSILON) {
 
 		pm->quick_iWb = 1.f / pm->const_lambda;
@@ -55,6 +70,8 @@ void pm_quick_build(pmc_t *pm)
 
 	pm->quick_HFwS = M_2_PI_F * pm->hfi_freq;
 
+	m_rotorf(pm->quick_HFwF, pm->quick_HFwS * pm->m_dT);
+
 	if (		   pm->eabi_const_Zq != 0
 			&& pm->eabi_const_EP != 0) {
 
@@ -71,6 +88,8 @@ void pm_quick_build(pmc_t *pm)
 
 		pm->quick_ZiSQ = Zf / Zq;
 	}
+
+	pm_feedback_select(pm);
 }
 
 static void
@@ -81,6 +100,8 @@ pm_auto_basic_default(pmc_t *pm)
 	pm->dc_skip = 2.0f;			/* (us) */
 	pm->dc_bootstrap = 100.f;		/* (ms) */
 
+	pm->slow_DIV = 1;
+
 	pm->config_NOP = PM_NOP_THREE_PHASE;
 	pm->config_IFB = PM_IFB_ABC_INLINE;
 	pm->config_TVM = PM_ENABLED;
@@ -120,6 +141,7 @@ pm_auto_config_default(pmc_t *pm)
 	pm->config_LU_FORCED = PM_ENABLED;
 	pm->config_LU_FREEWHEEL = PM_ENABLED;
 	pm->config_LU_ESTIMATE = PM_FLUX_ORTEGA;
+	pm->config_KALMAN_STEADY = PM_DISABLED;
 	pm->config_LU_SENSOR = PM_SENSOR_NONE;
 	pm->config_LU_LOCATION = PM_LOCATION_NONE;
 	pm->config_LU_DRIVE = PM_DRIVE_SPEED;
@@ -770,8 +792,8 @@ pm_forced(pmc_t *pm)
 	m_normalizef(pm->forced_F);
 }
 
-static void
-pm_flux_detached(pmc_t *pm)
+static PM_FV_INLINE void
+pm_flux_detached(pmc_t *pm, int fv)
 {
 	float		uA, uB, uC, uX, uY, U, A, B, blend;
 
@@ -781,7 +803,7 @@ pm_flux_detached(pmc_t *pm)
 	uB = pm->fb_uB;
 	uC = pm->fb_uC;
 
-	if (PM_CONFIG_NOP(pm) == PM_NOP_THREE_PHASE) {
+	if (PM_FV_NOP(pm, fv) == PM_NOP_THREE_PHASE) {
 
 		U = 0.33333333f * (uA + uB + uC);
 
@@ -1211,6 +1233,202 @@ pm_kalman_update(pmc_t *pm)
 	K[8] += K[9] * u;
 }
 
+static void
+pm_kalman_turn_P(float P[15], float c, float s)
+{
+	float		m[4], x;
+
+	/*
+	 * Rotate covariance of the current estimate.
+	 *
+	 * P = T * P * T'.
+	 *
+	 *     [ c   -s   0  0  0 ]
+	 *     [ s    c   0  0  0 ]
+	 * T = [ 0    0   1  0  0 ]
+	 *     [ 0    0   0  1  0 ]
+	 *     [ 0    0   0  0  1 ]
+	 *
+	 * */
+
+	m[0] = c * P[0] - s * P[1];
+	m[1] = c * P[1] - s * P[2];
+	m[2] = s * P[0] + c * P[1];
+	m[3] = s * P[1] + c * P[2];
+
+	P[0] = m[0] * c - m[1] * s;
+	P[1] = m[0] * s + m[1] * c;
+	P[2] = m[2] * s + m[3] * c;
+
+	x = P[3];
+	P[3] = c * x - s * P[4];
+	P[4] = s * x + c * P[4];
+
+	x = P[6];
+	P[6] = c * x - s * P[7];
+	P[7] = s * x + c * P[7];
+
+	x = P[10];
+	P[10] = c * x - s * P[11];
+	P[11] = s * x + c * P[11];
+}
+
+static void
+pm_kalman_turn_K(float K[10], float c, float s)
+{
+	float		m[4], x;
+
+	/*
+	 * Rotate the gain to get the same correction in other axes.
+	 *
+	 * K(0..3) = T * K(0..3) * T'.
+	 * K(4..9) = K(4..9) * T'.
+	 *
+	 * */
+
+	m[0] = K[0] * c - K[1] * s;
+	m[1] = K[0] * s + K[1] * c;
+	m[2] = K[2] * c - K[3] * s;
+	m[3] = K[2] * s + K[3] * c;
+
+	K[0] = c * m[0] - s * m[2];
+	K[1] = c * m[1] - s * m[3];
+	K[2] = s * m[0] + c * m[2];
+	K[3] = s * m[1] + c * m[3];
+
+	x = K[4];
+	K[4] = x * c - K[5] * s;
+	K[5] = x * s + K[5] * c;
+
+	x = K[6];
+	K[6] = x * c - K[7] * s;
+	K[7] = x * s + K[7] * c;
+
+	x = K[8];
+	K[8] = x * c - K[9] * s;
+	K[9] = x * s + K[9] * c;
+}
+
+static void
+pm_kalman_mirror(float K[10])
+{
+	/* Machine is symmetric to the reverse of Q-axis so we keep gains
+	 * for positive speed only.
+	 * */
+	K[1] = - K[1];
+	K[2] = - K[2];
+	K[4] = - K[4];
+	K[6] = - K[6];
+	K[8] = - K[8];
+}
+
+static void
+pm_kalman_steady(pmc_t *pm)
+{
+	float		*K = pm->kalman_K;
+	float		*G, wS, iQ, u;
+
+	int		N, i, lev_N, in_STEADY, mirror;
+
+	/* Get the operating point in positive speed half.
+	 * */
+	wS = pm->flux_wS;
+	iQ = pm->flux_X[1];
+
+	mirror = (wS < 0.f) ? 1 : 0;
+
+	wS = (mirror != 0) ? - wS : wS;
+	iQ = (mirror != 0) ? - iQ : iQ;
+
+	wS = wS * pm->quick_kalman_wS;
+	iQ = iQ * pm->quick_kalman_iQ + (float) (PM_KALMAN_TAB_I / 2);
+
+	wS = (wS < (float) (PM_KALMAN_TAB_W - 1)) ? wS : (float) (PM_KALMAN_TAB_W - 1);
+	iQ = (iQ > 0.f) ? iQ : 0.f;
+	iQ = (iQ < (float) (PM_KALMAN_TAB_I - 1)) ? iQ : (float) (PM_KALMAN_TAB_I - 1);
+
+	N = (int) wS * PM_KALMAN_TAB_I + (int) iQ;
+
+	G = pm->kalman_tab_K[N];
+
+	lev_N = PM_TSMS(pm, pm->tm_transient_slow);
+
+	/* We only trust in steady gains at high speed without transients.
+	 * */
+	in_STEADY = (	   pm->flux_ZONE == PM_ZONE_HIGH
+			&& pm->lu_MODE != PM_LU_ON_HFI
+			&& m_fabsf(pm->flux_wS - pm->zone_lpf_wS) < pm->zone_noise)
+			? PM_ENABLED : PM_DISABLED;
+
+	if (		in_STEADY == PM_ENABLED
+			&& pm->kalman_tab_N[N] >= lev_N) {
+
+		if (pm->kalman_STEADY != PM_ENABLED) {
+
+			/* Keep the covariance in DQ-axes while it is frozen.
+			 * */
+			pm_kalman_turn_P(pm->kalman_P, pm->flux_F[0], - pm->flux_F[1]);
+
+			pm->kalman_STEADY = PM_ENABLED;
+		}
+
+		for (i = 0; i < 10; ++i) {
+
+			K[i] = G[i];
+		}
+
+		if (mirror != 0) {
+
+			pm_kalman_mirror(K);
+		}
+
+		pm_kalman_turn_K(K, pm->flux_F[0], pm->flux_F[1]);
+	}
+	else {
+		if (pm->kalman_STEADY == PM_ENABLED) {
+
+			pm_kalman_turn_P(pm->kalman_P, pm->flux_F[0], pm->flux_F[1]);
+
+			pm->kalman_STEADY = PM_DISABLED;
+		}
+
+		pm_kalman_forecast(pm);
+
+		if (likely(pm->vsi_IF == 0)) {
+
+			pm_kalman_update(pm);
+
+			if (in_STEADY == PM_ENABLED) {
+
+				float		Kdq[10];
+
+				/* Learn the gain in DQ-axes by averaging.
+				 * */
+				for (i = 0; i < 10; ++i) {
+
+					Kdq[i] = K[i];
+				}
+
+				pm_kalman_turn_K(Kdq, pm->flux_F[0], - pm->flux_F[1]);
+
+				if (mirror != 0) {
+
+					pm_kalman_mirror(Kdq);
+				}
+
+				pm->kalman_tab_N[N] += (pm->kalman_tab_N[N] < lev_N) ? 1 : 0;
+
+				u = 1.f / (float) pm->kalman_tab_N[N];
+
+				for (i = 0; i < 10; ++i) {
+
+					G[i] += (Kdq[i] - G[i]) * u;
+				}
+			}
+		}
+	}
+}
+
 static void
 pm_kalman_lockout_guard(pmc_t *pm, float dA)
 {
@@ -1397,10 +1615,12 @@ pm_flux_zone(pmc_t *pm)
 	}
 }
 
-static void
-pm_estimate(pmc_t *pm)
+static PM_FV_INLINE void
+pm_estimate(pmc_t *pm, int fv)
 {
-	if (pm->config_LU_ESTIMATE == PM_FLUX_ORTEGA) {
+	PM_PROF_MARK(pm, PM_PROF_LU);
+
+	if (PM_FV_ESTIMATE(pm, fv) == PM_FLUX_ORTEGA) {
 
 		if (pm->flux_TYPE != PM_FLUX_ORTEGA) {
 
@@ -1417,8 +1637,10 @@ pm_estimate(pmc_t *pm)
 
 		pm_flux_ortega(pm);
 		pm_flux_zone(pm);
+
+		PM_PROF_MARK(pm, PM_PROF_FLUX_ORTEGA);
 	}
-	else if (pm->config_LU_ESTIMATE == PM_FLUX_KALMAN) {
+	else if (PM_FV_ESTIMATE(pm, fv) == PM_FLUX_KALMAN) {
 
 		if (pm->flux_TYPE != PM_FLUX_KALMAN) {
 
@@ -1456,12 +1678,15 @@ pm_estimate(pmc_t *pm)
 			pm->kalman_K[9] = 0.f;
 
 			pm->kalman_bias_Q = 0.f;
+			pm->kalman_STEADY = PM_DISABLED;
 
 			pm->flux_TYPE = PM_FLUX_KALMAN;
 		}
 
 		pm_flux_kalman(pm);
 		pm_flux_zone(pm);
+
+		PM_PROF_MARK(pm, PM_PROF_FLUX_KALMAN);
 	}
 	else {
 		/* NOTE: No sensorless observer selected. It is ok when you
@@ -1475,17 +1700,17 @@ pm_estimate(pmc_t *pm)
 	}
 }
 
-static void
-pm_hfi_wave(pmc_t *pm)
+static PM_FV_INLINE void
+pm_hfi_wave(pmc_t *pm, int fv)
 {
-	if (pm->config_HFI_WAVETYPE == PM_HFI_SINE) {
+	if (PM_FV_HFI(pm, fv) == PM_HFI_SINE) {
 
 		/* HF sine wave synthesis.
 		 * */
-		m_rotatef(pm->hfi_wave, pm->quick_HFwS * pm->m_dT);
+		m_turnf(pm->hfi_wave, pm->quick_HFwF);
 		m_normalizef(pm->hfi_wave);
 	}
-	else if (pm->config_HFI_WAVETYPE == PM_HFI_RANDOM) {
+	else if (PM_FV_HFI(pm, fv) == PM_HFI_RANDOM) {
 
 		/* HF random sequence.
 		 * */
@@ -1563,8 +1788,8 @@ pm_sensor_hall(pmc_t *pm)
 	}
 }
 
-static void
-pm_sensor_eabi(pmc_t *pm)
+static PM_FV_INLINE void
+pm_sensor_eabi(pmc_t *pm, int fv)
 {
 	float		F[2], A, blend, ANG, rel;
 	int		relEP, WRAP;
@@ -1586,7 +1811,7 @@ pm_sensor_eabi(pmc_t *pm)
 			pm->eabi_lEP = pm->fb_EP;
 		}
 
-		if (pm->config_LU_SENSOR == PM_SENSOR_EABI) {
+		if (PM_FV_SENSOR(pm, fv) == PM_SENSOR_EABI) {
 
 			pm->eabi_F[0] = pm->lu_F[0];
 			pm->eabi_F[1] = pm->lu_F[1];
@@ -1663,14 +1888,13 @@ pm_sensor_eabi(pmc_t *pm)
 
 	pm->eabi_interp += pm->eabi_wS * pm->m_dT;
 
-	if (pm->config_LU_SENSOR == PM_SENSOR_EABI) {
+	if (PM_FV_SENSOR(pm, fv) == PM_SENSOR_EABI) {
 
 		/* Take the electrical position DQ-axes.
 		 * */
 		ANG = (float) pm->eabi_lEP * pm->quick_ZiEP + pm->eabi_interp;
 
-		F[0] = m_cosf(ANG);
-		F[1] = m_sinf(ANG);
+		m_cossinf(F, ANG);
 
 		if (pm->eabi_ADJUST != PM_ENABLED) {
 
@@ -1784,16 +2008,15 @@ pm_sensor_sincos(pmc_t *pm)
 	 * */
 	locAN = scAN * pm->quick_ZiSQ;
 
-	pm->sincos_F[0] = m_cosf(locAN);
-	pm->sincos_F[1] = m_sinf(locAN);
+	m_cossinf(pm->sincos_F, locAN);
 
 	/* TODO */
 }
 
-static void
-pm_lu_FSM(pmc_t *pm)
+static PM_FV_INLINE void
+pm_lu_FSM(pmc_t *pm, int fv)
 {
-	float			lu_F[2], hS, A, B;
+	float			lu_F[2] = { 1.f, 0.f }, hF[2], hS, A, B;
 
 	int			lu_EABI = PM_DISABLED;
 
@@ -1804,14 +2027,15 @@ pm_lu_FSM(pmc_t *pm)
 
 	/* Get voltage on DQ-axes on the middle of cycle.
 	 * */
-	m_rotatef(pm->lu_F, pm->lu_wS * pm->m_dT * 0.5f);
+	m_rotorf(hF, pm->lu_wS * pm->m_dT * 0.5f);
+	m_turnf(pm->lu_F, hF);
 
 	pm->lu_uD = pm->lu_F[0] * pm->dcu_X + pm->lu_F[1] * pm->dcu_Y;
 	pm->lu_uQ = pm->lu_F[0] * pm->dcu_Y - pm->lu_F[1] * pm->dcu_X;
 
 	/* Transform DQ-axes to the future cycle position.
 	 * */
-	m_rotatef(pm->lu_F, pm->lu_wS * pm->m_dT * 0.5f);
+	m_turnf(pm->lu_F, hF);
 	m_normalizef(pm->lu_F);
 
 	if (unlikely(pm->vsi_IF != 0)) {
@@ -1876,7 +2100,7 @@ pm_lu_FSM(pmc_t *pm)
 
 		if (pm->base_TIM >= 0) {
 
-			pm_flux_detached(pm);
+			pm_flux_detached(pm, fv);
 			pm_flux_zone(pm);
 		}
 
@@ -1899,14 +2123,14 @@ pm_lu_FSM(pmc_t *pm)
 			 * */
 			pm->base_TIM++;
 		}
-		else if (	pm->config_LU_ESTIMATE != PM_FLUX_NONE
+		else if (	PM_FV_ESTIMATE(pm, fv) != PM_FLUX_NONE
 				&& pm->flux_ZONE == PM_ZONE_HIGH) {
 
 			pm->lu_MODE = PM_LU_ESTIMATE;
 
 			pm->proc_set_Z(PM_Z_NONE);
 		}
-		else if (pm->config_LU_SENSOR == PM_SENSOR_HALL) {
+		else if (PM_FV_SENSOR(pm, fv) == PM_SENSOR_HALL) {
 
 			pm->lu_MODE = PM_LU_SENSOR_HALL;
 
@@ -1917,7 +2141,7 @@ pm_lu_FSM(pmc_t *pm)
 
 			pm->proc_set_Z(PM_Z_NONE);
 		}
-		else if (	pm->config_LU_SENSOR == PM_SENSOR_EABI
+		else if (	PM_FV_SENSOR(pm, fv) == PM_SENSOR_EABI
 				&& (	pm->eabi_ADJUST  == PM_ENABLED
 					|| pm->flux_ZONE == PM_ZONE_HIGH)) {
 
@@ -1945,8 +2169,8 @@ pm_lu_FSM(pmc_t *pm)
 				pm->proc_set_Z(PM_Z_NONE);
 			}
 		}
-		else if (       pm->config_LU_ESTIMATE == PM_FLUX_KALMAN
-				&& pm->config_HFI_WAVETYPE != PM_HFI_NONE) {
+		else if (       PM_FV_ESTIMATE(pm, fv) == PM_FLUX_KALMAN
+				&& PM_FV_HFI(pm, fv) != PM_HFI_NONE) {
 
 			pm->lu_MODE = PM_LU_ON_HFI;
 
@@ -1957,7 +2181,7 @@ pm_lu_FSM(pmc_t *pm)
 	}
 	else if (pm->lu_MODE == PM_LU_FORCED) {
 
-		pm_estimate(pm);
+		pm_estimate(pm, fv);
 		pm_forced(pm);
 
 		lu_F[0] = pm->forced_F[0];
@@ -1980,12 +2204,12 @@ pm_lu_FSM(pmc_t *pm)
 
 				pm->hold_TIM++;
 			}
-			else if (pm->config_LU_SENSOR == PM_SENSOR_EABI) {
+			else if (PM_FV_SENSOR(pm, fv) == PM_SENSOR_EABI) {
 
 				pm->lu_MODE = PM_LU_SENSOR_EABI;
 			}
-			else if (	pm->config_LU_ESTIMATE == PM_FLUX_KALMAN
-					&& pm->config_HFI_WAVETYPE != PM_HFI_NONE) {
+			else if (	PM_FV_ESTIMATE(pm, fv) == PM_FLUX_KALMAN
+					&& PM_FV_HFI(pm, fv) != PM_HFI_NONE) {
 
 				pm->lu_MODE = PM_LU_ON_HFI;
 			}
@@ -2004,7 +2228,7 @@ pm_lu_FSM(pmc_t *pm)
 	}
 	else if (pm->lu_MODE == PM_LU_ESTIMATE) {
 
-		pm_estimate(pm);
+		pm_estimate(pm, fv);
 
 		lu_F[0] = pm->flux_F[0];
 		lu_F[1] = pm->flux_F[1];
@@ -2020,7 +2244,7 @@ pm_lu_FSM(pmc_t *pm)
 		else if (	   pm->flux_ZONE == PM_ZONE_NONE
 				|| pm->flux_ZONE == PM_ZONE_UNCERTAIN) {
 
-			if (pm->config_LU_SENSOR == PM_SENSOR_HALL) {
+			if (PM_FV_SENSOR(pm, fv) == PM_SENSOR_HALL) {
 
 				pm->lu_MODE = PM_LU_SENSOR_HALL;
 
@@ -2029,14 +2253,14 @@ pm_lu_FSM(pmc_t *pm)
 				pm->hall_F[1] = pm->lu_F[1];
 				pm->hall_wS = pm->lu_wS;
 			}
-			else if (	pm->config_LU_SENSOR == PM_SENSOR_EABI
+			else if (	PM_FV_SENSOR(pm, fv) == PM_SENSOR_EABI
 					&& (	pm->eabi_ADJUST  == PM_ENABLED
 						|| pm->flux_ZONE == PM_ZONE_UNCERTAIN)) {
 
 				pm->lu_MODE = PM_LU_SENSOR_EABI;
 			}
-			else if (	pm->config_LU_ESTIMATE == PM_FLUX_KALMAN
-					&& pm->config_HFI_WAVETYPE != PM_HFI_NONE) {
+			else if (	PM_FV_ESTIMATE(pm, fv) == PM_FLUX_KALMAN
+					&& PM_FV_HFI(pm, fv) != PM_HFI_NONE) {
 
 				pm->lu_MODE = PM_LU_ON_HFI;
 
@@ -2080,7 +2304,7 @@ pm_lu_FSM(pmc_t *pm)
 	}
 	else if (pm->lu_MODE == PM_LU_ON_HFI) {
 
-		pm_estimate(pm);
+		pm_estimate(pm, fv);
 
 		lu_F[0] = pm->flux_F[0];
 		lu_F[1] = pm->flux_F[1];
@@ -2088,7 +2312,7 @@ pm_lu_FSM(pmc_t *pm)
 		pm->lu_wS = pm->flux_wS;
 
 		if (		pm->flux_ZONE == PM_ZONE_HIGH
-				|| pm->config_HFI_WAVETYPE == PM_HFI_NONE) {
+				|| PM_FV_HFI(pm, fv) == PM_HFI_NONE) {
 
 			pm->lu_MODE = PM_LU_ESTIMATE;
 		}
@@ -2097,7 +2321,7 @@ pm_lu_FSM(pmc_t *pm)
 
 				pm->hold_TIM++;
 			}
-			else if (pm->config_LU_SENSOR == PM_SENSOR_EABI) {
+			else if (PM_FV_SENSOR(pm, fv) == PM_SENSOR_EABI) {
 
 				pm->lu_MODE = PM_LU_SENSOR_EABI;
 			}
@@ -2105,9 +2329,11 @@ pm_lu_FSM(pmc_t *pm)
 	}
 	else if (pm->lu_MODE == PM_LU_SENSOR_HALL) {
 
-		pm_estimate(pm);
+		pm_estimate(pm, fv);
 		pm_sensor_hall(pm);
 
+		PM_PROF_MARK(pm, PM_PROF_SENSOR);
+
 		lu_F[0] = pm->hall_F[0];
 		lu_F[1] = pm->hall_F[1];
 
@@ -2120,8 +2346,10 @@ pm_lu_FSM(pmc_t *pm)
 	}
 	else if (pm->lu_MODE == PM_LU_SENSOR_EABI) {
 
-		pm_estimate(pm);
-		pm_sensor_eabi(pm);
+		pm_estimate(pm, fv);
+		pm_sensor_eabi(pm, fv);
+
+		PM_PROF_MARK(pm, PM_PROF_SENSOR);
 
 		lu_F[0] = pm->eabi_F[0];
 		lu_F[1] = pm->eabi_F[1];
@@ -2137,9 +2365,11 @@ pm_lu_FSM(pmc_t *pm)
 	}
 	else if (pm->lu_MODE == PM_LU_SENSOR_SINCOS) {
 
-		pm_estimate(pm);
+		pm_estimate(pm, fv);
 		pm_sensor_sincos(pm);
 
+		PM_PROF_MARK(pm, PM_PROF_SENSOR);
+
 		/* TODO */
 	}
 	else {
@@ -2216,7 +2446,11 @@ pm_lu_FSM(pmc_t *pm)
 
 		if (lu_EABI != PM_ENABLED) {
 
-			pm_sensor_eabi(pm);
+			PM_PROF_MARK(pm, PM_PROF_LU);
+
+			pm_sensor_eabi(pm, fv);
+
+			PM_PROF_MARK(pm, PM_PROF_SENSOR);
 
 			lu_EABI = PM_ENABLED;
 		}
@@ -2334,7 +2568,8 @@ void pm_clearance(pmc_t *pm, int xA, int xB, int xC)
 	pm->vsi_C0 = xC;
 }
 
-void pm_voltage(pmc_t *pm, float uX, float uY)
+static PM_FV_INLINE void
+pm_voltage_fv(pmc_t *pm, float uX, float uY, int fv)
 {
 	float		uA, uB, uC, uMIN, uMAX, uDC;
 	int		xA, xB, xC, xMIN, xMAX, nZONE;
@@ -2358,7 +2593,7 @@ void pm_voltage(pmc_t *pm, float uX, float uY)
 		uY *= uDC;
 	}
 
-	if (PM_CONFIG_NOP(pm) == PM_NOP_THREE_PHASE) {
+	if (PM_FV_NOP(pm, fv) == PM_NOP_THREE_PHASE) {
 
 		uA = uX;
 		uB = - 0.5f * uX + 0.8660254f * uY;
@@ -2408,7 +2643,7 @@ void pm_voltage(pmc_t *pm, float uX, float uY)
 
 		float	bA, bB, bC, bMIN, bMAX;
 
-		if (PM_CONFIG_NOP(pm) == PM_NOP_THREE_PHASE) {
+		if (PM_FV_NOP(pm, fv) == PM_NOP_THREE_PHASE) {
 
 			bA = m_fabsf(pm->lu_iX);
 			bB = m_fabsf(- 0.5f * pm->lu_iX + 0.8660254f * pm->lu_iY);
@@ -2653,7 +2888,7 @@ void pm_voltage(pmc_t *pm, float uX, float uY)
 	 * */
 	pm->proc_set_DC(xA, xB, xC);
 
-	if (PM_CONFIG_NOP(pm) == PM_NOP_THREE_PHASE) {
+	if (PM_FV_NOP(pm, fv) == PM_NOP_THREE_PHASE) {
 
 		uDC = 0.33333333f * (xA + xB + xC);
 
@@ -2676,8 +2911,13 @@ void pm_voltage(pmc_t *pm, float uX, float uY)
 	pm_clearance(pm, xA, xB, xC);
 }
 
+void pm_voltage(pmc_t *pm, float uX, float uY)
+{
+	pm_voltage_fv(pm, uX, uY, PM_FV_GENERIC);
+}
+
 static float
-pm_form_SP(pmc_t *pm, float eSP)
+pm_form_SP(pmc_t *pm, float eSP, float kDIV)
 {
 	float		iSP;
 
@@ -2696,7 +2936,10 @@ pm_form_SP(pmc_t *pm, float eSP)
 	if (		(iSP < pm->i_maximal || eSP < 0.f)
 			&& (iSP > - pm->i_reverse || eSP > 0.f)) {
 
-		pm->s_integral += pm->s_gain_I * eSP;
+		/* Integral gain is given per PWM cycle so we scale it by
+		 * the number of cycles between calls.
+		 * */
+		pm->s_integral += pm->s_gain_I * eSP * kDIV;
 	}
 
 	/* Clamp the output in accordance with CURRENT constraints.
@@ -2710,7 +2953,7 @@ pm_form_SP(pmc_t *pm, float eSP)
 static void
 pm_wattage(pmc_t *pm)
 {
-	float		wP, TiH, Wh, Ah;
+	float		wP;
 
 	/* Actual operating WATTAGE is a scalar product of voltage and current.
 	 * */
@@ -2718,6 +2961,12 @@ pm_wattage(pmc_t *pm)
 
 	pm->watt_drain_wP += (wP - pm->watt_drain_wP) * pm->watt_gain_WF;
 	pm->watt_drain_wA = pm->watt_drain_wP * pm->quick_iU;
+}
+
+static void
+pm_wattage_gauge(pmc_t *pm)
+{
+	float		TiH, Wh, Ah;
 
 	/* Traveled distance.
 	 * */
@@ -2726,7 +2975,7 @@ pm_wattage(pmc_t *pm)
 
 	if (likely(m_isfinitef(pm->watt_drain_wA) != 0)) {
 
-		TiH = pm->m_dT * 0.00027777778f;
+		TiH = pm->quick_slow_dT * 0.00027777778f;
 
 		/* Get WATT per HOUR.
 		 * */
@@ -2758,8 +3007,8 @@ pm_wattage(pmc_t *pm)
 	}
 }
 
-static void
-pm_loop_current(pmc_t *pm)
+static PM_FV_INLINE void
+pm_loop_current(pmc_t *pm, int fv)
 {
 	float		track_D, track_Q, eD, eQ, uD, uQ, uX, uY, wP;
 	float		iMAX, iREV, uMAX, uREV, wMAX, wREV, dSA, dFA;
@@ -2833,7 +3082,7 @@ pm_loop_current(pmc_t *pm)
 
 					/* Replace current setpoint by speed regulation.
 					 * */
-					track_Q = pm_form_SP(pm, 0.f - pm->lu_wS);
+					track_Q = pm_form_SP(pm, 0.f - pm->lu_wS, 1.f);
 					track_Q = (track_Q > iMAX) ? iMAX
 						: (track_Q < - iMAX) ? - iMAX : track_Q;
 				}
@@ -2863,7 +3112,7 @@ pm_loop_current(pmc_t *pm)
 				/* Blend current setpoint with speed regulation.
 				 * */
 				pm->l_blend += (blend - pm->l_blend) * pm->l_gain_LP;
-				track_Q += (pm_form_SP(pm, eSP) - track_Q) * pm->l_blend;
+				track_Q += (pm_form_SP(pm, eSP, 1.f) - track_Q) * pm->l_blend;
 			}
 		}
 
@@ -3143,7 +3392,7 @@ pm_loop_current(pmc_t *pm)
 
 		/* HF waveform synthesis.
 		 * */
-		pm_hfi_wave(pm);
+		pm_hfi_wave(pm, fv);
 
 		uHF = pm->hfi_sine * pm->quick_HFwS * pm->const_im_Ld;
 
@@ -3157,7 +3406,7 @@ pm_loop_current(pmc_t *pm)
 	uX = pm->lu_F[0] * uD - pm->lu_F[1] * uQ;
 	uY = pm->lu_F[1] * uD + pm->lu_F[0] * uQ;
 
-	pm_voltage(pm, uX, uY);
+	pm_voltage_fv(pm, uX, uY, fv);
 }
 
 static void
@@ -3179,8 +3428,8 @@ pm_loop_speed(pmc_t *pm)
 	else {
 		if (pm->config_LU_DRIVE == PM_DRIVE_SPEED) {
 
-			dSA = pm->s_accel_forward * pm->m_dT;
-			dFA = pm->s_accel_reverse * pm->m_dT;
+			dSA = pm->s_accel_forward * pm->quick_slow_dT;
+			dFA = pm->s_accel_reverse * pm->quick_slow_dT;
 
 			/* Apply acceleration constraints.
 			 * */
@@ -3203,7 +3452,8 @@ pm_loop_speed(pmc_t *pm)
 
 			/* Update current loop SETPOINT.
 			 * */
-			pm->i_setpoint_current = pm_form_SP(pm, eSP);
+			pm->i_setpoint_current = pm_form_SP(pm, eSP,
+					(float) pm->slow_DIV);
 		}
 	}
 }
@@ -3218,7 +3468,7 @@ pm_loop_location(pmc_t *pm)
 
 	/* Move location setpoint in accordance with speed setpoint.
 	 * */
-	xSP += wSP * pm->m_dT;
+	xSP += wSP * pm->quick_slow_dT;
 
 	/* Allowed location range constraints.
 	 * */
@@ -3260,12 +3510,12 @@ pm_loop_location(pmc_t *pm)
 	pm->s_setpoint_speed = wSP;
 }
 
-static void
-pm_dcu_voltage(pmc_t *pm)
+static PM_FV_INLINE void
+pm_dcu_voltage(pmc_t *pm, int fv)
 {
 	float		iA, iB, iC, uA, uB, uC, DTu;
 
-	if (PM_CONFIG_NOP(pm) == PM_NOP_THREE_PHASE) {
+	if (PM_FV_NOP(pm, fv) == PM_NOP_THREE_PHASE) {
 
 		iA = pm->lu_iX;
 		iB = - 0.5f * pm->lu_iX + 0.8660254f * pm->lu_iY;
@@ -3324,7 +3574,7 @@ pm_dcu_voltage(pmc_t *pm)
 		uC = 0.f;
 	}
 
-	if (PM_CONFIG_NOP(pm) == PM_NOP_THREE_PHASE) {
+	if (PM_FV_NOP(pm, fv) == PM_NOP_THREE_PHASE) {
 
 		uC = 0.33333333f * (uA + uB + uC);
 
@@ -3343,10 +3593,13 @@ pm_dcu_voltage(pmc_t *pm)
 	}
 }
 
-void pm_feedback(pmc_t *pm, pmfb_t *fb)
+static PM_FV_INLINE void
+pm_feedback_fv(pmc_t *pm, pmfb_t *fb, int fv)
 {
 	float		iA, iB, Q;
 
+	PM_PROF_BEGIN(pm);
+
 	if (likely(pm->vsi_AF == 0)) {
 
 		/* Get inline current A.
@@ -3386,7 +3639,7 @@ void pm_feedback(pmc_t *pm, pmfb_t *fb)
 		}
 	}
 
-	if (PM_CONFIG_NOP(pm) == PM_NOP_THREE_PHASE) {
+	if (PM_FV_NOP(pm, fv) == PM_NOP_THREE_PHASE) {
 
 		if (		   pm->vsi_AF == 0
 				&& pm->vsi_BF == 0
@@ -3484,7 +3737,7 @@ void pm_feedback(pmc_t *pm, pmfb_t *fb)
 	if (		pm->config_DCU_VOLTAGE == PM_ENABLED
 			&& pm->lu_MODE != PM_LU_DETACHED) {
 
-		pm_dcu_voltage(pm);
+		pm_dcu_voltage(pm, fv);
 	}
 	else {
 		pm->dcu_DX = 0.f;
@@ -3494,30 +3747,49 @@ void pm_feedback(pmc_t *pm, pmfb_t *fb)
 	pm->dcu_X = pm->vsi_X - pm->dcu_DX;
 	pm->dcu_Y = pm->vsi_Y - pm->dcu_DY;
 
+	PM_PROF_MARK(pm, PM_PROF_INPUT);
+
 	if (likely(pm->lu_MODE != PM_LU_DISABLED)) {
 
 		/* The observer FSM.
 		 * */
-		pm_lu_FSM(pm);
+		pm_lu_FSM(pm, fv);
+
+		PM_PROF_MARK(pm, PM_PROF_LU);
 
 		if (pm->lu_MODE == PM_LU_DETACHED) {
 
-			pm_voltage(pm, pm->vsi_X, pm->vsi_Y);
+			pm_voltage_fv(pm, pm->vsi_X, pm->vsi_Y, fv);
+
+			PM_PROF_MARK(pm, PM_PROF_VOLTAGE);
 		}
 		else {
-			if (pm->config_LU_DRIVE == PM_DRIVE_SPEED) {
+			/* Outer loops are decimated by DIV and run on the slow
+			 * cycle phase zero. The current loop gets the held
+			 * SETPOINT between slow cycles.
+			 * */
+			if (pm->slow_TIM == 0) {
 
-				pm_loop_speed(pm);
-			}
-			else if (pm->config_LU_DRIVE == PM_DRIVE_LOCATION) {
+				if (pm->config_LU_DRIVE == PM_DRIVE_SPEED) {
+
+					pm_loop_speed(pm);
+
+					PM_PROF_MARK(pm, PM_PROF_LOOP_SPEED);
+				}
+				else if (pm->config_LU_DRIVE == PM_DRIVE_LOCATION) {
+
+					pm_loop_location(pm);
+					pm_loop_speed(pm);
 
-				pm_loop_location(pm);
-				pm_loop_speed(pm);
+					PM_PROF_MARK(pm, PM_PROF_LOOP_SPEED);
+				}
 			}
 
 			/* Current loop is always enabled.
 			 * */
-			pm_loop_current(pm);
+			pm_loop_current(pm, fv);
+
+			PM_PROF_MARK(pm, PM_PROF_LOOP_CURRENT);
 
 			if (pm->kalman_POSTPONED == PM_ENABLED) {
 
@@ -3525,21 +3797,41 @@ void pm_feedback(pmc_t *pm, pmfb_t *fb)
 				 * values are output to the PWM. This allows
 				 * efficient use of CPU.
 				 * */
-				pm_kalman_forecast(pm);
+				if (pm->config_KALMAN_STEADY == PM_ENABLED) {
+
+					pm_kalman_steady(pm);
+				}
+				else {
+					pm_kalman_forecast(pm);
 
-				if (likely(pm->vsi_IF == 0)) {
+					if (likely(pm->vsi_IF == 0)) {
 
-					pm_kalman_update(pm);
+						pm_kalman_update(pm);
+					}
 				}
 
 				pm->kalman_POSTPONED = PM_DISABLED;
+
+				PM_PROF_MARK(pm, PM_PROF_KALMAN_UPDATE);
 			}
 
-			/* Wattage information.
+			/* Wattage information. The consumed energy is
+			 * counted on another slow cycle phase to spread
+			 * the load over the IRQ budget.
 			 * */
 			pm_wattage(pm);
+
+			if (pm->slow_TIM == pm->slow_DIV / 2) {
+
+				pm_wattage_gauge(pm);
+			}
+
+			PM_PROF_MARK(pm, PM_PROF_WATTAGE);
 		}
 
+		pm->slow_TIM = (pm->slow_TIM < pm->slow_DIV - 1)
+			? pm->slow_TIM + 1 : 0;
+
 		if (PM_CONFIG_DBG(pm) == PM_ENABLED) {
 
 			float		A, B;
@@ -3554,5 +3846,184 @@ void pm_feedback(pmc_t *pm, pmfb_t *fb)
 	/* The FSM is used to execute assistive routines.
 	 * */
 	pm_FSM(pm);
+
+	PM_PROF_MARK(pm, PM_PROF_FSM);
+	PM_PROF_END(pm);
+}
+
+#ifdef _PM_FV
+/* We specialize the feedback entry for the common configurations. Each
+ * variant gets its own copy of inlined code where the checks of fixed
+ * configuration fields are folded at compile time. Any other configuration is served by the
+ * generic variant which is at index zero so that zeroed pmc_t is valid.
+ * */
+static const int	pm_fv_key[] = {
+
+	PM_FV_GENERIC,
+	PM_FV_KEY(PM_NOP_THREE_PHASE, PM_FLUX_ORTEGA, PM_SENSOR_NONE, PM_HFI_NONE),
+	PM_FV_KEY(PM_NOP_TWO_PHASE, PM_FLUX_ORTEGA, PM_SENSOR_NONE, PM_HFI_NONE),
+	PM_FV_KEY(PM_NOP_THREE_PHASE, PM_FLUX_KALMAN, PM_SENSOR_NONE, PM_HFI_NONE),
+	PM_FV_KEY(PM_NOP_TWO_PHASE, PM_FLUX_KALMAN, PM_SENSOR_NONE, PM_HFI_NONE),
+	PM_FV_KEY(PM_NOP_THREE_PHASE, PM_FLUX_KALMAN, PM_SENSOR_NONE, PM_HFI_SINE),
+	PM_FV_KEY(PM_NOP_TWO_PHASE, PM_FLUX_KALMAN, PM_SENSOR_NONE, PM_HFI_SINE),
+	PM_FV_KEY(PM_NOP_THREE_PHASE, PM_FV_ANY, PM_SENSOR_HALL, PM_HFI_NONE),
+	PM_FV_KEY(PM_NOP_TWO_PHASE, PM_FV_ANY, PM_SENSOR_HALL, PM_HFI_NONE),
+	PM_FV_KEY(PM_NOP_THREE_PHASE, PM_FV_ANY, PM_SENSOR_EABI, PM_HFI_NONE),
+	PM_FV_KEY(PM_NOP_TWO_PHASE, PM_FV_ANY, PM_SENSOR_EABI, PM_HFI_NONE)
+};
+
+#define PM_FV_MAX		(int) (sizeof(pm_fv_key) / sizeof(pm_fv_key[0]))
+
+#define PM_FV_DEF(N)		static void pm_feedback_fv##N(pmc_t *pm, pmfb_t *fb) \
+				{ pm_feedback_fv(pm, fb, pm_fv_key[N]); }
+
+PM_FV_DEF(1)
+PM_FV_DEF(2)
+PM_FV_DEF(3)
+PM_FV_DEF(4)
+PM_FV_DEF(5)
+PM_FV_DEF(6)
+PM_FV_DEF(7)
+PM_FV_DEF(8)
+PM_FV_DEF(9)
+PM_FV_DEF(10)
+
+void pm_feedback_generic(pmc_t *pm, pmfb_t *fb)
+{
+	pm_feedback_fv(pm, fb, PM_FV_GENERIC);
+}
+
+static void (* const pm_fv_proc[]) (pmc_t *, pmfb_t *) = {
+
+	&pm_feedback_generic,
+	&pm_feedback_fv1,
+	&pm_feedback_fv2,
+	&pm_feedback_fv3,
+	&pm_feedback_fv4,
+	&pm_feedback_fv5,
+	&pm_feedback_fv6,
+	&pm_feedback_fv7,
+	&pm_feedback_fv8,
+	&pm_feedback_fv9,
+	&pm_feedback_fv10
+};
+
+static int
+pm_fv_match(pmc_t *pm, int fv)
+{
+	return (	   PM_FV_NOP(pm, fv) == PM_CONFIG_NOP(pm)
+			&& PM_FV_ESTIMATE(pm, fv) == pm->config_LU_ESTIMATE
+			&& PM_FV_SENSOR(pm, fv) == pm->config_LU_SENSOR
+			&& PM_FV_HFI(pm, fv) == pm->config_HFI_WAVETYPE) ? 1 : 0;
+}
+#endif /* _PM_FV */
+
+void pm_feedback_select(pmc_t *pm)
+{
+#ifdef _PM_FV
+	int		N, ID = 0;
+
+	for (N = 1; N < PM_FV_MAX; ++N) {
+
+		if (pm_fv_match(pm, pm_fv_key[N]) != 0) {
+
+			ID = N;
+			break;
+		}
+	}
+
+	pm->fv_ID = ID;
+#endif /* _PM_FV */
+}
+
+void pm_feedback(pmc_t *pm, pmfb_t *fb)
+{
+#ifdef _PM_FV
+	pm_fv_proc[pm->fv_ID](pm, fb);
+#else /* _PM_FV */
+	pm_feedback_fv(pm, fb, PM_FV_GENERIC);
+#endif /* _PM_FV */
+}
+
+#ifdef _PM_PROF
+static void
+pm_prof_stat(pm_prof_stat_t *st, uint32_t lap)
+{
+	int		bin;
+
+	st->min = (lap < st->min) ? lap : st->min;
+	st->max = (lap > st->max) ? lap : st->max;
+
+	st->N += 1;
+	st->sum += lap;
+
+	bin = (lap != 0U) ? 32 - __builtin_clz(lap) : 0;
+	bin = (bin < PM_PROF_HIST - 1) ? bin : PM_PROF_HIST - 1;
+
+	st->hist[bin] += 1;
+}
+
+void pm_prof_commit(pm_prof_t *prof)
+{
+	uint32_t	mask = prof->mask;
+	int		ID;
+
+	while (mask != 0U) {
+
+		ID = __builtin_ctz(mask);
+		mask &= mask - 1U;
+
+		pm_prof_stat(&prof->st[ID], prof->lap[ID]);
+
+		prof->lap[ID] = 0U;
+	}
+
+	pm_prof_stat(&prof->st[PM_PROF_TOTAL], prof->tLAST - prof->tBEGIN);
+
+	prof->mask = 0U;
+}
+
+void pm_prof_reset(pm_prof_t *prof)
+{
+	int		ID, N;
+
+	for (ID = 0; ID < PM_PROF_MAX; ++ID) {
+
+		prof->lap[ID] = 0U;
+
+		prof->st[ID].min = 0xFFFFFFFFU;
+		prof->st[ID].max = 0U;
+		prof->st[ID].N = 0U;
+		prof->st[ID].sum = 0U;
+
+		for (N = 0; N < PM_PROF_HIST; ++N) {
+
+			prof->st[ID].hist[N] = 0U;
+		}
+	}
+
+	prof->mask = 0U;
+}
+
+const char *pm_prof_name(int ID)
+{
+	static const char	*list[] = {
+
+		PM_SFI(PM_PROF_INPUT),
+		PM_SFI(PM_PROF_LU),
+		PM_SFI(PM_PROF_FLUX_ORTEGA),
+		PM_SFI(PM_PROF_FLUX_KALMAN),
+		PM_SFI(PM_PROF_SENSOR),
+		PM_SFI(PM_PROF_VOLTAGE),
+		PM_SFI(PM_PROF_LOOP_SPEED),
+		PM_SFI(PM_PROF_LOOP_CURRENT),
+		PM_SFI(PM_PROF_KALMAN_UPDATE),
+		PM_SFI(PM_PROF_WATTAGE),
+		PM_SFI(PM_PROF_FSM),
+		PM_SFI(PM_PROF_TOTAL),
+	};
+
+	return (ID >= 0 && ID < PM_PROF_MAX) ? list[ID] : "";
 }
+#endif /* _PM_PROF */
 
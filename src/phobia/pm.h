@@ -3,16 +3,56 @@
 
 #include "libm.h"
 #include "lse.h"
+#include "pm_prof.h"
 
 #define PM_CONFIG_NOP(pm)	(pm)->config_NOP
 #define PM_CONFIG_IFB(pm)	(pm)->config_IFB
 #define PM_CONFIG_TVM(pm)	(pm)->config_TVM
 #define PM_CONFIG_DBG(pm)	(pm)->config_DBG
 
+#ifdef _PM_FV
+
+/* Feedback variant (FV) key holds the configuration values that are fixed
+ * in specialized pm_feedback entry. Each field takes 4 bits, PM_FV_ANY
+ * means the field is taken from configuration at runtime.
+ * */
+#define PM_FV_ANY		15
+#define PM_FV_GENERIC		0xFFFF
+#define PM_FV_KEY(NOP, EST, SEN, HFI)	((NOP) | ((EST) << 4) | ((SEN) << 8) | ((HFI) << 12))
+
+#define PM_FV_FIELD(fv, n, cfg)	((((fv) >> (n)) & 15) != PM_FV_ANY ? (((fv) >> (n)) & 15) : (cfg))
+
+#define PM_FV_NOP(pm, fv)	PM_FV_FIELD(fv, 0, PM_CONFIG_NOP(pm))
+#define PM_FV_ESTIMATE(pm, fv)	PM_FV_FIELD(fv, 4, (pm)->config_LU_ESTIMATE)
+#define PM_FV_SENSOR(pm, fv)	PM_FV_FIELD(fv, 8, (pm)->config_LU_SENSOR)
+#define PM_FV_HFI(pm, fv)	PM_FV_FIELD(fv, 12, (pm)->config_HFI_WAVETYPE)
+
+/* Functions that take FV key are inlined into each variant entry.
+ * */
+#define PM_FV_INLINE		inline __attribute__ ((always_inline))
+
+#else /* _PM_FV */
+
+#define PM_FV_INLINE
+
+#define PM_FV_GENERIC		0
+
+#define PM_FV_NOP(pm, fv)	PM_CONFIG_NOP(pm)
+#define PM_FV_ESTIMATE(pm, fv)	(pm)->config_LU_ESTIMATE
+#define PM_FV_SENSOR(pm, fv)	(pm)->config_LU_SENSOR
+#define PM_FV_HFI(pm, fv)	(pm)->config_HFI_WAVETYPE
+
+#endif /* _PM_FV */
+
 #define PM_TSMS(pm, ms)		(int) ((pm)->m_freq * (ms) * 0.001f)
 #define PM_DTNS(pm, ns)		((ns) * (pm)->m_freq * 0.000000001f)
 
 #define PM_MAX_F		1000000000000.f
+#define PM_SLOW_DIV_MAX		20
+
+#define PM_KALMAN_TAB_W		8
+#define PM_KALMAN_TAB_I		6
+#define PM_KALMAN_TAB		(PM_KALMAN_TAB_W * PM_KALMAN_TAB_I)
 #define PM_SFI(s)		#s
 
 enum {
@@ -217,6 +257,9 @@ typedef struct {
 	float		m_freq;
 	float		m_dT;
 
+	int		slow_DIV;
+	int		slow_TIM;
+
 	int		dc_resolution;
 	float		dc_minimal;
 	float		dc_clearance;
@@ -252,6 +295,7 @@ typedef struct {
 	int		config_LU_FORCED;
 	int		config_LU_FREEWHEEL;
 	int		config_LU_ESTIMATE;
+	int		config_KALMAN_STEADY;
 	int		config_LU_SENSOR;
 	int		config_LU_LOCATION;
 	int		config_LU_DRIVE;
@@ -416,10 +460,13 @@ typedef struct {
 	float		flux_gain_IF;
 
 	int		kalman_POSTPONED;
+	int		kalman_STEADY;
 
 	float		kalman_P[15];
 	float		kalman_A[10];
 	float		kalman_K[10];
+	float		kalman_tab_K[PM_KALMAN_TAB][10];
+	int		kalman_tab_N[PM_KALMAN_TAB];
 	float		kalman_rsu_D;
 	float		kalman_rsu_Q;
 	float		kalman_bias_Q;
@@ -505,8 +552,12 @@ typedef struct {
 	float		quick_TiLq;
 	float		quick_TiLu[4];
 	float		quick_HFwS;
+	float		quick_HFwF[2];
 	float		quick_ZiEP;
 	float		quick_ZiSQ;
+	float		quick_slow_dT;
+	float		quick_kalman_wS;
+	float		quick_kalman_iQ;
 
 	int		watt_DC_MAX;
 	int		watt_DC_MIN;
@@ -595,8 +646,16 @@ typedef struct {
 	void 		(* proc_set_DC) (int, int, int);
 	void 		(* proc_set_Z) (int);
 
+#ifdef _PM_FV
+	int		fv_ID;
+#endif /* _PM_FV */
+
 	lfseed_t	lfseed;
 	lse_t		lse[2];
+
+#ifdef _PM_PROF
+	pm_prof_t	prof;
+#endif /* _PM_PROF */
 }
 pmc_t;
 
@@ -611,6 +670,11 @@ void pm_voltage(pmc_t *pm, float uX, float uY);
 
 void pm_FSM(pmc_t *pm);
 void pm_feedback(pmc_t *pm, pmfb_t *fb);
+void pm_feedback_select(pmc_t *pm);
+
+#ifdef _PM_FV
+void pm_feedback_generic(pmc_t *pm, pmfb_t *fb);
+#endif /* _PM_FV */
 
 const char *pm_strerror(int fsm_errno);
 
@@ -1108,7 +1108,7 @@ pm_fsm_probe_loop_current(pmc_t *pm, float track_HF)
 
 	if (track_HF > M_EPSILON) {
 
-		m_rotatef(pm->hfi_wave, pm->quick_HFwS * pm->m_dT);
+		m_turnf(pm->hfi_wave, pm->quick_HFwF);
 		m_normalizef(pm->hfi_wave);
 
 		uD += uHF * pm->hfi_wave[0];
@@ -1124,7 +1124,7 @@ pm_fsm_state_adjust_dcu_voltage(pmc_t *pm)
 	lse_t			*ls = &pm->lse[0];
 	lse_float_t		v[5];
 
-	float			hold_A, ramp_A, Rz;
+	float			hold_A = 0.f, ramp_A, Rz;
 
 	switch (pm->fsm_phase) {
 
@@ -1168,8 +1168,7 @@ pm_fsm_state_adjust_dcu_voltage(pmc_t *pm)
 					break;
 			}
 
-			pm->probe_HOLD[0] = m_cosf(hold_A);
-			pm->probe_HOLD[1] = m_sinf(hold_A);
+			m_cossinf(pm->probe_HOLD, hold_A);
 
 			pm->i_integral_D = 0.f;
 			pm->i_integral_Q = 0.f;
@@ -1359,8 +1358,7 @@ pm_fsm_state_probe_const_resistance(pmc_t *pm)
 
 			hold_A = pm->probe_hold_angle * (M_PI_F / 180.f);
 
-			pm->probe_HOLD[0] = m_cosf(hold_A);
-			pm->probe_HOLD[1] = m_sinf(hold_A);
+			m_cossinf(pm->probe_HOLD, hold_A);
 
 			pm->i_integral_D = 0.f;
 			pm->i_integral_Q = 0.f;
@@ -1514,8 +1512,8 @@ pm_fsm_state_probe_const_inductance(pmc_t *pm)
 
 			pm->quick_HFwS = M_2_PI_F * pm->probe_freq_sine;
 
-			pm->probe_WS[0] = m_cosf(pm->quick_HFwS * pm->m_dT * 0.5f);
-			pm->probe_WS[1] = m_sinf(pm->quick_HFwS * pm->m_dT * 0.5f);
+			m_rotorf(pm->quick_HFwF, pm->quick_HFwS * pm->m_dT);
+			m_cossinf(pm->probe_WS, pm->quick_HFwS * pm->m_dT * 0.5f);
 
 			pm->probe_HF[0] = 0.f;
 			pm->probe_HF[1] = 0.f;
@@ -1526,8 +1524,10 @@ pm_fsm_state_probe_const_inductance(pmc_t *pm)
 
 			hold_A = pm->probe_hold_angle * (M_PI_F / 180.f);
 
-			pm->i_track_D = m_cosf(hold_A) * pm->probe_current_bias;
-			pm->i_track_Q = m_sinf(hold_A) * pm->probe_current_bias;
+			m_cossinf(pm->probe_HOLD, hold_A);
+
+			pm->i_track_D = pm->probe_HOLD[0] * pm->probe_current_bias;
+			pm->i_track_Q = pm->probe_HOLD[1] * pm->probe_current_bias;
 
 			pm->i_integral_D = 0.f;
 			pm->i_integral_Q = 0.f;
@@ -1657,6 +1657,7 @@ pm_fsm_state_lu_startup(pmc_t *pm, int in_ZONE)
 				pm->lu_wS_prev = 0.f;
 
 				pm->base_TIM = 0;
+				pm->slow_TIM = 0;
 				pm->hold_TIM = 0;
 
 				pm->forced_F[0] = 1.f;
@@ -2340,8 +2341,7 @@ pm_fsm_state_adjust_sensor_eabi(pmc_t *pm)
 
 					if (m_isfinitef(ls->sol.m[0]) != 0) {
 
-						pm->eabi_F0[0] = m_cosf(ls->sol.m[0]);
-						pm->eabi_F0[1] = m_sinf(ls->sol.m[0]);
+						m_cossinf(pm->eabi_F0, ls->sol.m[0]);
 
 						pm->eabi_ADJUST = PM_ENABLED;
 					}
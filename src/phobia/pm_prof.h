@@ -0,0 +1,88 @@
+#ifndef _H_PM_PROF_
+#define _H_PM_PROF_
+
+#ifdef _PM_PROF
+
+#include <stdint.h>
+
+#define PM_PROF_HIST		16
+
+/* The clock source of stage probes. On target this is DWT cycle counter
+ * that must be enabled by HAL, in bench this is host TSC.
+ * */
+#if defined(__ARM_ARCH_7EM__)
+#define PM_PROF_CLOCK()		(* (volatile uint32_t *) 0xE0001004U)
+#elif defined(__x86_64__) || defined(__i386__)
+#define PM_PROF_CLOCK()		((uint32_t) __builtin_ia32_rdtsc())
+#else
+#error "No cycle counter for stage probes on this platform"
+#endif
+
+/* We attribute the cycles elapsed since previous probe to the stage ID. A
+ * stage can be marked several times during one call, the statistics are
+ * updated once at the end of call.
+ * */
+#define PM_PROF_BEGIN(pm)	{ (pm)->prof.tBEGIN = PM_PROF_CLOCK(); \
+				  (pm)->prof.tLAST = (pm)->prof.tBEGIN; }
+#define PM_PROF_MARK(pm, ID)	{ uint32_t tNOW = PM_PROF_CLOCK(); \
+				  (pm)->prof.lap[ID] += tNOW - (pm)->prof.tLAST; \
+				  (pm)->prof.tLAST = tNOW; \
+				  (pm)->prof.mask |= 1U << (ID); }
+#define PM_PROF_END(pm)		{ pm_prof_commit(&(pm)->prof); }
+
+enum {
+	PM_PROF_INPUT			= 0,
+	PM_PROF_LU,
+	PM_PROF_FLUX_ORTEGA,
+	PM_PROF_FLUX_KALMAN,
+	PM_PROF_SENSOR,
+	PM_PROF_VOLTAGE,
+	PM_PROF_LOOP_SPEED,
+	PM_PROF_LOOP_CURRENT,
+	PM_PROF_KALMAN_UPDATE,
+	PM_PROF_WATTAGE,
+	PM_PROF_FSM,
+	PM_PROF_TOTAL,
+	PM_PROF_MAX
+};
+
+typedef struct {
+
+	uint32_t	min;
+	uint32_t	max;
+	uint32_t	N;
+	uint64_t	sum;
+
+	/* Number of calls in each power of two range of cycles.
+	 * */
+	uint32_t	hist[PM_PROF_HIST];
+}
+pm_prof_stat_t;
+
+typedef struct {
+
+	uint32_t	tBEGIN;
+	uint32_t	tLAST;
+	uint32_t	mask;
+
+	uint32_t	lap[PM_PROF_MAX];
+
+	pm_prof_stat_t	st[PM_PROF_MAX];
+}
+pm_prof_t;
+
+void pm_prof_commit(pm_prof_t *prof);
+void pm_prof_reset(pm_prof_t *prof);
+
+const char *pm_prof_name(int ID);
+
+#else /* _PM_PROF */
+
+#define PM_PROF_BEGIN(pm)
+#define PM_PROF_MARK(pm, ID)
+#define PM_PROF_END(pm)
+
+#endif /* _PM_PROF */
+
+#endif /* _H_PM_PROF_ */
+
@@ -238,6 +238,56 @@ SH_DEF(pm_analysis_impedance)
 	tlm_halt(&tlm);
 }
 
+#ifdef _PM_PROF
+SH_DEF(pm_prof_report)
+{
+	pm_prof_stat_t	st;
+	float		mean, us;
+	int		ID, N, irq;
+
+	printf("stage                  N          min    mean   max    us" EOL);
+
+	for (ID = 0; ID < PM_PROF_MAX; ++ID) {
+
+		/* We take a copy as statistics are updated from ISR.
+		 * */
+		irq = hal_lock_irq();
+		st = pm.prof.st[ID];
+		hal_unlock_irq(irq);
+
+		if (st.N == 0U)
+			continue;
+
+		mean = (float) st.sum / (float) st.N;
+		us = mean * 1000000.f / (float) clock_cpu_hz;
+
+		printf("%22s %10i %6i %4g %6i %4g" EOL, pm_prof_name(ID),
+				(int) st.N, (int) st.min, &mean,
+				(int) st.max, &us);
+
+		for (N = 0; N < PM_PROF_HIST; ++N) {
+
+			if (st.hist[N] != 0U) {
+
+				printf("%22s <%i %i" EOL, "", 1 << N,
+						(int) st.hist[N]);
+			}
+		}
+	}
+}
+#endif /* _PM_PROF */
+
+#ifdef _PM_PROF
+SH_DEF(pm_prof_reset)
+{
+	int		irq;
+
+	irq = hal_lock_irq();
+	pm_prof_reset(&pm.prof);
+	hal_unlock_irq(irq);
+}
+#endif /* _PM_PROF */
+
 SH_DEF(hal_ADC_scan)
 {
 	int			xCH, xGPIO;
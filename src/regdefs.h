@@ -45,6 +45,7 @@ ID_HAL_CNT_DIAG2_PC,
 #ifdef HW_HAVE_NETWORK_EPCAN
 ID_NET_NODE_ID,
 ID_NET_LOG_MODE,
+ID_NET_FLOW_MODE,
 ID_NET_TIMEOUT_EP,
 ID_NET_EP0_MODE,
 ID_NET_EP0_ID,
@@ -56,6 +57,15 @@ ID_NET_EP0_STARTUP,
 ID_NET_EP0_RATE,
 ID_NET_EP0_RANGE0,
 ID_NET_EP0_RANGE1,
+ID_NET_EP0_PACK0_ID,
+ID_NET_EP0_PACK0_RANGE0,
+ID_NET_EP0_PACK0_RANGE1,
+ID_NET_EP0_PACK1_ID,
+ID_NET_EP0_PACK1_RANGE0,
+ID_NET_EP0_PACK1_RANGE1,
+ID_NET_EP0_PACK2_ID,
+ID_NET_EP0_PACK2_RANGE0,
+ID_NET_EP0_PACK2_RANGE1,
 ID_NET_EP1_MODE,
 ID_NET_EP1_ID,
 ID_NET_EP1_CLOCK_ID,
@@ -66,6 +76,15 @@ ID_NET_EP1_STARTUP,
 ID_NET_EP1_RATE,
 ID_NET_EP1_RANGE0,
 ID_NET_EP1_RANGE1,
+ID_NET_EP1_PACK0_ID,
+ID_NET_EP1_PACK0_RANGE0,
+ID_NET_EP1_PACK0_RANGE1,
+ID_NET_EP1_PACK1_ID,
+ID_NET_EP1_PACK1_RANGE0,
+ID_NET_EP1_PACK1_RANGE1,
+ID_NET_EP1_PACK2_ID,
+ID_NET_EP1_PACK2_RANGE0,
+ID_NET_EP1_PACK2_RANGE1,
 ID_NET_EP2_MODE,
 ID_NET_EP2_ID,
 ID_NET_EP2_CLOCK_ID,
@@ -76,6 +95,15 @@ ID_NET_EP2_STARTUP,
 ID_NET_EP2_RATE,
 ID_NET_EP2_RANGE0,
 ID_NET_EP2_RANGE1,
+ID_NET_EP2_PACK0_ID,
+ID_NET_EP2_PACK0_RANGE0,
+ID_NET_EP2_PACK0_RANGE1,
+ID_NET_EP2_PACK1_ID,
+ID_NET_EP2_PACK1_RANGE0,
+ID_NET_EP2_PACK1_RANGE1,
+ID_NET_EP2_PACK2_ID,
+ID_NET_EP2_PACK2_RANGE0,
+ID_NET_EP2_PACK2_RANGE1,
 ID_NET_EP3_MODE,
 ID_NET_EP3_ID,
 ID_NET_EP3_CLOCK_ID,
@@ -86,6 +114,15 @@ ID_NET_EP3_STARTUP,
 ID_NET_EP3_RATE,
 ID_NET_EP3_RANGE0,
 ID_NET_EP3_RANGE1,
+ID_NET_EP3_PACK0_ID,
+ID_NET_EP3_PACK0_RANGE0,
+ID_NET_EP3_PACK0_RANGE1,
+ID_NET_EP3_PACK1_ID,
+ID_NET_EP3_PACK1_RANGE0,
+ID_NET_EP3_PACK1_RANGE1,
+ID_NET_EP3_PACK2_ID,
+ID_NET_EP3_PACK2_RANGE0,
+ID_NET_EP3_PACK2_RANGE1,
 #endif /* HW_HAVE_NETWORK_EPCAN */
 ID_AP_PPM_PULSE,
 ID_AP_PPM_FREQ,
@@ -170,11 +207,13 @@ ID_AP_TASK_SPI_MPU6050,
 ID_AP_AUTO_REG_DATA,
 ID_AP_AUTO_REG_ID,
 ID_AP_LOAD_HX711,
+ID_AP_FLASH_PROFILE,
 ID_PM_DC_RESOLUTION,
 ID_PM_DC_MINIMAL,
 ID_PM_DC_CLEARANCE,
 ID_PM_DC_SKIP,
 ID_PM_DC_BOOTSTRAP,
+ID_PM_SLOW_DIV,
 ID_PM_SELF_BST,
 ID_PM_SELF_IST,
 ID_PM_SELF_STDI,
@@ -192,6 +231,7 @@ ID_PM_CONFIG_DCU_VOLTAGE,
 ID_PM_CONFIG_LU_FORCED,
 ID_PM_CONFIG_LU_FREEWHEEL,
 ID_PM_CONFIG_LU_ESTIMATE,
+ID_PM_CONFIG_KALMAN_STEADY,
 ID_PM_CONFIG_LU_SENSOR,
 ID_PM_CONFIG_LU_LOCATION,
 ID_PM_CONFIG_LU_DRIVE,
@@ -510,6 +550,10 @@ ID_TLM_RATE_GRAB,
 ID_TLM_RATE_WATCH,
 ID_TLM_RATE_LIVE,
 ID_TLM_MODE,
+ID_TLM_TRIG_REG_ID,
+ID_TLM_TRIG_MODE,
+ID_TLM_TRIG_LEVEL,
+ID_TLM_TRIG_PRE,
 ID_TLM_REG_ID0,
 ID_TLM_REG_ID1,
 ID_TLM_REG_ID2,
@@ -530,3 +574,43 @@ ID_TLM_REG_ID16,
 ID_TLM_REG_ID17,
 ID_TLM_REG_ID18,
 ID_TLM_REG_ID19,
+ID_TLM_REG_DIV0,
+ID_TLM_REG_DIV1,
+ID_TLM_REG_DIV2,
+ID_TLM_REG_DIV3,
+ID_TLM_REG_DIV4,
+ID_TLM_REG_DIV5,
+ID_TLM_REG_DIV6,
+ID_TLM_REG_DIV7,
+ID_TLM_REG_DIV8,
+ID_TLM_REG_DIV9,
+ID_TLM_REG_DIV10,
+ID_TLM_REG_DIV11,
+ID_TLM_REG_DIV12,
+ID_TLM_REG_DIV13,
+ID_TLM_REG_DIV14,
+ID_TLM_REG_DIV15,
+ID_TLM_REG_DIV16,
+ID_TLM_REG_DIV17,
+ID_TLM_REG_DIV18,
+ID_TLM_REG_DIV19,
+ID_TLM_REG_PACK0,
+ID_TLM_REG_PACK1,
+ID_TLM_REG_PACK2,
+ID_TLM_REG_PACK3,
+ID_TLM_REG_PACK4,
+ID_TLM_REG_PACK5,
+ID_TLM_REG_PACK6,
+ID_TLM_REG_PACK7,
+ID_TLM_REG_PACK8,
+ID_TLM_REG_PACK9,
+ID_TLM_REG_PACK10,
+ID_TLM_REG_PACK11,
+ID_TLM_REG_PACK12,
+ID_TLM_REG_PACK13,
+ID_TLM_REG_PACK14,
+ID_TLM_REG_PACK15,
+ID_TLM_REG_PACK16,
+ID_TLM_REG_PACK17,
+ID_TLM_REG_PACK18,
+ID_TLM_REG_PACK19,
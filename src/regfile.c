@@ -317,6 +317,79 @@ reg_proc_ppm_freq(const reg_t *reg, rval_t *lval, const rval_t *rval)
 	}
 }
 
+static void
+reg_proc_flash_profile(const reg_t *reg, rval_t *lval, const rval_t *rval)
+{
+	if (lval != NULL) {
+
+		lval->i = reg->link->i;
+	}
+	else if (rval != NULL) {
+
+		/* We load the profile instead of just writing its number.
+		 * */
+		flash_profile_switch(rval->i);
+	}
+}
+
+static void
+reg_proc_config_fv(const reg_t *reg, rval_t *lval, const rval_t *rval)
+{
+	if (lval != NULL) {
+
+		lval->i = reg->link->i;
+	}
+	else if (rval != NULL) {
+
+		reg->link->i = rval->i;
+
+		hal_memory_fence();
+
+		/* Feedback variant depends on this configuration.
+		 * */
+		pm_feedback_select(&pm);
+	}
+}
+
+static void
+reg_proc_slow_DIV(const reg_t *reg, rval_t *lval, const rval_t *rval)
+{
+	if (lval != NULL) {
+
+		lval->i = reg->link->i;
+	}
+	else if (rval != NULL) {
+
+		/* Slow cycle timing is built on startup so we do not allow
+		 * to change it on the fly.
+		 * */
+		if (pm.lu_MODE == PM_LU_DISABLED) {
+
+			reg->link->i = (rval->i < 1) ? 1
+				: (rval->i > PM_SLOW_DIV_MAX) ? PM_SLOW_DIV_MAX : rval->i;
+		}
+	}
+}
+
+static void
+reg_proc_kalman_steady(const reg_t *reg, rval_t *lval, const rval_t *rval)
+{
+	if (lval != NULL) {
+
+		lval->i = reg->link->i;
+	}
+	else if (rval != NULL) {
+
+		/* Kalman covariance is kept in DQ-axes while steady gains are
+		 * in use so we do not allow to change it on the fly.
+		 * */
+		if (pm.lu_MODE == PM_LU_DISABLED) {
+
+			reg->link->i = rval->i;
+		}
+	}
+}
+
 static void
 reg_proc_rpm(const reg_t *reg, rval_t *lval, const rval_t *rval)
 {
@@ -948,6 +1021,29 @@ reg_proc_tlm_rate(const reg_t *reg, rval_t *lval, const rval_t *rval)
 	}
 }
 
+static void
+reg_proc_tlm_div(const reg_t *reg, rval_t *lval, const rval_t *rval)
+{
+	if (lval != NULL) {
+
+		lval->i = reg->link->i;
+	}
+	else if (rval != NULL) {
+
+		int		div = 1;
+
+		/* Round down to a power of two.
+		 * */
+		while (		div * 2 <= rval->i
+				&& div * 2 <= TLM_DIV_MAX) {
+
+			div *= 2;
+		}
+
+		reg->link->i = div;
+	}
+}
+
 #ifdef HW_HAVE_DRV_ON_PCB
 static void
 reg_format_DRV_gate_current(const reg_t *reg, const rval_t *rval)
@@ -1230,6 +1326,17 @@ reg_format_enumerate(const reg_t *reg, const rval_t *rval)
 			}
 			break;
 
+		case ID_NET_FLOW_MODE:
+
+			switch (val) {
+
+				PM_SFI_CASE(EPCAN_FLOW_DISABLED);
+				PM_SFI_CASE(EPCAN_FLOW_WINDOWED);
+
+				default: break;
+			}
+			break;
+
 		case ID_NET_EP0_MODE:
 		case ID_NET_EP1_MODE:
 		case ID_NET_EP2_MODE:
@@ -1269,6 +1376,8 @@ reg_format_enumerate(const reg_t *reg, const rval_t *rval)
 
 				PM_SFI_CASE(EPCAN_PAYLOAD_FLOAT);
 				PM_SFI_CASE(EPCAN_PAYLOAD_INT_16);
+				PM_SFI_CASE(EPCAN_PAYLOAD_PACK_FLOAT);
+				PM_SFI_CASE(EPCAN_PAYLOAD_PACK_INT_16);
 
 				default: break;
 			}
@@ -1358,6 +1467,7 @@ reg_format_enumerate(const reg_t *reg, const rval_t *rval)
 		case ID_PM_CONFIG_DCU_VOLTAGE:
 		case ID_PM_CONFIG_LU_FORCED:
 		case ID_PM_CONFIG_LU_FREEWHEEL:
+		case ID_PM_CONFIG_KALMAN_STEADY:
 		case ID_PM_CONFIG_HFI_PERMANENT:
 		case ID_PM_CONFIG_RELUCTANCE:
 		case ID_PM_CONFIG_WEAKENING:
@@ -1560,6 +1670,52 @@ reg_format_enumerate(const reg_t *reg, const rval_t *rval)
 				PM_SFI_CASE(TLM_MODE_GRAB);
 				PM_SFI_CASE(TLM_MODE_WATCH);
 				PM_SFI_CASE(TLM_MODE_LIVE);
+				PM_SFI_CASE(TLM_MODE_STREAM);
+				PM_SFI_CASE(TLM_MODE_TRIGGER);
+
+				default: break;
+			}
+			break;
+
+		case ID_TLM_REG_PACK0:
+		case ID_TLM_REG_PACK1:
+		case ID_TLM_REG_PACK2:
+		case ID_TLM_REG_PACK3:
+		case ID_TLM_REG_PACK4:
+		case ID_TLM_REG_PACK5:
+		case ID_TLM_REG_PACK6:
+		case ID_TLM_REG_PACK7:
+		case ID_TLM_REG_PACK8:
+		case ID_TLM_REG_PACK9:
+		case ID_TLM_REG_PACK10:
+		case ID_TLM_REG_PACK11:
+		case ID_TLM_REG_PACK12:
+		case ID_TLM_REG_PACK13:
+		case ID_TLM_REG_PACK14:
+		case ID_TLM_REG_PACK15:
+		case ID_TLM_REG_PACK16:
+		case ID_TLM_REG_PACK17:
+		case ID_TLM_REG_PACK18:
+		case ID_TLM_REG_PACK19:
+
+			switch (val) {
+
+				PM_SFI_CASE(TLM_PACK_FULL);
+				PM_SFI_CASE(TLM_PACK_HALF);
+
+				default: break;
+			}
+			break;
+
+		case ID_TLM_TRIG_MODE:
+
+			switch (val) {
+
+				PM_SFI_CASE(TLM_TRIG_ABOVE);
+				PM_SFI_CASE(TLM_TRIG_BELOW);
+				PM_SFI_CASE(TLM_TRIG_RISING);
+				PM_SFI_CASE(TLM_TRIG_FALLING);
+				PM_SFI_CASE(TLM_TRIG_CHANGE);
 
 				default: break;
 			}
@@ -1638,6 +1794,7 @@ const reg_t		regfile[] = {
 #ifdef HW_HAVE_NETWORK_EPCAN
 	REG_DEF(net.node_ID,,,		"",	"%0i",	REG_CONFIG, &reg_proc_CAN_ID, NULL),
 	REG_DEF(net.log_MODE,,,		"",	"%0i",	REG_CONFIG, &reg_proc_CAN_ID, &reg_format_enum),
+	REG_DEF(net.flow_MODE,,,	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
 	REG_DEF(net.timeout_EP,,,	"ms",	"%1f",	REG_CONFIG, &reg_proc_CAN_timeout, NULL),
 
 	REG_DEF(net.ep, 0_MODE, [0].MODE,"",		"%0i",	REG_CONFIG, &reg_proc_CAN_ID, &reg_format_enum),
@@ -1650,6 +1807,15 @@ const reg_t		regfile[] = {
 	REG_DEF(net.ep, 0_rate, [0].rate, "Hz",		"%1f",	REG_CONFIG, &reg_proc_CAN_epfreq, NULL),
 	REG_DEF(net.ep, 0_range0, [0].range[0],"",	"%4f",	REG_CONFIG, NULL, &reg_format_ref_net_ep0),
 	REG_DEF(net.ep, 0_range1, [0].range[1],"",	"%4f",	REG_CONFIG, NULL, &reg_format_ref_net_ep0),
+	REG_DEF(net.ep, 0_pack0_ID, [0].pack_ID[0],"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
+	REG_DEF(net.ep, 0_pack0_range0, [0].pack_range[0][0],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 0_pack0_range1, [0].pack_range[0][1],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 0_pack1_ID, [0].pack_ID[1],"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
+	REG_DEF(net.ep, 0_pack1_range0, [0].pack_range[1][0],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 0_pack1_range1, [0].pack_range[1][1],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 0_pack2_ID, [0].pack_ID[2],"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
+	REG_DEF(net.ep, 0_pack2_range0, [0].pack_range[2][0],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 0_pack2_range1, [0].pack_range[2][1],"",	"%4f",	REG_CONFIG, NULL, NULL),
 
 	REG_DEF(net.ep, 1_MODE, [1].MODE,"",		"%0i",	REG_CONFIG, &reg_proc_CAN_ID, &reg_format_enum),
 	REG_DEF(net.ep, 1_ID, [1].ID,"",		"%0i",	REG_CONFIG, &reg_proc_CAN_ID, NULL),
@@ -1661,6 +1827,15 @@ const reg_t		regfile[] = {
 	REG_DEF(net.ep, 1_rate, [1].rate, "Hz",		"%1f",	REG_CONFIG, &reg_proc_CAN_epfreq, NULL),
 	REG_DEF(net.ep, 1_range0, [1].range[0],"",	"%4f",	REG_CONFIG, NULL, &reg_format_ref_net_ep1),
 	REG_DEF(net.ep, 1_range1, [1].range[1],"",	"%4f",	REG_CONFIG, NULL, &reg_format_ref_net_ep1),
+	REG_DEF(net.ep, 1_pack0_ID, [1].pack_ID[0],"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
+	REG_DEF(net.ep, 1_pack0_range0, [1].pack_range[0][0],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 1_pack0_range1, [1].pack_range[0][1],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 1_pack1_ID, [1].pack_ID[1],"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
+	REG_DEF(net.ep, 1_pack1_range0, [1].pack_range[1][0],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 1_pack1_range1, [1].pack_range[1][1],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 1_pack2_ID, [1].pack_ID[2],"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
+	REG_DEF(net.ep, 1_pack2_range0, [1].pack_range[2][0],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 1_pack2_range1, [1].pack_range[2][1],"",	"%4f",	REG_CONFIG, NULL, NULL),
 
 	REG_DEF(net.ep, 2_MODE, [2].MODE,"",		"%0i",	REG_CONFIG, &reg_proc_CAN_ID, &reg_format_enum),
 	REG_DEF(net.ep, 2_ID, [2].ID,"",		"%0i",	REG_CONFIG, &reg_proc_CAN_ID, NULL),
@@ -1672,6 +1847,15 @@ const reg_t		regfile[] = {
 	REG_DEF(net.ep, 2_rate, [2].rate, "Hz",		"%1f",	REG_CONFIG, &reg_proc_CAN_epfreq, NULL),
 	REG_DEF(net.ep, 2_range0, [2].range[0],"",	"%4f",	REG_CONFIG, NULL, &reg_format_ref_net_ep2),
 	REG_DEF(net.ep, 2_range1, [2].range[1],"",	"%4f",	REG_CONFIG, NULL, &reg_format_ref_net_ep2),
+	REG_DEF(net.ep, 2_pack0_ID, [2].pack_ID[0],"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
+	REG_DEF(net.ep, 2_pack0_range0, [2].pack_range[0][0],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 2_pack0_range1, [2].pack_range[0][1],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 2_pack1_ID, [2].pack_ID[1],"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
+	REG_DEF(net.ep, 2_pack1_range0, [2].pack_range[1][0],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 2_pack1_range1, [2].pack_range[1][1],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 2_pack2_ID, [2].pack_ID[2],"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
+	REG_DEF(net.ep, 2_pack2_range0, [2].pack_range[2][0],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 2_pack2_range1, [2].pack_range[2][1],"",	"%4f",	REG_CONFIG, NULL, NULL),
 
 	REG_DEF(net.ep, 3_MODE, [3].MODE,"",		"%0i",	REG_CONFIG, &reg_proc_CAN_ID, &reg_format_enum),
 	REG_DEF(net.ep, 3_ID, [3].ID,"",		"%0i",	REG_CONFIG, &reg_proc_CAN_ID, NULL),
@@ -1683,6 +1867,15 @@ const reg_t		regfile[] = {
 	REG_DEF(net.ep, 3_rate, [3].rate, "Hz",		"%1f",	REG_CONFIG, &reg_proc_CAN_epfreq, NULL),
 	REG_DEF(net.ep, 3_range0, [3].range[0],"",	"%4f",	REG_CONFIG, NULL, &reg_format_ref_net_ep3),
 	REG_DEF(net.ep, 3_range1, [3].range[1],"",	"%4f",	REG_CONFIG, NULL, &reg_format_ref_net_ep3),
+	REG_DEF(net.ep, 3_pack0_ID, [3].pack_ID[0],"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
+	REG_DEF(net.ep, 3_pack0_range0, [3].pack_range[0][0],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 3_pack0_range1, [3].pack_range[0][1],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 3_pack1_ID, [3].pack_ID[1],"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
+	REG_DEF(net.ep, 3_pack1_range0, [3].pack_range[1][0],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 3_pack1_range1, [3].pack_range[1][1],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 3_pack2_ID, [3].pack_ID[2],"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
+	REG_DEF(net.ep, 3_pack2_range0, [3].pack_range[2][0],"",	"%4f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(net.ep, 3_pack2_range1, [3].pack_range[2][1],"",	"%4f",	REG_CONFIG, NULL, NULL),
 #endif /* HW_HAVE_NETWORK_EPCAN */
 
 	REG_DEF(ap.ppm_PULSE,,,			"ms",	"%4f",	REG_READ_ONLY, NULL, NULL),
@@ -1779,12 +1972,14 @@ const reg_t		regfile[] = {
 	REG_DEF(ap.auto_reg_ID,,,		"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
 
 	REG_DEF(ap.load_HX711,,,		"",	"%0i",	REG_READ_ONLY, NULL, NULL),
+	REG_DEF(ap.flash_PROFILE,,,		"",	"%0i",	0, &reg_proc_flash_profile, NULL),
 
 	REG_DEF(pm.dc_resolution,,,		"",	"%0i",	REG_READ_ONLY, NULL, NULL),
 	REG_DEF(pm.dc_minimal,,,		"us",	"%3f",	REG_CONFIG, NULL, NULL),
 	REG_DEF(pm.dc_clearance,,,		"us",	"%3f",	REG_CONFIG, NULL, NULL),
 	REG_DEF(pm.dc_skip,,,			"us",	"%3f",	REG_CONFIG, NULL, NULL),
 	REG_DEF(pm.dc_bootstrap,,,		"ms",	"%1f",	REG_CONFIG, NULL, NULL),
+	REG_DEF(pm.slow_DIV,,,			"",	"%0i",	REG_CONFIG, &reg_proc_slow_DIV, NULL),
 
 	REG_DEF(pm.self_BST,,,			"",	"%0i",	REG_READ_ONLY, NULL, &reg_format_self_BST),
 	REG_DEF(pm.self_IST,,,			"",	"%0i",	REG_READ_ONLY, NULL, &reg_format_self_IST),
@@ -1794,7 +1989,7 @@ const reg_t		regfile[] = {
 	REG_DEF(pm.self_RMSt,,,			"",	"%0i",	REG_READ_ONLY, NULL, &reg_format_self_RMSt),
 	REG_DEF(pm.self_DTu,,,			"V",	"%4f",	REG_READ_ONLY, NULL, NULL),
 
-	REG_DEF(pm.config_NOP,,,		"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(pm.config_NOP,,,		"",	"%0i",	REG_CONFIG, &reg_proc_config_fv, &reg_format_enum),
 	REG_DEF(pm.config_IFB,,,		"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
 	REG_DEF(pm.config_TVM,,,		"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
 	REG_DEF(pm.config_DBG,,,		"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
@@ -1804,11 +1999,12 @@ const reg_t		regfile[] = {
 	REG_DEF(pm.config_DCU_VOLTAGE,,,	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
 	REG_DEF(pm.config_LU_FORCED,,,		"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
 	REG_DEF(pm.config_LU_FREEWHEEL,,,	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
-	REG_DEF(pm.config_LU_ESTIMATE,,,	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
-	REG_DEF(pm.config_LU_SENSOR,,,		"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(pm.config_LU_ESTIMATE,,,	"",	"%0i",	REG_CONFIG, &reg_proc_config_fv, &reg_format_enum),
+	REG_DEF(pm.config_KALMAN_STEADY,,,	"",	"%0i",	REG_CONFIG, &reg_proc_kalman_steady, &reg_format_enum),
+	REG_DEF(pm.config_LU_SENSOR,,,		"",	"%0i",	REG_CONFIG, &reg_proc_config_fv, &reg_format_enum),
 	REG_DEF(pm.config_LU_LOCATION,,,	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
 	REG_DEF(pm.config_LU_DRIVE,,,		"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
-	REG_DEF(pm.config_HFI_WAVETYPE,,,	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(pm.config_HFI_WAVETYPE,,,	"",	"%0i",	REG_CONFIG, &reg_proc_config_fv, &reg_format_enum),
 	REG_DEF(pm.config_HFI_PERMANENT,,,	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
 	REG_DEF(pm.config_EXCITATION,,,		"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
 	REG_DEF(pm.config_SALIENCY,,,		"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
@@ -2155,6 +2351,11 @@ const reg_t		regfile[] = {
 	REG_DEF(tlm.rate_live,,,		"Hz",	"%1f",	REG_CONFIG, &reg_proc_tlm_rate, NULL),
 	REG_DEF(tlm.mode,,,			"",	"%0i",	REG_READ_ONLY, NULL, &reg_format_enum),
 
+	REG_DEF(tlm.trig_reg_ID,,,		"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
+	REG_DEF(tlm.trig_MODE,,,		"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.trig_level,,,		"",	"%4g",	REG_CONFIG, NULL, NULL),
+	REG_DEF(tlm.trig_pre,,,			"%",	"%1f",	REG_CONFIG, NULL, NULL),
+
 	REG_DEF(tlm.reg_ID, 0, [0],		"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
 	REG_DEF(tlm.reg_ID, 1, [1],		"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
 	REG_DEF(tlm.reg_ID, 2, [2],		"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
@@ -2177,9 +2378,67 @@ const reg_t		regfile[] = {
 	REG_DEF(tlm.reg_ID, 18, [18],		"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
 	REG_DEF(tlm.reg_ID, 19, [19],		"",	"%0i",	REG_CONFIG | REG_LINKED, NULL, NULL),
 
+	REG_DEF(tlm.reg_div, 0, [0],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 1, [1],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 2, [2],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 3, [3],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 4, [4],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 5, [5],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 6, [6],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 7, [7],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 8, [8],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 9, [9],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+
+	REG_DEF(tlm.reg_div, 10, [10],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 11, [11],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 12, [12],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 13, [13],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 14, [14],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 15, [15],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 16, [16],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 17, [17],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 18, [18],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+	REG_DEF(tlm.reg_div, 19, [19],	"",	"%0i",	REG_CONFIG, &reg_proc_tlm_div, NULL),
+
+	REG_DEF(tlm.reg_pack, 0, [0],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 1, [1],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 2, [2],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 3, [3],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 4, [4],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 5, [5],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 6, [6],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 7, [7],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 8, [8],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 9, [9],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+
+	REG_DEF(tlm.reg_pack, 10, [10],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 11, [11],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 12, [12],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 13, [13],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 14, [14],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 15, [15],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 16, [16],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 17, [17],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 18, [18],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+	REG_DEF(tlm.reg_pack, 19, [19],	"",	"%0i",	REG_CONFIG, NULL, &reg_format_enum),
+
 	{ NULL, "", 0, NULL, NULL, NULL }
 };
 
+/* Register IDs sorted by symbolic name. It is generated by mkconfig.
+ * */
+static const uint16_t	regindex[] = {
+
+#include "regindex.h"
+};
+
+#define REGINDEX_MAX				(sizeof(regindex) / sizeof(uint16_t))
+
+/* Stale index would silently break the lookup by name so we do not build
+ * until mkconfig is run again.
+ * */
+_Static_assert(REGINDEX_MAX == REGFILE_MAX, "regindex.h is stale, run mkconfig");
+
 static void
 reg_getval(const reg_t *reg, rval_t *lval)
 {
@@ -2219,6 +2478,26 @@ void reg_format_rval(const reg_t *reg, const rval_t *rval)
 	}
 }
 
+int reg_format_code(const reg_t *reg)
+{
+	const char		*fmt, *conv;
+	int			code = 0;
+
+	/* Format code is the precision digit and the conversion index.
+	 * */
+	fmt = reg->fmt + 1;
+
+	if (*fmt >= '0' && *fmt <= '9') {
+
+		code = (*fmt++ - '0') << 4;
+	}
+
+	conv = strchr("ixfeg", *fmt);
+	code |= (conv != NULL) ? (int) (conv - "ixfeg") : 0;
+
+	return code;
+}
+
 void reg_format(const reg_t *reg)
 {
 	rval_t			rval;
@@ -2266,14 +2545,30 @@ void reg_format(const reg_t *reg)
 const reg_t *reg_search(const char *sym)
 {
 	const reg_t		*reg, *found = NULL;
+	int			L, R, N, rc;
 
-	for (reg = regfile; reg->sym != NULL; ++reg) {
+	L = 0;
+	R = REGINDEX_MAX - 1;
 
-		if (strcmp(reg->sym, sym) == 0) {
+	while (L <= R) {
+
+		N = (L + R) / 2;
+
+		reg = regfile + regindex[N];
+		rc = strcmp(reg->sym, sym);
+
+		if (rc == 0) {
 
 			found = reg;
 			break;
 		}
+		else if (rc < 0) {
+
+			L = N + 1;
+		}
+		else {
+			R = N - 1;
+		}
 	}
 
 	return found;
@@ -2290,14 +2585,7 @@ const reg_t *reg_search_fuzzy(const char *sym)
 			found = regfile + n;
 	}
 	else {
-		for (reg = regfile; reg->sym != NULL; ++reg) {
-
-			if (strcmp(reg->sym, sym) == 0) {
-
-				found = reg;
-				break;
-			}
-		}
+		found = reg_search(sym);
 
 		if (found == NULL) {
 
@@ -2496,3 +2784,242 @@ SH_DEF(config_reg)
 	}
 }
 
+/* Batched register access for the host link. The request and reply carry
+ * binary frames armored with base64url so that they pass through the shell
+ * line editor and the remote shell of network.
+ *
+ * Request frame is an opcode followed by arguments and CRC32.
+ *
+ *	'L' ID ID ...		read a list of registers
+ *	'R' ID count		read a range of visible registers
+ *	'W' ID rval ID rval ...	write and read back a list of registers
+ *
+ * Reply lines begin with '$' and carry a number of entries followed by CRC32.
+ * Each entry is register ID, mode, format code and raw value. Registers that
+ * have a special format or are linked are printed as usual text lines.
+ * */
+
+#define REG_BULK_VERSION		1
+#define REG_BULK_FRAME			54
+#define REG_BULK_ENTRY			8
+#define REG_BULK_LINE			12
+
+static const char	reg_bulk_alpha[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+				"abcdefghijklmnopqrstuvwxyz0123456789-_";
+
+typedef struct {
+
+	uint8_t		raw[REG_BULK_ENTRY * REG_BULK_LINE + 4];
+	int		len;
+}
+reg_bulk_t;
+
+static int
+reg_bulk_decode(uint8_t *raw, const char *s, int max)
+{
+	const char	*p;
+	uint32_t	bits = 0U;
+	int		len = 0, n = 0;
+
+	while (*s != 0 && *s != ' ') {
+
+		p = strchr(reg_bulk_alpha, *s);
+
+		if (p == NULL)
+			return -1;
+
+		bits = (bits << 6) | (uint32_t) (p - reg_bulk_alpha);
+		n += 6;
+
+		if (n >= 8) {
+
+			n -= 8;
+
+			if (len >= max)
+				return -1;
+
+			raw[len++] = (uint8_t) (bits >> n);
+		}
+
+		++s;
+	}
+
+	return len;
+}
+
+static void
+reg_bulk_flush(reg_bulk_t *bk)
+{
+	uint32_t	bits, crc32;
+	int		N, n;
+
+	if (bk->len == 0)
+		return ;
+
+	crc32 = crc32u(bk->raw, bk->len);
+
+	for (N = 0; N < 4; ++N) {
+
+		bk->raw[bk->len++] = (uint8_t) (crc32 >> (N * 8));
+	}
+
+	putc('$');
+
+	bits = 0U;
+	n = 0;
+
+	for (N = 0; N < bk->len; ++N) {
+
+		bits = (bits << 8) | bk->raw[N];
+		n += 8;
+
+		while (n >= 6) {
+
+			n -= 6;
+			putc(reg_bulk_alpha[(bits >> n) & 0x3FU]);
+		}
+	}
+
+	if (n > 0) {
+
+		putc(reg_bulk_alpha[(bits << (6 - n)) & 0x3FU]);
+	}
+
+	puts(EOL);
+
+	bk->len = 0;
+}
+
+static void
+reg_bulk_entry(reg_bulk_t *bk, const reg_t *reg)
+{
+	rval_t		rval;
+	uint8_t		*raw;
+	int		reg_ID, code;
+
+	if (reg->format != NULL || (reg->mode & REG_LINKED) != 0) {
+
+		reg_format(reg);
+		return ;
+	}
+
+	reg_ID = (int) (reg - regfile);
+
+	reg_getval(reg, &rval);
+
+	code = reg_format_code(reg);
+
+	raw = bk->raw + bk->len;
+
+	raw[0] = (uint8_t) (reg_ID);
+	raw[1] = (uint8_t) (reg_ID >> 8);
+	raw[2] = (uint8_t) (reg->mode);
+	raw[3] = (uint8_t) (code);
+	raw[4] = (uint8_t) ((uint32_t) rval.i);
+	raw[5] = (uint8_t) ((uint32_t) rval.i >> 8);
+	raw[6] = (uint8_t) ((uint32_t) rval.i >> 16);
+	raw[7] = (uint8_t) ((uint32_t) rval.i >> 24);
+
+	bk->len += REG_BULK_ENTRY;
+
+	if (bk->len >= REG_BULK_ENTRY * REG_BULK_LINE) {
+
+		reg_bulk_flush(bk);
+	}
+}
+
+SH_DEF(reg_bulk)
+{
+	reg_bulk_t		bk;
+	uint8_t			raw[REG_BULK_FRAME];
+	rval_t			rval;
+	const reg_t		*reg;
+	uint32_t		crc32;
+
+	int			reg_ID, len, N, count;
+
+	if (*s == 0) {
+
+		printf("BULK %i %i" EOL, REG_BULK_VERSION, (int) REGFILE_MAX);
+		return ;
+	}
+
+	len = reg_bulk_decode(raw, s, sizeof(raw));
+
+	if (len >= 5) {
+
+		len -= 4;
+
+		crc32 =   (uint32_t) raw[len]
+			| (uint32_t) raw[len + 1] << 8
+			| (uint32_t) raw[len + 2] << 16
+			| (uint32_t) raw[len + 3] << 24;
+
+		if (crc32 != crc32u(raw, len)) {
+
+			len = 0;
+		}
+	}
+	else {
+		len = 0;
+	}
+
+	if (len == 0) {
+
+		printf("Unable to decode bulk frame" EOL);
+		return ;
+	}
+
+	bk.len = 0;
+
+	if (raw[0] == 'L') {
+
+		for (N = 1; N + 2 <= len; N += 2) {
+
+			reg_ID = raw[N] | raw[N + 1] << 8;
+
+			if (reg_ID < REGFILE_MAX) {
+
+				reg_bulk_entry(&bk, regfile + reg_ID);
+			}
+		}
+	}
+	else if (raw[0] == 'R' && len >= 5) {
+
+		reg_ID = raw[1] | raw[2] << 8;
+		count = raw[3] | raw[4] << 8;
+
+		for (; reg_ID < REGFILE_MAX && count > 0; ++reg_ID, --count) {
+
+			reg = regfile + reg_ID;
+
+			if ((reg->mode & REG_HIDDEN) == 0) {
+
+				reg_bulk_entry(&bk, reg);
+			}
+		}
+	}
+	else if (raw[0] == 'W') {
+
+		for (N = 1; N + 6 <= len; N += 6) {
+
+			reg_ID = raw[N] | raw[N + 1] << 8;
+
+			rval.i = (int) (  (uint32_t) raw[N + 2]
+					| (uint32_t) raw[N + 3] << 8
+					| (uint32_t) raw[N + 4] << 16
+					| (uint32_t) raw[N + 5] << 24);
+
+			if (reg_ID < REGFILE_MAX) {
+
+				reg = regfile + reg_ID;
+
+				reg_setval(reg, &rval);
+				reg_bulk_entry(&bk, reg);
+			}
+		}
+	}
+
+	reg_bulk_flush(&bk);
+}
+
@@ -35,6 +35,7 @@ reg_t;
 extern const reg_t	regfile[];
 
 void reg_format_rval(const reg_t *reg, const rval_t *rval);
+int reg_format_code(const reg_t *reg);
 void reg_format(const reg_t *reg);
 
 const reg_t *reg_search(const char *sym);
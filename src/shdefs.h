@@ -1,6 +1,10 @@
 SH_DEF(flash_prog)
 SH_DEF(flash_info)
 SH_DEF(flash_wipe)
+SH_DEF(flash_profile_list)
+SH_DEF(flash_profile_store)
+SH_DEF(flash_profile_load)
+SH_DEF(flash_profile_diff)
 SH_DEF(ap_version)
 SH_DEF(ap_time)
 SH_DEF(ap_dbg_task)
@@ -31,9 +35,11 @@ SH_DEF(pm_default_scale)
 SH_DEF(tlm_default)
 SH_DEF(tlm_grab)
 SH_DEF(tlm_watch)
+SH_DEF(tlm_trigger)
 SH_DEF(tlm_stop)
 SH_DEF(tlm_flush_sync)
 SH_DEF(tlm_live_sync)
+SH_DEF(tlm_live_bin)
 SH_DEF(help)
 #ifdef HW_HAVE_NETWORK_EPCAN
 SH_DEF(net_survey)
@@ -50,6 +56,12 @@ SH_DEF(net_node_remote)
 SH_DEF(pm_self_test)
 SH_DEF(pm_self_adjust)
 SH_DEF(pm_analysis_impedance)
+#ifdef _PM_PROF
+SH_DEF(pm_prof_report)
+#endif /* _PM_PROF */
+#ifdef _PM_PROF
+SH_DEF(pm_prof_reset)
+#endif /* _PM_PROF */
 SH_DEF(hal_ADC_scan)
 SH_DEF(hal_PWM_set_DC)
 #ifdef HW_HAVE_FAN_CONTROL
@@ -59,3 +71,4 @@ SH_DEF(hal_DBGMCU_mode_stop)
 SH_DEF(reg)
 SH_DEF(enum_reg)
 SH_DEF(config_reg)
+SH_DEF(reg_bulk)
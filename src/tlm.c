@@ -11,6 +11,8 @@
 
 void tlm_reg_default(tlm_t *tlm)
 {
+	int			N;
+
 	tlm->rate_grab = 1;
 	tlm->rate_watch = (int) (hal.PWM_frequency / 1000.f + 0.5f);
 	tlm->rate_live =  (int) (hal.PWM_frequency / 10.f   + 0.5f);
@@ -36,6 +38,247 @@ void tlm_reg_default(tlm_t *tlm)
 	tlm->reg_ID[17] = ID_PM_LU_MQ_LOAD;
 	tlm->reg_ID[18] = ID_PM_CONST_FB_U;
 	tlm->reg_ID[19] = ID_PM_WATT_DRAIN_WA;
+
+	for (N = 0; N < TLM_INPUT_MAX; ++N) {
+
+		tlm->reg_div[N] = 1;
+		tlm->reg_pack[N] = TLM_PACK_FULL;
+	}
+
+	/* Slow signals do not need to be sampled at full rate.
+	 * */
+	tlm->reg_div[1] = TLM_DIV_MAX;
+	tlm->reg_div[18] = 16;
+
+	tlm->trig_reg_ID = ID_PM_FSM_ERRNO;
+	tlm->trig_MODE = TLM_TRIG_CHANGE;
+	tlm->trig_level = 0.f;
+	tlm->trig_pre = 50.f;
+}
+
+static inline uint16_t
+tlm_half_encode(rval_t rval)
+{
+	uint32_t		x = (uint32_t) rval.i;
+	uint32_t		sign, m;
+	int			e;
+
+	sign = (x >> 16) & 0x8000U;
+	e = (int) ((x >> 23) & 0xFFU) - 112;
+	m = x & 0x7FFFFFU;
+
+	if (e <= 0) {
+
+		/* We flush subnormals to zero.
+		 * */
+		x = sign;
+	}
+	else if (e >= 31) {
+
+		x = sign | 0x7C00U;
+	}
+	else {
+		x = sign | ((uint32_t) e << 10) | (m >> 13);
+
+		/* Round to nearest. Carry into exponent is correct.
+		 * */
+		x += (m >> 12) & 1U;
+	}
+
+	return (uint16_t) x;
+}
+
+static float
+tlm_half_decode(uint16_t h)
+{
+	rval_t			rval;
+	uint32_t		sign, m;
+	int			e;
+
+	sign = ((uint32_t) h & 0x8000U) << 16;
+	e = (h >> 10) & 0x1F;
+	m = h & 0x3FFU;
+
+	if (e == 0) {
+
+		rval.i = (int) sign;
+	}
+	else if (e == 31) {
+
+		rval.i = (int) (sign | 0x7F800000U | (m << 13));
+	}
+	else {
+		rval.i = (int) (sign | ((uint32_t) (e + 112) << 23) | (m << 13));
+	}
+
+	return rval.f;
+}
+
+static inline void
+tlm_reg_store(tlm_t *tlm, int N, int index)
+{
+	rval_t			rval = *(tlm->layout_reg[N]->link);
+
+	if (tlm->layout_pack[N] == TLM_PACK_FULL) {
+
+		((rval_t *) tlm->layout_data[N])[index] = rval;
+	}
+	else if (tlm->layout_pack[N] == TLM_PACK_HALF) {
+
+		((uint16_t *) tlm->layout_data[N])[index] = tlm_half_encode(rval);
+	}
+	else {
+		rval.i = (rval.i < -32768) ? -32768
+			: (rval.i > 32767) ? 32767 : rval.i;
+
+		((int16_t *) tlm->layout_data[N])[index] = (int16_t) rval.i;
+	}
+}
+
+static rval_t
+tlm_reg_load(const tlm_t *tlm, int N, int line)
+{
+	int			index = line >> tlm->layout_shift[N];
+	rval_t			rval;
+
+	if (tlm->layout_pack[N] == TLM_PACK_FULL) {
+
+		rval = ((const rval_t *) tlm->layout_data[N])[index];
+	}
+	else if (tlm->layout_pack[N] == TLM_PACK_HALF) {
+
+		rval.f = tlm_half_decode(((const uint16_t *) tlm->layout_data[N])[index]);
+	}
+	else {
+		rval.i = ((const int16_t *) tlm->layout_data[N])[index];
+	}
+
+	return rval;
+}
+
+static void
+tlm_reg_stream(tlm_t *tlm)
+{
+	tlm_segment_t		*seg = &tlm->segment[tlm->segment_wr];
+	int			N;
+
+	if (tlm->skip == 0) {
+
+		if (seg->owner == TLM_SEGMENT_FREE) {
+
+			seg->clock = tlm->clock;
+			seg->line_N = 0;
+			seg->owner = TLM_SEGMENT_FILL;
+		}
+
+		if (seg->owner == TLM_SEGMENT_FILL) {
+
+			rval_t		*rdata = tlm->rdata + tlm->layout_N
+				* (tlm->segment_len * tlm->segment_wr + seg->line_N);
+
+			for (N = 0; N < tlm->layout_N; ++N) {
+
+				rdata[N] = *(tlm->layout_reg[N]->link);
+			}
+
+			seg->line_N += 1;
+
+			if (seg->line_N >= tlm->segment_len) {
+
+				hal_memory_fence();
+
+				seg->owner = TLM_SEGMENT_READY;
+
+				tlm->segment_wr = (tlm->segment_wr < TLM_SEGMENT_MAX - 1)
+					? tlm->segment_wr + 1 : 0;
+			}
+		}
+		else {
+			/* Export is behind so the row is dropped. Host will
+			 * see the gap in clock of the next segment.
+			 * */
+			tlm->overrun_N += 1;
+		}
+	}
+
+	tlm->skip += 1;
+
+	if (tlm->skip >= tlm->rate) {
+
+		tlm->clock += 1;
+		tlm->skip = 0;
+	}
+}
+
+static int
+tlm_reg_trigger(tlm_t *tlm)
+{
+	rval_t			rval, last;
+	int			rc = 0;
+
+	if (unlikely(tlm->trig_reg == NULL))
+		return 1;
+
+	rval = *(tlm->trig_reg->link);
+	last = tlm->trig_last;
+
+	tlm->trig_last = rval;
+
+	if (tlm->trig_MODE == TLM_TRIG_CHANGE) {
+
+		rc = (rval.i != last.i) ? 1 : 0;
+	}
+	else if (tlm->trig_int != 0) {
+
+		switch (tlm->trig_MODE) {
+
+			case TLM_TRIG_ABOVE:
+				rc = (rval.i > tlm->trig_ref.i) ? 1 : 0;
+				break;
+
+			case TLM_TRIG_BELOW:
+				rc = (rval.i < tlm->trig_ref.i) ? 1 : 0;
+				break;
+
+			case TLM_TRIG_RISING:
+				rc = (		last.i <= tlm->trig_ref.i
+						&& rval.i > tlm->trig_ref.i) ? 1 : 0;
+				break;
+
+			case TLM_TRIG_FALLING:
+				rc = (		last.i >= tlm->trig_ref.i
+						&& rval.i < tlm->trig_ref.i) ? 1 : 0;
+				break;
+
+			default: break;
+		}
+	}
+	else {
+		switch (tlm->trig_MODE) {
+
+			case TLM_TRIG_ABOVE:
+				rc = (rval.f > tlm->trig_ref.f) ? 1 : 0;
+				break;
+
+			case TLM_TRIG_BELOW:
+				rc = (rval.f < tlm->trig_ref.f) ? 1 : 0;
+				break;
+
+			case TLM_TRIG_RISING:
+				rc = (		last.f <= tlm->trig_ref.f
+						&& rval.f > tlm->trig_ref.f) ? 1 : 0;
+				break;
+
+			case TLM_TRIG_FALLING:
+				rc = (		last.f >= tlm->trig_ref.f
+						&& rval.f < tlm->trig_ref.f) ? 1 : 0;
+				break;
+
+			default: break;
+		}
+	}
+
+	return rc;
 }
 
 void tlm_reg_grab(tlm_t *tlm)
@@ -45,13 +288,22 @@ void tlm_reg_grab(tlm_t *tlm)
 	if (unlikely(tlm->mode == TLM_MODE_DISABLED))
 		return ;
 
-	if (tlm->skip == 0) {
+	if (tlm->mode == TLM_MODE_STREAM) {
+
+		tlm_reg_stream(tlm);
+		return ;
+	}
 
-		rval_t		*rdata = tlm->rdata + tlm->layout_N * tlm->line;
+	if (tlm->skip == 0) {
 
 		for (N = 0; N < tlm->layout_N; ++N) {
 
-			rdata[N] = *(tlm->layout_reg[N]->link);
+			int	shift = tlm->layout_shift[N];
+
+			if ((tlm->line & ((1 << shift) - 1)) == 0) {
+
+				tlm_reg_store(tlm, N, tlm->line >> shift);
+			}
 		}
 	}
 
@@ -78,12 +330,127 @@ void tlm_reg_grab(tlm_t *tlm)
 				tlm->mode = TLM_MODE_DISABLED;
 			}
 		}
+		else if (tlm->mode == TLM_MODE_TRIGGER) {
+
+			/* We arm the trigger only when pretrigger rows are
+			 * in memory. Then we capture the rest of rows after
+			 * trigger and stop.
+			 * */
+			if (		tlm->trig_clock < 0
+					&& tlm_reg_trigger(tlm) != 0
+					&& tlm->clock > tlm->pretrig_N) {
+
+				tlm->trig_clock = tlm->clock;
+			}
+
+			if (		tlm->trig_clock >= 0
+					&& tlm->clock - tlm->trig_clock
+					>= tlm->length_MAX - tlm->pretrig_N - 1) {
+
+				tlm->mode = TLM_MODE_DISABLED;
+			}
+		}
+	}
+}
+
+static void
+tlm_trigger_startup(tlm_t *tlm)
+{
+	const reg_t		*reg = NULL;
+	rval_t			rval;
+
+	if (tlm->trig_reg_ID != ID_NULL) {
+
+		reg = &regfile[tlm->trig_reg_ID];
+	}
+
+	tlm->trig_reg = reg;
+
+	if (reg != NULL) {
+
+		tlm->trig_int = ((reg_format_code(reg) & 0xFU) < 2) ? 1 : 0;
+
+		/* We compare the raw value so the trigger level is converted
+		 * back through the register procedure.
+		 * */
+		if (tlm->trig_int != 0) {
+
+			tlm->trig_ref.i = (int) tlm->trig_level;
+		}
+		else {
+			tlm->trig_ref.f = tlm->trig_level;
+
+			if (reg->proc != NULL) {
+
+				reg_t		lreg = { .link = &tlm->trig_ref };
+
+				rval.f = tlm->trig_level;
+
+				reg->proc(&lreg, NULL, &rval);
+			}
+		}
+
+		tlm->trig_last = *(reg->link);
+	}
+
+	tlm->pretrig_N = (int) ((float) tlm->length_MAX * tlm->trig_pre / 100.f);
+	tlm->pretrig_N = (tlm->pretrig_N < 0) ? 0
+		: (tlm->pretrig_N > tlm->length_MAX - 1) ? tlm->length_MAX - 1
+		: tlm->pretrig_N;
+}
+
+static void
+tlm_layout_pack(tlm_t *tlm)
+{
+	uint8_t			*data = (uint8_t *) tlm->rdata;
+	int			N, shift_MAX, size_N;
+
+	shift_MAX = 0;
+	size_N = 0;
+
+	for (N = 0; N < tlm->layout_N; ++N) {
+
+		shift_MAX = (tlm->layout_shift[N] > shift_MAX)
+			? tlm->layout_shift[N] : shift_MAX;
+	}
+
+	/* We get the number of bytes taken by (1 << shift_MAX) rows so
+	 * that memory length is a multiple of each register divider.
+	 * */
+	for (N = 0; N < tlm->layout_N; ++N) {
+
+		size_N += ((tlm->layout_pack[N] == TLM_PACK_FULL) ? 4 : 2)
+			<< (shift_MAX - tlm->layout_shift[N]);
+	}
+
+	tlm->length_MAX = ((int) sizeof(tlm->rdata) / size_N) << shift_MAX;
+
+	/* Full registers go first to keep them aligned.
+	 * */
+	for (N = 0; N < tlm->layout_N; ++N) {
+
+		if (tlm->layout_pack[N] == TLM_PACK_FULL) {
+
+			tlm->layout_data[N] = data;
+
+			data += (tlm->length_MAX >> tlm->layout_shift[N]) * 4;
+		}
+	}
+
+	for (N = 0; N < tlm->layout_N; ++N) {
+
+		if (tlm->layout_pack[N] != TLM_PACK_FULL) {
+
+			tlm->layout_data[N] = data;
+
+			data += (tlm->length_MAX >> tlm->layout_shift[N]) * 2;
+		}
 	}
 }
 
 void tlm_startup(tlm_t *tlm, int rate, int mode)
 {
-	int			N, layout_N = 0;
+	int			N, shift, layout_N = 0;
 
 	tlm->mode = TLM_MODE_DISABLED;
 
@@ -95,18 +462,66 @@ void tlm_startup(tlm_t *tlm, int rate, int mode)
 
 			const reg_t	*reg = &regfile[tlm->reg_ID[N]];
 
-			tlm->layout_reg[layout_N++] = reg;
+			/* Divider is rounded down to a power of two.
+			 * */
+			shift = 0;
+
+			while (		(2 << shift) <= tlm->reg_div[N]
+					&& (2 << shift) <= TLM_DIV_MAX) {
+
+				shift++;
+			}
+
+			tlm->layout_reg[layout_N] = reg;
+			tlm->layout_shift[layout_N] = shift;
+			tlm->layout_pack[layout_N] = TLM_PACK_FULL;
+
+			if (tlm->reg_pack[N] != TLM_PACK_FULL) {
+
+				tlm->layout_pack[layout_N] = ((reg_format_code(reg) & 0xFU) < 2)
+					? TLM_PACK_SHORT : TLM_PACK_HALF;
+			}
+
+			layout_N++;
 		}
 	}
 
 	tlm->layout_N = layout_N;
-	tlm->length_MAX = TLM_DATA_MAX / layout_N;
+
+	if (mode == TLM_MODE_STREAM) {
+
+		/* Stream is sent out by whole rows of full values.
+		 * */
+		tlm->length_MAX = TLM_DATA_MAX / layout_N;
+	}
+	else {
+		tlm_layout_pack(tlm);
+	}
 
 	tlm->clock = 0;
 	tlm->skip = 0;
+	tlm->line = 0;
 
 	tlm->rate = rate;
 
+	tlm->trig_clock = -1;
+
+	if (mode == TLM_MODE_TRIGGER) {
+
+		tlm_trigger_startup(tlm);
+	}
+
+	tlm->segment_len = tlm->length_MAX / TLM_SEGMENT_MAX;
+	tlm->segment_wr = 0;
+	tlm->segment_rd = 0;
+
+	for (N = 0; N < TLM_SEGMENT_MAX; ++N) {
+
+		tlm->segment[N].owner = TLM_SEGMENT_FREE;
+	}
+
+	tlm->overrun_N = 0;
+
 	hal_memory_fence();
 
 	tlm->mode = mode;
@@ -142,6 +557,15 @@ SH_DEF(tlm_watch)
 	tlm_startup(&tlm, rate, TLM_MODE_WATCH);
 }
 
+SH_DEF(tlm_trigger)
+{
+	int		rate = tlm.rate_grab;
+
+	stoi(&rate, s);
+
+	tlm_startup(&tlm, rate, TLM_MODE_TRIGGER);
+}
+
 SH_DEF(tlm_stop)
 {
 	tlm_halt(&tlm);
@@ -177,13 +601,12 @@ tlm_reg_label(tlm_t *tlm)
 static void
 tlm_reg_flush_line(tlm_t *tlm, int line)
 {
-	const rval_t		*rdata = tlm->rdata + tlm->layout_N * line;
 	int			N;
 
 	for (N = 0; N < tlm->layout_N; ++N) {
 
 		const reg_t	*reg = tlm->layout_reg[N];
-		rval_t		rval = rdata[N];
+		rval_t		rval = tlm_reg_load(tlm, N, line);
 
 		if (reg->proc != NULL) {
 
@@ -203,13 +626,31 @@ tlm_reg_flush_line(tlm_t *tlm, int line)
 SH_DEF(tlm_flush_sync)
 {
 	float			time, dT;
-	int			line, clock, precision;
+	int			N, line, clock, shift_MAX, precision;
 
 	if (tlm.mode != TLM_MODE_DISABLED)
 		return ;
 
-	line = tlm.line;
-	clock = 0;
+	/* Time is counted from the trigger row if it was fired.
+	 * */
+	clock = (tlm.trig_clock >= 0) ? - tlm.pretrig_N : 0;
+
+	shift_MAX = 0;
+
+	for (N = 0; N < tlm.layout_N; ++N) {
+
+		shift_MAX = (tlm.layout_shift[N] > shift_MAX)
+			? tlm.layout_shift[N] : shift_MAX;
+	}
+
+	/* In wrapped memory the oldest rows up to the next multiple of the
+	 * largest divider refer to samples that were already overwritten in
+	 * the current lap. We skip these rows.
+	 * */
+	line = (tlm.line + (1 << shift_MAX) - 1) & ~((1 << shift_MAX) - 1);
+	clock += line - tlm.line;
+
+	line = (line < tlm.length_MAX) ? line : 0;
 
 	dT = (float) tlm.rate / hal.PWM_frequency;
 
@@ -295,3 +736,245 @@ SH_DEF(tlm_live_sync)
 	tlm_halt(&tlm);
 }
 
+/* Binary live telemetry stream. Each frame begins with two sync bytes and
+ * is protected by CRC32 over the header and payload.
+ *
+ *	0xA5 0x5A type 0x00 length[2] seq[2] payload[length] crc32[4]
+ *
+ * Stream starts with the layout frame ('H') then data frames ('D') follow.
+ * Data frame carries the clock of its first row and a segment of rows of
+ * raw values. Sequence is the number of frame. The stream is closed by the
+ * end frame ('E') that carries the number of overrun rows.
+ *
+ * ADC_IRQ fills the segments of telemetry memory one by one while filled
+ * segments are sent out by USART DMA or USB endpoint directly from there.
+ * So capture goes on during transmission and rows are dropped only if all
+ * segments are waiting to be sent.
+ * */
+
+#define TLM_BIN_VERSION			2
+#define TLM_BIN_PAYLOAD			248
+
+typedef struct {
+
+	uint8_t		raw[TLM_BIN_PAYLOAD + 12];
+	int		len;
+}
+tlm_bin_t;
+
+static tlm_bin_t	tlm_bin;
+
+static void
+tlm_bin_put(const void *raw, int len)
+{
+	memcpy(tlm_bin.raw + tlm_bin.len, raw, len);
+
+	tlm_bin.len += len;
+}
+
+static void
+tlm_bin_frame(int type, int seq)
+{
+	tlm_bin.raw[0] = 0xA5U;
+	tlm_bin.raw[1] = 0x5AU;
+	tlm_bin.raw[2] = (uint8_t) type;
+	tlm_bin.raw[3] = 0U;
+	tlm_bin.raw[4] = 0U;
+	tlm_bin.raw[5] = 0U;
+	tlm_bin.raw[6] = (uint8_t) (seq);
+	tlm_bin.raw[7] = (uint8_t) (seq >> 8);
+
+	tlm_bin.len = 8;
+}
+
+static void
+tlm_bin_length(int len)
+{
+	tlm_bin.raw[4] = (uint8_t) (len);
+	tlm_bin.raw[5] = (uint8_t) (len >> 8);
+}
+
+static void
+tlm_bin_flush()
+{
+	uint32_t		crc32;
+
+	tlm_bin_length(tlm_bin.len - 8);
+
+	crc32 = crc32u(tlm_bin.raw, tlm_bin.len);
+
+	tlm_bin_put(&crc32, sizeof(crc32));
+
+	putb(tlm_bin.raw, tlm_bin.len);
+
+	tlm_bin.len = 0;
+}
+
+static void
+tlm_bin_layout(tlm_t *tlm)
+{
+	uint16_t		reg_ID, rate;
+	uint8_t			code[2];
+	rval_t			rval, rzero;
+	float			dT;
+	int			N;
+
+	tlm_bin_frame('H', 0);
+
+	code[0] = (uint8_t) tlm->layout_N;
+	code[1] = (uint8_t) TLM_BIN_VERSION;
+
+	rate = (uint16_t) tlm->rate;
+	dT = (float) tlm->rate / hal.PWM_frequency;
+
+	tlm_bin_put(code, 2);
+	tlm_bin_put(&rate, 2);
+	tlm_bin_put(&dT, 4);
+
+	for (N = 0; N < tlm->layout_N; ++N) {
+
+		const reg_t	*reg = tlm->layout_reg[N];
+
+		reg_ID = (uint16_t) (reg - regfile);
+
+		code[0] = (uint8_t) reg_format_code(reg);
+		code[1] = 0U;
+
+		/* We send raw values so the host applies the conversion by
+		 * itself. It is assumed to be linear so we give its scale and
+		 * offset.
+		 * */
+		rzero.f = 0.f;
+		rval.f = 1.f;
+
+		if (		reg->proc != NULL
+				&& (code[0] & 0xFU) >= 2) {
+
+			reg_t		lreg = { .link = &rzero };
+
+			reg->proc(&lreg, &rzero, NULL);
+
+			lreg.link = &rval;
+			reg->proc(&lreg, &rval, NULL);
+
+			rval.f -= rzero.f;
+		}
+
+		tlm_bin_put(&reg_ID, 2);
+		tlm_bin_put(code, 2);
+		tlm_bin_put(&rval.f, 4);
+		tlm_bin_put(&rzero.f, 4);
+	}
+
+	tlm_bin_flush();
+}
+
+static void
+tlm_bin_segment(tlm_t *tlm, const tlm_segment_t *seg, int seq)
+{
+	const rval_t		*rdata;
+	uint32_t		clock, crc32;
+	int			len;
+
+	rdata = tlm->rdata + tlm->layout_N * tlm->segment_len
+		* (int) (seg - tlm->segment);
+
+	len = tlm->layout_N * seg->line_N * sizeof(rval_t);
+	clock = (uint32_t) seg->clock;
+
+	tlm_bin_frame('D', seq);
+	tlm_bin_put(&clock, sizeof(clock));
+	tlm_bin_length(len + sizeof(clock));
+
+	crc32 = crc32u_next(0xFFFFFFFFU, tlm_bin.raw, tlm_bin.len);
+	crc32 = crc32u_next(crc32, rdata, len) ^ 0xFFFFFFFFU;
+
+	/* Rows are sent directly from telemetry memory.
+	 * */
+	putb(tlm_bin.raw, tlm_bin.len);
+	putb(rdata, len);
+
+	tlm_bin.len = 0;
+
+	tlm_bin_put(&crc32, sizeof(crc32));
+
+	putb(tlm_bin.raw, tlm_bin.len);
+
+	tlm_bin.len = 0;
+}
+
+SH_DEF(tlm_live_bin)
+{
+	tlm_segment_t		*seg;
+	uint32_t		overrun_N;
+	int			rate, seq;
+
+	if (tlm.mode != TLM_MODE_DISABLED)
+		return ;
+
+	rate = tlm.rate_watch;
+
+	if (stoi(&rate, s) != NULL) {
+
+		rate = (rate < 1) ? 1 : (rate > tlm.rate_live) ? tlm.rate_live : rate;
+	}
+
+	tlm_startup(&tlm, rate, TLM_MODE_STREAM);
+
+	tlm_bin_layout(&tlm);
+
+	seq = 1;
+
+	do {
+		seg = &tlm.segment[tlm.segment_rd];
+
+		if (seg->owner == TLM_SEGMENT_READY) {
+
+			tlm_bin_segment(&tlm, seg, seq++);
+
+			hal_memory_fence();
+
+			seg->owner = TLM_SEGMENT_FREE;
+
+			tlm.segment_rd = (tlm.segment_rd < TLM_SEGMENT_MAX - 1)
+				? tlm.segment_rd + 1 : 0;
+		}
+		else {
+			vTaskDelay((TickType_t) 1);
+		}
+
+		if (		   poll() != 0
+				&& getc() != K_LF)
+			break;
+	}
+	while (1);
+
+	tlm_halt(&tlm);
+
+	/* Send out the rest of rows.
+	 * */
+	do {
+		seg = &tlm.segment[tlm.segment_rd];
+
+		if (		seg->owner == TLM_SEGMENT_FREE
+				|| seg->line_N == 0)
+			break;
+
+		tlm_bin_segment(&tlm, seg, seq++);
+
+		seg->owner = TLM_SEGMENT_FREE;
+
+		tlm.segment_rd = (tlm.segment_rd < TLM_SEGMENT_MAX - 1)
+			? tlm.segment_rd + 1 : 0;
+	}
+	while (1);
+
+	overrun_N = (uint32_t) tlm.overrun_N;
+
+	tlm_bin_frame('E', seq);
+	tlm_bin_put(&overrun_N, sizeof(overrun_N));
+	tlm_bin_flush();
+
+	puts(EOL);
+}
+
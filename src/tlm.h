@@ -7,14 +7,53 @@
 
 #define TLM_DATA_MAX		22500
 #define TLM_INPUT_MAX		20
+#define TLM_SEGMENT_MAX		8
+#define TLM_DIV_MAX		64
 
 enum {
 	TLM_MODE_DISABLED	= 0,
 	TLM_MODE_GRAB,
 	TLM_MODE_WATCH,
-	TLM_MODE_LIVE
+	TLM_MODE_LIVE,
+	TLM_MODE_STREAM,
+	TLM_MODE_TRIGGER
 };
 
+enum {
+	TLM_PACK_FULL		= 0,
+	TLM_PACK_HALF,
+
+	/* Half packing of integer register is chosen automatically.
+	 * */
+	TLM_PACK_SHORT
+};
+
+enum {
+	TLM_TRIG_ABOVE		= 0,
+	TLM_TRIG_BELOW,
+	TLM_TRIG_RISING,
+	TLM_TRIG_FALLING,
+	TLM_TRIG_CHANGE
+};
+
+enum {
+	TLM_SEGMENT_FREE	= 0,
+	TLM_SEGMENT_FILL,
+	TLM_SEGMENT_READY
+};
+
+typedef struct {
+
+	/* Segment is owned by ADC_IRQ while it is FILL and by the export
+	 * task while it is READY.
+	 * */
+	int		owner;
+
+	int		clock;
+	int		line_N;
+}
+tlm_segment_t;
+
 typedef struct {
 
 	int		rate_grab;
@@ -23,9 +62,23 @@ typedef struct {
 
 	int		mode;
 	int		reg_ID[TLM_INPUT_MAX];
+	int		reg_div[TLM_INPUT_MAX];
+	int		reg_pack[TLM_INPUT_MAX];
+
+	int		trig_reg_ID;
+	int		trig_MODE;
+	float		trig_level;
+	float		trig_pre;
 
 	const reg_t	*layout_reg[TLM_INPUT_MAX];
 
+	/* Each register is kept in its own ring of samples that is taken
+	 * once in (1 << shift) rows.
+	 * */
+	void		*layout_data[TLM_INPUT_MAX];
+	int		layout_shift[TLM_INPUT_MAX];
+	int		layout_pack[TLM_INPUT_MAX];
+
 	int		layout_N;
 	int		length_MAX;
 
@@ -35,6 +88,23 @@ typedef struct {
 	int		rate;
 	int		line;
 
+	const reg_t	*trig_reg;
+
+	int		trig_int;
+	rval_t		trig_ref;
+	rval_t		trig_last;
+
+	int		pretrig_N;
+	int		trig_clock;
+
+	int		segment_len;
+	int		segment_wr;
+	int		segment_rd;
+
+	tlm_segment_t	segment[TLM_SEGMENT_MAX];
+
+	int		overrun_N;
+
 	rval_t		rdata[TLM_DATA_MAX];	/* memory to keep telemetry data */
 }
 tlm_t;